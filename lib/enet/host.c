@@ -109,6 +109,7 @@ enet_host_create (const ENetAddress * address, size_t peerCount, size_t channelL
     host -> compressor.destroy = NULL;
 
     host -> intercept = NULL;
+    host -> send = NULL;
 
     enet_list_clear (& host -> dispatchQueue);
 
@@ -29,6 +29,9 @@
 #include <matrix4.h>
 #include <quaternion.h>
 
+#include <simd_wrapper.h>
+
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
@@ -39,6 +42,31 @@ using namespace irr;
 
 namespace GE
 {
+// ----------------------------------------------------------------------------
+/** out = a * b, out must not alias a or b. */
+inline void mulMatrix(core::matrix4& out, const core::matrix4& a,
+                      const core::matrix4& b)
+{
+#if CPU_SSE_SUPPORT
+    const float* m1 = a.pointer();
+    const float* m2 = b.pointer();
+    float* m = out.pointer();
+    __m128 c0 = _mm_loadu_ps(m1);
+    __m128 c1 = _mm_loadu_ps(m1 + 4);
+    __m128 c2 = _mm_loadu_ps(m1 + 8);
+    __m128 c3 = _mm_loadu_ps(m1 + 12);
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(m2[i]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(m2[i + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(m2[i + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(m2[i + 3])));
+        _mm_storeu_ps(m + i, r);
+    }
+#else
+    out.setbyproduct_nocheck(a, b);
+#endif
+}
 
 struct LocRotScale
 {
@@ -48,13 +76,21 @@ struct LocRotScale
 
     core::vector3df m_scale;
     // ------------------------------------------------------------------------
+    /** Same as translation * rotation * scale matrices multiplied together,
+     *  without the 2 full matrix multiplications. */
     inline core::matrix4 toMatrix() const
     {
-        core::matrix4 lm, sm, rm;
-        lm.setTranslation(m_loc);
-        sm.setScale(m_scale);
-        m_rot.getMatrix(rm);
-        return lm * rm * sm;
+        core::matrix4 m(core::matrix4::EM4CONST_NOTHING);
+        m_rot.getMatrix(m);
+        float* p = m.pointer();
+        for (int i = 0; i < 3; i++)
+        {
+            p[i] *= m_scale.X;
+            p[4 + i] *= m_scale.Y;
+            p[8 + i] *= m_scale.Z;
+        }
+        m.setTranslation(m_loc);
+        return m;
     }
     // ------------------------------------------------------------------------
     void read(irr::io::IReadFile* spm)
@@ -78,10 +114,17 @@ struct Armature
 
     std::vector<LocRotScale> m_interpolated_matrices;
 
-    std::vector<std::pair<core::matrix4, bool> > m_world_matrices;
+    /** Scratch used when blending 2 frames in getPose. */
+    std::vector<LocRotScale> m_blend_matrices;
+
+    std::vector<core::matrix4> m_world_matrices;
 
     std::vector<int> m_parent_infos;
 
+    /** Joint indices sorted so that each parent comes before its children,
+     *  allows world matrices to be computed in one forward pass. */
+    std::vector<unsigned> m_joint_order;
+
     std::vector<std::pair<int, std::vector<LocRotScale> > >
         m_frame_pose_matrices;
 
@@ -109,8 +152,7 @@ struct Armature
             lrs.read(spm);
             m_joint_matrices[i] = lrs.toMatrix();
         }
-        m_world_matrices.resize(m_interpolated_matrices.size(),
-            std::make_pair(core::matrix4(), false));
+        m_world_matrices.resize(m_interpolated_matrices.size());
         m_parent_infos.resize(all_joints_size);
         bool non_parent_bone = false;
         for (unsigned i = 0; i < all_joints_size; i++)
@@ -128,6 +170,7 @@ struct Armature
             printf("SPMeshLoader::Armature: Non-parent bone missing in armature");
             exit(-1);
         }
+        sortJoints();
         unsigned frame_size = 0;
         spm->read(&frame_size, 2);
         m_frame_pose_matrices.resize(frame_size);
@@ -144,13 +187,37 @@ struct Armature
         }
     }
     // ------------------------------------------------------------------------
+    void sortJoints()
+    {
+        m_joint_order.clear();
+        m_joint_order.reserve(m_parent_infos.size());
+        std::vector<bool> added(m_parent_infos.size(), false);
+        std::vector<unsigned> chain;
+        for (unsigned i = 0; i < m_parent_infos.size(); i++)
+        {
+            int id = i;
+            while (id != -1 && !added[id])
+            {
+                chain.push_back(id);
+                id = m_parent_infos[id];
+            }
+            for (auto it = chain.rbegin(); it != chain.rend(); it++)
+            {
+                added[*it] = true;
+                m_joint_order.push_back(*it);
+            }
+            chain.clear();
+        }
+    }
+    // ------------------------------------------------------------------------
     void getPose(float frame, core::matrix4* dest,
                  float frame_interpolating = -1.0f, float rate = -1.0f)
     {
         getInterpolatedMatrices(frame);
         if (frame_interpolating != -1.0f && rate != -1.0f)
         {
-            auto copied = m_interpolated_matrices;
+            m_blend_matrices = m_interpolated_matrices;
+            const std::vector<LocRotScale>& copied = m_blend_matrices;
             getInterpolatedMatrices(frame_interpolating);
             for (unsigned i = 0; i < m_interpolated_matrices.size(); i++)
             {
@@ -165,28 +232,20 @@ struct Armature
                     m_interpolated_matrices[i].m_scale, rate);
             }
         }
-        for (auto& p : m_world_matrices)
-        {
-            p.second = false;
-        }
+        updateWorldMatrices();
         for (unsigned i = 0; i < m_joint_used; i++)
         {
-            dest[i] = getWorldMatrix(m_interpolated_matrices, i) *
-                m_joint_matrices[i];
+            mulMatrix(dest[i], m_world_matrices[i], m_joint_matrices[i]);
         }
     }
     // ------------------------------------------------------------------------
     void getPose(core::matrix4* dest, float frame)
     {
         getInterpolatedMatrices(frame);
-        for (auto& p : m_world_matrices)
-        {
-            p.second = false;
-        }
+        updateWorldMatrices();
         for (unsigned i = 0; i < m_joint_used; i++)
         {
-            dest[i] = getWorldMatrix(m_interpolated_matrices, i) *
-                m_joint_matrices[i];
+            mulMatrix(dest[i], m_world_matrices[i], m_joint_matrices[i]);
         }
     }
     // ------------------------------------------------------------------------
@@ -204,26 +263,21 @@ struct Armature
             }
             return;
         }
-        int frame_1 = -1;
-        int frame_2 = -1;
-        float interpolation = 0.0f;
-        for (unsigned i = 0; i < m_frame_pose_matrices.size(); i++)
-        {
-            assert(i + 1 < m_frame_pose_matrices.size());
-            if (frame >= float(m_frame_pose_matrices[i].first) &&
-                frame < float(m_frame_pose_matrices[i + 1].first))
+        // First key frame after frame, frame index is sorted in exporter
+        auto it = std::upper_bound(m_frame_pose_matrices.begin(),
+            m_frame_pose_matrices.end(), frame,
+            [](float f, const std::pair<int, std::vector<LocRotScale> >& p)
             {
-                frame_1 = i;
-                frame_2 = i + 1;
-                interpolation =
-                    (frame - float(m_frame_pose_matrices[i].first)) /
-                    float(m_frame_pose_matrices[i + 1].first -
-                    m_frame_pose_matrices[i].first);
-                break;
-            }
-        }
-        assert(frame_1 != -1);
-        assert(frame_2 != -1);
+                return f < float(p.first);
+            });
+        assert(it != m_frame_pose_matrices.begin());
+        assert(it != m_frame_pose_matrices.end());
+        const int frame_2 = int(it - m_frame_pose_matrices.begin());
+        const int frame_1 = frame_2 - 1;
+        const float interpolation =
+            (frame - float(m_frame_pose_matrices[frame_1].first)) /
+            float(m_frame_pose_matrices[frame_2].first -
+            m_frame_pose_matrices[frame_1].first);
         for (unsigned i = 0; i < m_interpolated_matrices.size(); i++)
         {
             LocRotScale interpolated;
@@ -240,24 +294,22 @@ struct Armature
         }
     }
     // ------------------------------------------------------------------------
-    core::matrix4 getWorldMatrix(const std::vector<LocRotScale>& lrs,
-                                 unsigned id)
+    /** Compute m_world_matrices from m_interpolated_matrices. */
+    void updateWorldMatrices()
     {
-        core::matrix4 mat = lrs[id].toMatrix();
-        int parent_id = m_parent_infos[id];
-        if (parent_id == -1)
+        if (m_joint_order.size() != m_parent_infos.size())
+            sortJoints();
+        for (unsigned id : m_joint_order)
         {
-            m_world_matrices[id] = std::make_pair(mat, true);
-            return mat;
-        }
-        if (!m_world_matrices[parent_id].second)
-        {
-            m_world_matrices[parent_id] = std::make_pair
-                (getWorldMatrix(lrs, parent_id), true);
+            const int parent_id = m_parent_infos[id];
+            if (parent_id == -1)
+            {
+                m_world_matrices[id] = m_interpolated_matrices[id].toMatrix();
+                continue;
+            }
+            mulMatrix(m_world_matrices[id], m_world_matrices[parent_id],
+                m_interpolated_matrices[id].toMatrix());
         }
-        m_world_matrices[id] =
-            std::make_pair(m_world_matrices[parent_id].first * mat, true);
-        return m_world_matrices[id].first;
     }
 };
 
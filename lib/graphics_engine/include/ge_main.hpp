@@ -5,6 +5,7 @@
 #include <matrix4.h>
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <unordered_set>
 
@@ -40,6 +41,17 @@ GEConfig* getGEConfig();
 void deinit();
 uint64_t getMonoTimeMs();
 void mathPlaneFrustumf(float* out, const irr::core::matrix4& pvm);
+/* Test count axis aligned boxes in structure of arrays layout (bb[0] to bb[5]
+ * are min x, y, z and max x, y, z) against frustum_count frustums (24 floats
+ * each from mathPlaneFrustumf), bit n of out[i] is set if box i is outside
+ * frustum n. */
+void mathCullBoxes(uint8_t* out, const float* const* bb, unsigned count,
+                   const float* frustums, unsigned frustum_count);
+/* Split [0, count) into ranges of grain items and run func(begin, end) on
+ * each of them, using the calling thread and a pool of worker threads shared
+ * by all callers, returns after all ranges are done. */
+void parallelFor(unsigned count, unsigned grain,
+                 const std::function<void(unsigned, unsigned)>& func);
 inline size_t getPadding(size_t in, size_t alignment)
 {
     if (in == 0 || alignment == 0)
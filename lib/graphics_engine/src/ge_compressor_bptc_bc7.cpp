@@ -49,42 +49,53 @@ GECompressorBPTCBC7::GECompressorBPTCBC7(uint8_t* texture, unsigned channels,
 
     for (GEImageLevel& level : m_levels)
     {
-        uint8_t* out = cur_offset;
-        for (unsigned y = 0; y < level.m_dim.Height; y += 4)
+        unsigned cur_size = get4x4CompressedTextureSize(level.m_dim.Width,
+            level.m_dim.Height);
+        compressed_levels.push_back({ level.m_dim, cur_size, cur_offset });
+        cur_offset += cur_size;
+    }
+    // Rows of blocks are independent, so they are split across all cores
+    forAllBlockRows(4096, [this, &compressed_levels, &p]
+        (unsigned i, unsigned row_begin, unsigned row_end)
         {
-            for (unsigned x = 0; x < level.m_dim.Width; x += 4)
+            GEImageLevel& level = m_levels[i];
+            const unsigned blocks_per_row = (level.m_dim.Width + 3) / 4;
+            uint8_t* out = (uint8_t*)compressed_levels[i].m_data +
+                row_begin * blocks_per_row * 16;
+            for (unsigned y = row_begin * 4; y < row_end * 4; y += 4)
             {
-                // build the 4x4 block of pixels
-                uint32_t source_rgba[16] = {};
-                uint8_t* target_pixel = (uint8_t*)source_rgba;
-                for (unsigned py = 0; py < 4; py++)
+                for (unsigned x = 0; x < level.m_dim.Width; x += 4)
                 {
-                    for (unsigned px = 0; px < 4; px++)
+                    // build the 4x4 block of pixels
+                    uint32_t source_rgba[16] = {};
+                    uint8_t* target_pixel = (uint8_t*)source_rgba;
+                    for (unsigned py = 0; py < 4; py++)
                     {
-                        // get the source pixel in the image
-                        unsigned sx = x + px;
-                        unsigned sy = y + py;
-                        // enable if we're in the image
-                        if (sx < level.m_dim.Width && sy < level.m_dim.Height)
+                        for (unsigned px = 0; px < 4; px++)
                         {
-                            uint8_t* rgba = (uint8_t*)level.m_data;
-                            const unsigned pitch = level.m_dim.Width * 4;
-                            uint8_t* source_pixel = rgba + pitch * sy + 4 * sx;
-                            memcpy(target_pixel, source_pixel, 4);
+                            // get the source pixel in the image
+                            unsigned sx = x + px;
+                            unsigned sy = y + py;
+                            // enable if we're in the image
+                            if (sx < level.m_dim.Width &&
+                                sy < level.m_dim.Height)
+                            {
+                                uint8_t* rgba = (uint8_t*)level.m_data;
+                                const unsigned pitch = level.m_dim.Width * 4;
+                                uint8_t* source_pixel =
+                                    rgba + pitch * sy + 4 * sx;
+                                memcpy(target_pixel, source_pixel, 4);
+                            }
+                            // advance to the next pixel
+                            target_pixel += 4;
                         }
-                        // advance to the next pixel
-                        target_pixel += 4;
                     }
+                    ispc::bc7e_compress_blocks(1, (uint64_t*)out,
+                        source_rgba, &p);
+                    out += 16;
                 }
-                ispc::bc7e_compress_blocks(1, (uint64_t*)out, source_rgba, &p);
-                out += 16;
             }
-        }
-        unsigned cur_size = get4x4CompressedTextureSize(level.m_dim.Width,
-            level.m_dim.Height);
-        compressed_levels.push_back({ level.m_dim, cur_size, cur_offset });
-        cur_offset += cur_size;
-    }
+        });
     freeMipmapCascade();
     std::swap(compressed_levels, m_levels);
 #endif
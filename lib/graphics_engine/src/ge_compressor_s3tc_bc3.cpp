@@ -10,13 +10,15 @@ static_assert(squish::kColourRangeFit == (1 << 6), "Wrong header");
 static_assert(squish::kColourIterativeClusterFit == (1 << 8), "Wrong header");
 
 // ============================================================================
-extern "C" void squishCompressImage(uint8_t* rgba, int width, int height,
-                                    int pitch, void* blocks, unsigned flags)
+/* Compress block rows [row_begin, row_end) of the image. */
+static void squishCompressRows(uint8_t* rgba, int width, int height,
+                               int pitch, void* blocks, unsigned flags,
+                               int row_begin, int row_end)
 {
     // This function is copied from CompressImage in libsquish to avoid omp
     // if enabled by shared libsquish, because we are already using
     // multiple thread
-    for (int y = 0; y < height; y += 4)
+    for (int y = row_begin * 4; y < height && y < row_end * 4; y += 4)
     {
         // initialise the block output
         uint8_t* target_block = reinterpret_cast<uint8_t*>(blocks);
@@ -53,6 +55,23 @@ extern "C" void squishCompressImage(uint8_t* rgba, int width, int height,
             target_block += 16;
         }
     }
+}   // squishCompressRows
+
+// ----------------------------------------------------------------------------
+extern "C" void squishCompressImage(uint8_t* rgba, int width, int height,
+                                    int pitch, void* blocks, unsigned flags)
+{
+    // Large textures (which dominate loading time) are split into rows of
+    // blocks compressed in parallel, rows are independent of each other
+    const unsigned block_rows = (height + 3) / 4;
+    const unsigned blocks_per_row = (width + 3) / 4;
+    const unsigned grain = std::max(1u, 16384u / std::max(1u, blocks_per_row));
+    GE::parallelFor(block_rows, grain,
+        [rgba, width, height, pitch, blocks, flags](unsigned b, unsigned e)
+        {
+            squishCompressRows(rgba, width, height, pitch, blocks, flags,
+                b, e);
+        });
 }   // squishCompressImage
 
 namespace GE
@@ -83,14 +102,19 @@ GECompressorS3TCBC3::GECompressorS3TCBC3(uint8_t* texture, unsigned channels,
 
     for (GEImageLevel& level : m_levels)
     {
-        squishCompressImage((uint8_t*)level.m_data, level.m_dim.Width,
-            level.m_dim.Height, level.m_dim.Width * channels,
-            cur_offset, tc_flag);
         unsigned cur_size = get4x4CompressedTextureSize(level.m_dim.Width,
             level.m_dim.Height);
         compressed_levels.push_back({ level.m_dim, cur_size, cur_offset });
         cur_offset += cur_size;
     }
+    forAllBlockRows(16384, [this, &compressed_levels, channels, tc_flag]
+        (unsigned i, unsigned row_begin, unsigned row_end)
+        {
+            GEImageLevel& level = m_levels[i];
+            squishCompressRows((uint8_t*)level.m_data, level.m_dim.Width,
+                level.m_dim.Height, level.m_dim.Width * channels,
+                compressed_levels[i].m_data, tc_flag, row_begin, row_end);
+        });
     freeMipmapCascade();
     std::swap(compressed_levels, m_levels);
 }   // GECompressorS3TCBC3
@@ -11,7 +11,7 @@ namespace GE
 // ----------------------------------------------------------------------------
 void GECullingTool::init(GEVulkanCameraSceneNode* cam)
 {
-    mathPlaneFrustumf(&m_frustum[0].X, cam->getPVM());
+    mathPlaneFrustumf(m_frustum, cam->getPVM());
     m_cam_bbox = cam->getViewFrustum()->getBoundingBox();
 }   // init
 
@@ -21,35 +21,14 @@ bool GECullingTool::isCulled(irr::core::aabbox3df& bb)
     if (!m_cam_bbox.intersectsWithBox(bb))
         return true;
 
-    using namespace irr;
-    using namespace core;
-    quaternion edges[8] =
+    const float* box[6] =
     {
-        quaternion(bb.MinEdge.X, bb.MinEdge.Y, bb.MinEdge.Z, 1.0f),
-        quaternion(bb.MaxEdge.X, bb.MinEdge.Y, bb.MinEdge.Z, 1.0f),
-        quaternion(bb.MinEdge.X, bb.MaxEdge.Y, bb.MinEdge.Z, 1.0f),
-        quaternion(bb.MaxEdge.X, bb.MaxEdge.Y, bb.MinEdge.Z, 1.0f),
-        quaternion(bb.MinEdge.X, bb.MinEdge.Y, bb.MaxEdge.Z, 1.0f),
-        quaternion(bb.MaxEdge.X, bb.MinEdge.Y, bb.MaxEdge.Z, 1.0f),
-        quaternion(bb.MinEdge.X, bb.MaxEdge.Y, bb.MaxEdge.Z, 1.0f),
-        quaternion(bb.MaxEdge.X, bb.MaxEdge.Y, bb.MaxEdge.Z, 1.0f)
+        &bb.MinEdge.X, &bb.MinEdge.Y, &bb.MinEdge.Z,
+        &bb.MaxEdge.X, &bb.MaxEdge.Y, &bb.MaxEdge.Z
     };
-
-    for (int i = 0; i < 6; i++)
-    {
-        bool culled = true;
-        for (int j = 0; j < 8; j++)
-        {
-            if (m_frustum[i].dotProduct(edges[j]) >= 0.0)
-            {
-                culled = false;
-                break;
-            }
-        }
-        if (culled)
-            return true;
-    }
-    return false;
+    uint8_t culled = 0;
+    mathCullBoxes(&culled, box, 1, m_frustum, 1);
+    return culled != 0;
 }   // isCulled
 
 // ----------------------------------------------------------------------------
@@ -60,4 +39,34 @@ bool GECullingTool::isCulled(GESPMBuffer* buffer, irr::scene::ISceneNode* node)
     return isCulled(bb);
 }   // isCulled
 
+// ----------------------------------------------------------------------------
+/** Culls all boxes added by addBox() since the last clearBoxes() in one pass,
+ *  results are available with isBoxCulled(). */
+void GECullingTool::cullBoxes()
+{
+    const unsigned count = (unsigned)m_boxes[0].size();
+    m_culled.resize(count);
+    if (count == 0)
+        return;
+
+    const float* boxes[6] =
+    {
+        m_boxes[0].data(), m_boxes[1].data(), m_boxes[2].data(),
+        m_boxes[3].data(), m_boxes[4].data(), m_boxes[5].data()
+    };
+    mathCullBoxes(m_culled.data(), boxes, count, m_frustum, 1);
+
+    const irr::core::vector3df& cam_min = m_cam_bbox.MinEdge;
+    const irr::core::vector3df& cam_max = m_cam_bbox.MaxEdge;
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (m_culled[i] != 0)
+            continue;
+        if (boxes[0][i] > cam_max.X || boxes[1][i] > cam_max.Y ||
+            boxes[2][i] > cam_max.Z || boxes[3][i] < cam_min.X ||
+            boxes[4][i] < cam_min.Y || boxes[5][i] < cam_min.Z)
+            m_culled[i] = 1;
+    }
+}   // cullBoxes
+
 }
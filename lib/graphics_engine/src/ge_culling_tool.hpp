@@ -2,9 +2,11 @@
 #define HEADER_GE_CULLING_TOOL_HPP
 
 #include "aabbox3d.h"
-#include "quaternion.h"
 #include "matrix4.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace irr
 {
     namespace scene { class ISceneNode; }
@@ -18,9 +20,14 @@ class GEVulkanCameraSceneNode;
 class GECullingTool
 {
 private:
-    irr::core::quaternion m_frustum[6];
+    float m_frustum[24];
 
     irr::core::aabbox3df m_cam_bbox;
+
+    /** Bounding boxes in structure of arrays layout for batched culling. */
+    std::vector<float> m_boxes[6];
+
+    std::vector<uint8_t> m_culled;
 public:
     // ------------------------------------------------------------------------
     void init(GEVulkanCameraSceneNode* cam);
@@ -28,6 +35,28 @@ public:
     bool isCulled(irr::core::aabbox3df& bb);
     // ------------------------------------------------------------------------
     bool isCulled(GESPMBuffer* buffer, irr::scene::ISceneNode* node);
+    // ------------------------------------------------------------------------
+    void clearBoxes()
+    {
+        for (std::vector<float>& v : m_boxes)
+            v.clear();
+        m_culled.clear();
+    }
+    // ------------------------------------------------------------------------
+    unsigned addBox(const irr::core::aabbox3df& bb)
+    {
+        m_boxes[0].push_back(bb.MinEdge.X);
+        m_boxes[1].push_back(bb.MinEdge.Y);
+        m_boxes[2].push_back(bb.MinEdge.Z);
+        m_boxes[3].push_back(bb.MaxEdge.X);
+        m_boxes[4].push_back(bb.MaxEdge.Y);
+        m_boxes[5].push_back(bb.MaxEdge.Z);
+        return (unsigned)m_boxes[0].size() - 1;
+    }
+    // ------------------------------------------------------------------------
+    void cullBoxes();
+    // ------------------------------------------------------------------------
+    bool isBoxCulled(unsigned i) const             { return m_culled[i] != 0; }
 };   // GECullingTool
 
 }
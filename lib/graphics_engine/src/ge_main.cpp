@@ -4,12 +4,21 @@
 #include "ge_vulkan_driver.hpp"
 #include "mini_glm.hpp"
 
+#include <simd_wrapper.h>
+
 #include "IMesh.h"
 #include "IMeshBuffer.h"
 #include "S3DVertex.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace GE
 {
@@ -64,8 +73,156 @@ const std::string& getShaderFolder()
     return g_shader_folder;
 }
 
+namespace
+{
+/* One call of parallelFor, its chunks are taken by the calling thread and
+ * any idle worker of the pool. */
+struct ParallelForJob
+{
+    const std::function<void(unsigned, unsigned)>* m_func;
+    unsigned m_count;
+    unsigned m_grain;
+    unsigned m_chunk_count;
+    std::atomic<unsigned> m_next_chunk;
+    std::atomic<unsigned> m_done_chunks;
+    /* Number of workers using this job, guarded by the pool mutex. */
+    unsigned m_workers;
+};
+
+/* Worker threads shared by all parallelFor calls, started on first use and
+ * joined in deinit() or at exit. */
+class ParallelForPool
+{
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_job_cv;
+    std::condition_variable m_done_cv;
+    std::deque<ParallelForJob*> m_jobs;
+    std::vector<std::thread> m_workers;
+    bool m_started;
+    bool m_quit;
+
+    // ------------------------------------------------------------------------
+    /* Runs chunks of the job until all chunks are taken. */
+    void runChunks(ParallelForJob* job)
+    {
+        while (true)
+        {
+            const unsigned chunk = job->m_next_chunk++;
+            if (chunk >= job->m_chunk_count)
+                return;
+            const unsigned begin = chunk * job->m_grain;
+            (*job->m_func)(begin, std::min(begin + job->m_grain,
+                job->m_count));
+            job->m_done_chunks++;
+        }
+    }   // runChunks
+    // ------------------------------------------------------------------------
+    void workerLoop()
+    {
+        std::unique_lock<std::mutex> ul(m_mutex);
+        while (true)
+        {
+            m_job_cv.wait(ul, [this] { return m_quit || !m_jobs.empty(); });
+            if (m_quit)
+                return;
+            ParallelForJob* job = m_jobs.front();
+            if (job->m_next_chunk.load() >= job->m_chunk_count)
+            {
+                // All chunks taken, the caller waits for the last ones
+                m_jobs.pop_front();
+                continue;
+            }
+            job->m_workers++;
+            ul.unlock();
+            runChunks(job);
+            ul.lock();
+            job->m_workers--;
+            m_done_cv.notify_all();
+        }
+    }   // workerLoop
+
+public:
+    // ------------------------------------------------------------------------
+    ParallelForPool() : m_started(false), m_quit(false) {}
+    // ------------------------------------------------------------------------
+    ~ParallelForPool()                                            { stop(); }
+    // ------------------------------------------------------------------------
+    void stop()
+    {
+        std::unique_lock<std::mutex> ul(m_mutex);
+        m_quit = true;
+        m_job_cv.notify_all();
+        ul.unlock();
+        for (std::thread& t : m_workers)
+            t.join();
+        m_workers.clear();
+        m_started = false;
+        m_quit = false;
+    }   // stop
+    // ------------------------------------------------------------------------
+    void run(unsigned count, unsigned grain,
+             const std::function<void(unsigned, unsigned)>& func)
+    {
+        std::unique_lock<std::mutex> ul(m_mutex);
+        if (!m_started)
+        {
+            m_started = true;
+            // The calling thread always works on its own job too
+            unsigned thread_count = std::thread::hardware_concurrency();
+            for (unsigned i = 1; i < thread_count; i++)
+                m_workers.emplace_back([this]() { workerLoop(); });
+        }
+        // Workers (and a single core) run nested calls themselves, which
+        // keeps the number of busy threads at the number of cores
+        bool inline_call = m_workers.empty();
+        for (std::thread& t : m_workers)
+        {
+            if (t.get_id() == std::this_thread::get_id())
+                inline_call = true;
+        }
+        if (inline_call)
+        {
+            ul.unlock();
+            func(0, count);
+            return;
+        }
+
+        ParallelForJob job;
+        job.m_func = &func;
+        job.m_count = count;
+        job.m_grain = grain;
+        job.m_chunk_count = (count + grain - 1) / grain;
+        job.m_next_chunk.store(0);
+        job.m_done_chunks.store(0);
+        job.m_workers = 0;
+        m_jobs.push_back(&job);
+        m_job_cv.notify_all();
+        ul.unlock();
+
+        // If all workers are busy with other jobs (for example when several
+        // texture loader threads compress at the same time), the calling
+        // thread simply does all chunks itself
+        runChunks(&job);
+        ul.lock();
+        // Wait until no worker uses the job any more, it is on this stack
+        m_done_cv.wait(ul, [&job]
+            {
+                return job.m_done_chunks.load() == job.m_chunk_count &&
+                    job.m_workers == 0;
+            });
+        auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+        if (it != m_jobs.end())
+            m_jobs.erase(it);
+    }   // run
+};   // ParallelForPool
+
+ParallelForPool g_parallel_for_pool;
+}   // anonymous namespace
+
 void deinit()
 {
+    g_parallel_for_pool.stop();
 }
 
 uint64_t getMonoTimeMs()
@@ -133,6 +290,106 @@ void mathPlaneFrustumf(float* out, const irr::core::matrix4& pvm)
     mathPlaneNormf(&out[5 * 4]);
 }
 
+// ----------------------------------------------------------------------------
+/* A box is outside a plane if all its 8 corners are behind it, which is the
+ * same as the corner furthest along the plane normal being behind it, so
+ * only 3 multiply-max per plane is needed instead of 8 dot products. */
+inline uint8_t cullBox(const float* bb, const float* frustums,
+                       unsigned frustum_count)
+{
+    uint8_t result = 0;
+    for (unsigned f = 0; f < frustum_count; f++)
+    {
+        const float* plane = &frustums[f * 24];
+        for (unsigned i = 0; i < 24; i += 4)
+        {
+            const float dist =
+                std::max(plane[i] * bb[0], plane[i] * bb[3]) +
+                std::max(plane[i + 1] * bb[1], plane[i + 1] * bb[4]) +
+                std::max(plane[i + 2] * bb[2], plane[i + 2] * bb[5]) +
+                plane[i + 3];
+            if (dist < 0.0f)
+            {
+                result |= (uint8_t)(1 << f);
+                break;
+            }
+        }
+    }
+    return result;
+}   // cullBox
+
+// ----------------------------------------------------------------------------
+void mathCullBoxes(uint8_t* out, const float* const* bb, unsigned count,
+                   const float* frustums, unsigned frustum_count)
+{
+    assert(frustum_count <= 8);
+    unsigned i = 0;
+#if CPU_SSE_SUPPORT
+    // 4 boxes per iteration
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 min_x = _mm_loadu_ps(bb[0] + i);
+        __m128 min_y = _mm_loadu_ps(bb[1] + i);
+        __m128 min_z = _mm_loadu_ps(bb[2] + i);
+        __m128 max_x = _mm_loadu_ps(bb[3] + i);
+        __m128 max_y = _mm_loadu_ps(bb[4] + i);
+        __m128 max_z = _mm_loadu_ps(bb[5] + i);
+        uint8_t result[4] = {};
+        for (unsigned f = 0; f < frustum_count; f++)
+        {
+            const float* plane = &frustums[f * 24];
+            __m128 outside = _mm_setzero_ps();
+            for (unsigned j = 0; j < 24; j += 4)
+            {
+                __m128 nx = _mm_set1_ps(plane[j]);
+                __m128 ny = _mm_set1_ps(plane[j + 1]);
+                __m128 nz = _mm_set1_ps(plane[j + 2]);
+                __m128 dist = _mm_add_ps(
+                    _mm_max_ps(_mm_mul_ps(nx, min_x), _mm_mul_ps(nx, max_x)),
+                    _mm_max_ps(_mm_mul_ps(ny, min_y), _mm_mul_ps(ny, max_y)));
+                dist = _mm_add_ps(dist,
+                    _mm_max_ps(_mm_mul_ps(nz, min_z), _mm_mul_ps(nz, max_z)));
+                dist = _mm_add_ps(dist, _mm_set1_ps(plane[j + 3]));
+                outside = _mm_or_ps(outside,
+                    _mm_cmplt_ps(dist, _mm_setzero_ps()));
+            }
+            int mask = _mm_movemask_ps(outside);
+            for (unsigned k = 0; k < 4; k++)
+            {
+                if ((mask >> k) & 1)
+                    result[k] |= (uint8_t)(1 << f);
+            }
+        }
+        memcpy(&out[i], result, 4);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float box[6] =
+        {
+            bb[0][i], bb[1][i], bb[2][i], bb[3][i], bb[4][i], bb[5][i]
+        };
+        out[i] = cullBox(box, frustums, frustum_count);
+    }
+}   // mathCullBoxes
+
+
+// ----------------------------------------------------------------------------
+void parallelFor(unsigned count, unsigned grain,
+                 const std::function<void(unsigned, unsigned)>& func)
+{
+    if (grain == 0)
+        grain = 1;
+    if (count <= grain)
+    {
+        if (count > 0)
+            func(0, count);
+        return;
+    }
+    g_parallel_for_pool.run(count, grain, func);
+}   // parallelFor
+
+// ----------------------------------------------------------------------------
 irr::scene::IAnimatedMesh* convertIrrlichtMeshToSPM(irr::scene::IMesh* mesh)
 {
     GESPM* spm = new GESPM();
@@ -6,11 +6,14 @@ extern "C"
     #include <mipmap/img.h>
     #include <mipmap/imgresize.h>
 }
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include "dimension2d.h"
+#include "ge_main.hpp"
 
 namespace GE
 {
@@ -41,6 +44,38 @@ protected:
             m_cascade = NULL;
         }
     }
+    // ------------------------------------------------------------------------
+    /* Run func(level, row_begin, row_end) for all rows of 4x4 blocks of all
+     * levels, the rows of all levels are split together across threads, so
+     * small levels are compressed at the same time as the large ones. */
+    void forAllBlockRows(unsigned grain_blocks,
+                         const std::function<void(unsigned, unsigned,
+                                                  unsigned)>& func)
+    {
+        std::vector<unsigned> first_row;
+        unsigned total_rows = 0;
+        for (GEImageLevel& level : m_levels)
+        {
+            first_row.push_back(total_rows);
+            total_rows += (level.m_dim.Height + 3) / 4;
+        }
+        const unsigned blocks_per_row = (m_levels[0].m_dim.Width + 3) / 4;
+        parallelFor(total_rows,
+            std::max(1u, grain_blocks / std::max(1u, blocks_per_row)),
+            [&first_row, &func](unsigned begin, unsigned end)
+            {
+                unsigned i = unsigned(std::upper_bound(first_row.begin(),
+                    first_row.end(), begin) - first_row.begin()) - 1;
+                while (begin < end)
+                {
+                    const unsigned level_end = i + 1 < first_row.size() ?
+                        std::min(end, first_row[i + 1]) : end;
+                    func(i, begin - first_row[i], level_end - first_row[i]);
+                    begin = level_end;
+                    i++;
+                }
+            });
+    }
 public:
     // ------------------------------------------------------------------------
     GEMipmapGenerator(uint8_t* texture, unsigned channels,
@@ -53,14 +53,11 @@ void GESPM::finalize()
     for (Armature& arm : getArmatures())
     {
         arm.getInterpolatedMatrices((float)m_bind_frame);
-        for (auto& p : arm.m_world_matrices)
-        {
-            p.second = false;
-        }
+        arm.updateWorldMatrices();
         for (unsigned i = 0; i < arm.m_joint_names.size(); i++)
         {
             core::matrix4 m;
-            arm.getWorldMatrix(arm.m_interpolated_matrices, i).getInverse(m);
+            arm.m_world_matrices[i].getInverse(m);
             arm.m_joint_matrices[i] = m;
         }
     }
@@ -85,7 +85,7 @@ void GEVulkanAnimatedMeshSceneNode::OnAnimate(irr::u32 time_ms)
         for (unsigned i = 0; i < arm.m_joint_names.size(); i++)
         {
             m_joint_nodes.at(arm.m_joint_names[i])->setAbsoluteTransformation
-                (AbsoluteTransformation * arm.m_world_matrices[i].first);
+                (AbsoluteTransformation * arm.m_world_matrices[i]);
         }
     }
 
@@ -239,12 +239,22 @@ void GEVulkanDrawCall::addNode(irr::scene::ISceneNode* node)
     else
         return;
 
+    const irr::core::matrix4& model_matrix = node->getAbsoluteTransformation();
+    m_culling_tool->clearBoxes();
+    for (unsigned i = 0; i < mesh->getMeshBufferCount(); i++)
+    {
+        irr::core::aabbox3df bb = mesh->getMeshBuffer(i)->getBoundingBox();
+        model_matrix.transformBoxEx(bb);
+        m_culling_tool->addBox(bb);
+    }
+    m_culling_tool->cullBoxes();
+
     bool added_skinning = false;
     for (unsigned i = 0; i < mesh->getMeshBufferCount(); i++)
     {
         GESPMBuffer* buffer = static_cast<GESPMBuffer*>(
             mesh->getMeshBuffer(i));
-        if (m_culling_tool->isCulled(buffer, node))
+        if (m_culling_tool->isBoxCulled(i))
             continue;
         const std::string& shader = getShader(node, i);
         if (buffer->getHardwareMappingHint_Vertex() == irr::scene::EHM_STREAM ||
@@ -501,43 +501,136 @@ bool AddonsManager::anyAddonsInstalled() const
     return false;
 }   // anyAddonsInstalled
 
+// ----------------------------------------------------------------------------
+/** Returns the temporary directory an addon is extracted to while it is
+ *  downloaded.
+ */
+static std::string getExtractDir(const Addon &addon)
+{
+    return file_manager->getAddonsFile("tmp/" + addon.getDirName());
+}   // getExtractDir
+
+// ----------------------------------------------------------------------------
+/** Downloads an addon. The zip file is not saved, it is extracted into a
+ *  temporary directory while it is being downloaded, which \ref install
+ *  then moves into place.
+ *  \param addon Addon data for the addon to download.
+ *  \return The queued request, which can be used to show the progress.
+ */
+std::shared_ptr<HTTPRequest> AddonsManager::downloadAddon(const Addon &addon)
+{
+    // A request that extracts all data it receives
+    class InstallRequest : public HTTPRequest
+    {
+        std::string m_extract_dir;
+        std::unique_ptr<ZipStreamExtractor> m_extractor;
+        bool m_extract_ok;
+        /** True if m_extract_dir was created and not removed yet. */
+        bool m_extract_dir_created;
+        // --------------------------------------------------------------------
+        void removeExtractDir()
+        {
+            if (file_manager->isDirectory(m_extract_dir))
+                file_manager->removeDirectory(m_extract_dir);
+            m_extract_dir_created = false;
+        }   // removeExtractDir
+        // --------------------------------------------------------------------
+        virtual void prepareOperation() OVERRIDE
+        {
+            removeExtractDir();
+            file_manager->checkAndCreateDirForAddons(m_extract_dir);
+            m_extract_dir_created = true;
+            m_extractor.reset(new ZipStreamExtractor(m_extract_dir));
+            HTTPRequest::prepareOperation();
+        }   // prepareOperation
+        // --------------------------------------------------------------------
+        virtual size_t writeData(const char *data, size_t size) OVERRIDE
+        {
+            return m_extractor->feed(data, size) ? size : 0;
+        }   // writeData
+        // --------------------------------------------------------------------
+        virtual void afterOperation() OVERRIDE
+        {
+            m_extract_ok = !HTTPRequest::hadDownloadError() &&
+                           m_extractor->finish();
+            if (m_extract_ok && UserConfigParams::logAddons())
+            {
+                Log::info("addons", "Extracted %u files (%d kB) to '%s'.",
+                          m_extractor->getNumFiles(),
+                          (int)(m_extractor->getTotalSize() / 1024),
+                          m_extract_dir.c_str());
+            }
+            m_extractor.reset();
+            HTTPRequest::afterOperation();
+            if (!m_extract_ok)
+            {
+                removeExtractDir();
+                setProgress(-1.0f);
+            }
+        }   // afterOperation
+    public:
+        InstallRequest(const std::string &extract_dir)
+            : HTTPRequest(/*priority*/5)
+        {
+            m_extract_dir         = extract_dir;
+            m_extract_ok          = false;
+            m_extract_dir_created = false;
+        }   // InstallRequest
+        // --------------------------------------------------------------------
+        /** afterOperation is skipped if the request manager aborts, so
+         *  remove a partially extracted addon here. A successfully
+         *  extracted addon is moved away by install(). */
+        ~InstallRequest()
+        {
+            m_extractor.reset();
+            if (m_extract_dir_created && !m_extract_ok)
+                removeExtractDir();
+        }   // ~InstallRequest
+        // --------------------------------------------------------------------
+        virtual bool hadDownloadError() const OVERRIDE
+        {
+            return HTTPRequest::hadDownloadError() || !m_extract_ok;
+        }   // hadDownloadError
+    };   // InstallRequest
+
+    auto r = std::make_shared<InstallRequest>(getExtractDir(addon));
+    r->setURL(addon.getZipFileName());
+    r->queue();
+    return r;
+}   // downloadAddon
+
 // ----------------------------------------------------------------------------
 /** Installs or updates (i.e. remove old and then install a new) an addon.
- *  It checks for the directories and then unzips the file (which must already
- *  have been downloaded).
+ *  The addon must have been extracted by the request from
+ *  \ref downloadAddon, its directory is moved into place, and only this
+ *  addon is loaded.
  *  \param addon Addon data for the addon to install.
  *  \return true if installation was successful.
  */
 bool AddonsManager::install(const Addon &addon)
 {
-
-    //extract the zip in the addons folder called like the addons name
-    std::string base_name = StringUtils::getBasename(addon.getZipFileName());
-    std::string from      = file_manager->getAddonsFile("tmp/"+base_name);
-    std::string to        = addon.getDataDir();
+    const std::string from = getExtractDir(addon);
+    const std::string to   = addon.getDataDir();
 
     // Remove old addon first (including non official way to install addons)
     AddonsPack::uninstallByName(addon.getDirName(), true/*force_clear*/);
     if (file_manager->isDirectory(to))
         file_manager->removeDirectory(to);
 
-    file_manager->checkAndCreateDirForAddons(to);
+    const std::string parent = StringUtils::getPath(to);
+    file_manager->checkAndCreateDirForAddons(parent);
 
-    bool success = extract_zip(from, to, true/*recursive*/);
+    bool success = file_manager->isDirectory(from) &&
+                   file_manager->moveDirectoryInto(from, parent);
     if (!success)
     {
         // TODO: show a message in the interface
-        Log::error("addons", "Failed to unzip '%s' to '%s'.",
+        Log::error("addons", "Failed to move '%s' to '%s'.",
                     from.c_str(), to.c_str());
-    }
-
-    if(!file_manager->removeFile(from))
-    {
-        Log::error("addons", "Problems removing temporary file '%s'.",
-                    from.c_str());
-    }
-    if (!success)
+        if (file_manager->isDirectory(from))
+            file_manager->removeDirectory(from);
         return false;
+    }
 
     int index = getAddonIndex(addon.getId());
     assert(index>=0 && index < (int)m_addons_list.getData().size());
@@ -565,7 +658,8 @@ bool AddonsManager::install(const Addon &addon)
 
         try
         {
-            track_manager->loadTrack(addon.getDataDir());
+            if (track_manager->loadTrack(addon.getDataDir() + "/"))
+                track_manager->updateScreenshotCache();
         }
         catch (std::exception& e)
         {
@@ -31,6 +31,8 @@
 #include "io/xml_node.hpp"
 #include "utils/synchronised.hpp"
 
+namespace Online { class HTTPRequest; }
+
 /**
   * \ingroup addonsgroup
   */
@@ -73,6 +75,7 @@ public:
     void         checkInstalledAddons();
     Addon* getAddon(const std::string &id);
     int          getAddonIndex(const std::string &id) const;
+    std::shared_ptr<Online::HTTPRequest> downloadAddon(const Addon &addon);
     bool         install(const Addon &addon);
     bool         uninstall(const Addon &addon);
     void         reInit();
@@ -16,14 +16,20 @@
 //  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include <string.h>
+#include "addons/zip.hpp"
+
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
 #include "graphics/irr_driver.hpp"
 #include "io/file_manager.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 
+#include <zlib.h>
+
 #include <IrrlichtDevice.h>
 #include <IFileSystem.h>
 #include <IReadFile.h>
@@ -129,3 +135,398 @@ bool extract_zip(const std::string &from, const std::string &to, bool recursive)
 
     return !error;
 }   // extract_zip
+
+// ============================================================================
+namespace
+{
+    /** Signatures of the zip records. */
+    const uint32_t ZIP_LOCAL_HEADER       = 0x04034b50;
+    const uint32_t ZIP_DATA_DESCRIPTOR    = 0x08074b50;
+    const uint32_t ZIP_CENTRAL_DIRECTORY  = 0x02014b50;
+    const uint32_t ZIP_END_OF_DIRECTORY   = 0x06054b50;
+
+    /** Compression methods. */
+    const uint16_t ZIP_METHOD_STORED      = 0;
+    const uint16_t ZIP_METHOD_DEFLATED    = 8;
+
+    /** General purpose flags. */
+    const uint16_t ZIP_FLAG_ENCRYPTED     = 0x0001;
+    const uint16_t ZIP_FLAG_DESCRIPTOR    = 0x0008;
+
+    /** Size of the output buffer, and of the write buffer of each file. */
+    const size_t   ZIP_IO_BUFFER_SIZE     = 256 * 1024;
+
+    /** Largest file, and largest sum of all files, that are extracted. Any
+     *  addon is far smaller, this protects the disk from broken or
+     *  malicious archives (e.g. zip bombs). */
+    const uint64_t ZIP_MAX_FILE_SIZE      = 512ull * 1024 * 1024;
+    const uint64_t ZIP_MAX_TOTAL_SIZE     = 2048ull * 1024 * 1024;
+
+    // ------------------------------------------------------------------------
+    uint16_t get16(const unsigned char *p)
+    {
+        return (uint16_t)(p[0] | (p[1] << 8));
+    }   // get16
+    // ------------------------------------------------------------------------
+    uint32_t get32(const unsigned char *p)
+    {
+        return (uint32_t)p[0]         | ((uint32_t)p[1] << 8) |
+              ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }   // get32
+    // ------------------------------------------------------------------------
+    uint64_t get64(const unsigned char *p)
+    {
+        return (uint64_t)get32(p) | ((uint64_t)get32(p + 4) << 32);
+    }   // get64
+}   // namespace
+
+// ----------------------------------------------------------------------------
+/** Creates an extractor.
+ *  \param to The destination directory, which must exist.
+ */
+ZipStreamExtractor::ZipStreamExtractor(const std::string &to)
+                  : m_to(to)
+{
+    m_state           = ZS_HEADER;
+    m_read            = 0;
+    m_file            = NULL;
+    m_flags           = 0;
+    m_method          = 0;
+    m_zip64           = false;
+    m_crc             = 0;
+    m_compressed_size = 0;
+    m_size            = 0;
+    m_current_crc     = 0;
+    m_consumed        = 0;
+    m_written         = 0;
+    m_num_files       = 0;
+    m_total_size      = 0;
+    m_output.resize(ZIP_IO_BUFFER_SIZE);
+
+    m_zstream = new z_stream();
+    memset(m_zstream, 0, sizeof(z_stream));
+    // Negative window bits: raw deflate data without zlib header
+    if (inflateInit2(m_zstream, -MAX_WBITS) != Z_OK)
+        fail("Can't initialise zlib");
+}   // ZipStreamExtractor
+
+// ----------------------------------------------------------------------------
+ZipStreamExtractor::~ZipStreamExtractor()
+{
+    if (m_file)
+        fclose(m_file);
+    inflateEnd(m_zstream);
+    delete m_zstream;
+}   // ~ZipStreamExtractor
+
+// ----------------------------------------------------------------------------
+/** Extracts the next part of the archive.
+ *  \param data The received data.
+ *  \param size Number of bytes received.
+ *  \return False if there was an error, in which case extraction stops.
+ */
+bool ZipStreamExtractor::feed(const char *data, size_t size)
+{
+    if (m_state == ZS_ERROR)
+        return false;
+    // The central directory is not needed
+    if (m_state == ZS_DONE)
+        return true;
+
+    m_buffer.insert(m_buffer.end(), data, data + size);
+    bool progress = true;
+    while (progress)
+    {
+        switch (m_state)
+        {
+        case ZS_HEADER:     progress = processHeader();     break;
+        case ZS_DATA:       progress = processData();       break;
+        case ZS_DESCRIPTOR: progress = processDescriptor(); break;
+        default:            progress = false;               break;
+        }
+    }
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_read);
+    m_read = 0;
+    return m_state != ZS_ERROR;
+}   // feed
+
+// ----------------------------------------------------------------------------
+/** Called once all data is received.
+ *  \return True if the whole archive was extracted successfully.
+ */
+bool ZipStreamExtractor::finish()
+{
+    if (m_state == ZS_DONE)
+        return true;
+    if (m_state != ZS_ERROR)
+        fail("Archive is truncated");
+    return false;
+}   // finish
+
+// ----------------------------------------------------------------------------
+/** Reads the local header of the next entry, and opens its destination file.
+ *  \return True if the header was processed.
+ */
+bool ZipStreamExtractor::processHeader()
+{
+    const size_t available = m_buffer.size() - m_read;
+    const unsigned char *p = (const unsigned char*)m_buffer.data() + m_read;
+    if (available < 4)
+        return false;
+
+    const uint32_t signature = get32(p);
+    if (signature == ZIP_CENTRAL_DIRECTORY ||
+        signature == ZIP_END_OF_DIRECTORY)
+    {
+        m_state = ZS_DONE;
+        return false;
+    }
+    if (signature != ZIP_LOCAL_HEADER)
+        return fail("Invalid local header");
+
+    if (available < 30)
+        return false;
+    const uint16_t name_length  = get16(p + 26);
+    const uint16_t extra_length = get16(p + 28);
+    if (available < 30u + name_length + extra_length)
+        return false;
+
+    m_flags           = get16(p + 6);
+    m_method          = get16(p + 8);
+    m_crc             = get32(p + 14);
+    m_compressed_size = get32(p + 18);
+    m_size            = get32(p + 22);
+    m_name.assign((const char*)p + 30, name_length);
+
+    // Zip64 extended information replaces sizes set to 0xffffffff
+    m_zip64 = false;
+    const unsigned char *extra = p + 30 + name_length;
+    for (unsigned i = 0; i + 4 <= extra_length; )
+    {
+        const uint16_t id  = get16(extra + i);
+        const uint16_t len = get16(extra + i + 2);
+        if (i + 4 + len > extra_length)
+            break;
+        if (id == 0x0001)
+        {
+            m_zip64 = true;
+            unsigned n = 0;
+            if (m_size == 0xffffffff && n + 8 <= len)
+            {
+                m_size = get64(extra + i + 4 + n);
+                n += 8;
+            }
+            if (m_compressed_size == 0xffffffff && n + 8 <= len)
+                m_compressed_size = get64(extra + i + 4 + n);
+        }
+        i += 4 + len;
+    }
+    m_read += 30 + name_length + extra_length;
+
+    if ((m_flags & ZIP_FLAG_ENCRYPTED) != 0)
+        return fail("Encrypted entries are not supported");
+    if (m_method != ZIP_METHOD_STORED && m_method != ZIP_METHOD_DEFLATED)
+        return fail("Unsupported compression method");
+    // The end of stored data can not be found without a size
+    if ((m_flags & ZIP_FLAG_DESCRIPTOR) != 0 && m_method == ZIP_METHOD_STORED)
+        return fail("Stored entry without size");
+    if ((m_flags & ZIP_FLAG_DESCRIPTOR) == 0 &&
+        (m_size > ZIP_MAX_FILE_SIZE || m_compressed_size > ZIP_MAX_FILE_SIZE))
+        return fail("File too large");
+
+    std::replace(m_name.begin(), m_name.end(), '\\', '/');
+    if (m_name.empty() || m_name[0] == '/' ||
+        m_name.find(':') != std::string::npos)
+        return fail("Invalid file name");
+    for (const std::string &part : StringUtils::split(m_name, '/'))
+    {
+        if (part == "..")
+            return fail("Invalid file name");
+    }
+
+    m_current_crc = crc32(0L, Z_NULL, 0);
+    m_consumed    = 0;
+    m_written     = 0;
+    if (m_method == ZIP_METHOD_DEFLATED && inflateReset(m_zstream) != Z_OK)
+        return fail("Can't reset zlib");
+
+    // Directories are created when their files are extracted, and hidden
+    // files are skipped (same as extract_zip), but their data is read
+    if (m_name[0] == '.' || m_name[m_name.size() - 1] == '/')
+    {
+        m_state = ZS_DATA;
+        return true;
+    }
+
+    Log::debug("addons", "Unzipping file '%s'.", m_name.c_str());
+    const std::string file_location = m_to + "/" + m_name;
+    file_manager->checkAndCreateDirectoryP(StringUtils::getPath(file_location));
+    m_file = FileUtils::fopenU8Path(file_location, "wb");
+    if (!m_file)
+        return fail("Can't create file");
+    setvbuf(m_file, NULL, _IOFBF, ZIP_IO_BUFFER_SIZE);
+    m_state = ZS_DATA;
+    return true;
+}   // processHeader
+
+// ----------------------------------------------------------------------------
+/** Writes (and inflates if necessary) the data of the current entry.
+ *  \return True if the entry is finished.
+ */
+bool ZipStreamExtractor::processData()
+{
+    const size_t available = m_buffer.size() - m_read;
+    const char *p = m_buffer.data() + m_read;
+    const bool has_size = (m_flags & ZIP_FLAG_DESCRIPTOR) == 0;
+
+    if (m_method == ZIP_METHOD_STORED)
+    {
+        const size_t n = (size_t)std::min<uint64_t>(available,
+            m_compressed_size - m_consumed);
+        if (n > 0 && !writeOutput(p, n))
+            return false;
+        m_read     += n;
+        m_consumed += n;
+        if (m_consumed < m_compressed_size)
+            return false;
+        return finishEntry();
+    }
+
+    size_t in = available;
+    if (has_size)
+        in = (size_t)std::min<uint64_t>(in, m_compressed_size - m_consumed);
+    if (in == 0)
+    {
+        if (has_size && m_consumed >= m_compressed_size)
+            return fail("Truncated compressed data");
+        return false;
+    }
+
+    m_zstream->next_in  = (Bytef*)p;
+    m_zstream->avail_in = (uInt)in;
+    int ret = Z_OK;
+    do
+    {
+        m_zstream->next_out  = (Bytef*)m_output.data();
+        m_zstream->avail_out = (uInt)m_output.size();
+        ret = inflate(m_zstream, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            return fail("Corrupt compressed data");
+        const size_t out = m_output.size() - m_zstream->avail_out;
+        if (out > 0 && !writeOutput(m_output.data(), out))
+            return false;
+    } while (ret != Z_STREAM_END && m_zstream->avail_out == 0);
+
+    const size_t used = in - m_zstream->avail_in;
+    m_read     += used;
+    m_consumed += used;
+    if (ret == Z_STREAM_END)
+        return finishEntry();
+    if (has_size && m_consumed >= m_compressed_size)
+        return fail("Truncated compressed data");
+    return false;
+}   // processData
+
+// ----------------------------------------------------------------------------
+/** Reads the data descriptor with the CRC32 and sizes of the current entry,
+ *  if they were not stored in its local header.
+ *  \return True if the descriptor was processed.
+ */
+bool ZipStreamExtractor::processDescriptor()
+{
+    const size_t available = m_buffer.size() - m_read;
+    const unsigned char *p = (const unsigned char*)m_buffer.data() + m_read;
+    if (available < 4)
+        return false;
+
+    // The signature of the data descriptor is optional
+    const size_t offset    = get32(p) == ZIP_DATA_DESCRIPTOR ? 4 : 0;
+    const size_t size_len  = m_zip64 ? 8 : 4;
+    if (available < offset + 4 + 2 * size_len)
+        return false;
+
+    p += offset;
+    m_crc             = get32(p);
+    m_compressed_size = m_zip64 ? get64(p + 4) : get32(p + 4);
+    m_size            = m_zip64 ? get64(p + 4 + size_len) : get32(p + 8);
+    m_read += offset + 4 + 2 * size_len;
+    if (m_size > ZIP_MAX_FILE_SIZE || m_compressed_size > ZIP_MAX_FILE_SIZE)
+        return fail("File too large");
+    return checkEntry();
+}   // processDescriptor
+
+// ----------------------------------------------------------------------------
+/** Closes the file of the finished entry.
+ *  \return True if successful.
+ */
+bool ZipStreamExtractor::finishEntry()
+{
+    if (m_file)
+    {
+        const bool error = fclose(m_file) != 0;
+        m_file = NULL;
+        if (error)
+            return fail("Can't write file");
+        m_num_files++;
+    }
+    if ((m_flags & ZIP_FLAG_DESCRIPTOR) != 0)
+    {
+        m_state = ZS_DESCRIPTOR;
+        return true;
+    }
+    return checkEntry();
+}   // finishEntry
+
+// ----------------------------------------------------------------------------
+/** Checks the CRC32 and sizes of the finished entry, and continues with the
+ *  next entry.
+ *  \return True if the entry is valid.
+ */
+bool ZipStreamExtractor::checkEntry()
+{
+    if (m_current_crc != m_crc)
+        return fail("CRC32 mismatch");
+    if (m_written != m_size || m_consumed != m_compressed_size)
+        return fail("Size mismatch");
+    m_total_size += m_written;
+    m_state = ZS_HEADER;
+    return true;
+}   // checkEntry
+
+// ----------------------------------------------------------------------------
+/** Writes extracted data of the current entry.
+ *  \return True if successful.
+ */
+bool ZipStreamExtractor::writeOutput(const char *data, size_t size)
+{
+    m_current_crc = crc32(m_current_crc, (const Bytef*)data, (uInt)size);
+    m_written += size;
+    // Don't fill the disk with an entry larger than it claims to be, or
+    // (if its size is only known afterwards) larger than any valid file
+    if ((m_flags & ZIP_FLAG_DESCRIPTOR) == 0 && m_written > m_size)
+        return fail("Size mismatch");
+    if (m_written > ZIP_MAX_FILE_SIZE ||
+        m_total_size + m_written > ZIP_MAX_TOTAL_SIZE)
+        return fail("File too large");
+    if (m_file && fwrite(data, 1, size, m_file) != size)
+        return fail("Can't write file");
+    return true;
+}   // writeOutput
+
+// ----------------------------------------------------------------------------
+/** Stops extraction because of an error.
+ *  \param reason Description of the error.
+ *  \return Always false.
+ */
+bool ZipStreamExtractor::fail(const char *reason)
+{
+    Log::warn("addons", "Can't extract '%s' to '%s': %s.", m_name.c_str(),
+              m_to.c_str(), reason);
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = NULL;
+    }
+    m_state = ZS_ERROR;
+    return false;
+}   // fail
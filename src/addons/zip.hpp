@@ -18,10 +18,97 @@
 #ifndef HEADER_ZIP_HPP
 #define HEADER_ZIP_HPP
 
+#include "utils/no_copy.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct z_stream_s;
+
 /**
   * Extract a zip.
   * \ingroup addonsgroup
   */
 bool extract_zip(const std::string &from, const std::string &to, bool recursive = false);
 
+/**
+  * Extracts a zip archive while it is being received (e.g. downloaded), so
+  * no complete copy of the archive needs to be written and read again. The
+  * entries are read using their local headers, the central directory at the
+  * end of the archive is ignored. Each extracted file is checked against the
+  * CRC32 and size stored in the archive, and archives with too large files
+  * (512 MB, or 2 GB for all files) are rejected.
+  * \ingroup addonsgroup
+  */
+class ZipStreamExtractor : public NoCopy
+{
+private:
+    enum ExtractState { ZS_HEADER, ZS_DATA, ZS_DESCRIPTOR, ZS_DONE, ZS_ERROR };
+    ExtractState m_state;
+
+    /** The destination directory. */
+    std::string m_to;
+
+    /** Data received, but not processed yet. */
+    std::vector<char> m_buffer;
+
+    /** Index of the first unprocessed byte in \ref m_buffer. */
+    size_t m_read;
+
+    /** Inflate state for deflated entries. */
+    z_stream_s *m_zstream;
+
+    /** Buffer for inflated data before it is written. */
+    std::vector<char> m_output;
+
+    /** Name of the current entry. */
+    std::string m_name;
+
+    /** File the current entry is written to, NULL if it is skipped. */
+    FILE *m_file;
+
+    /** Flags and compression method of the current entry. */
+    uint16_t m_flags;
+    uint16_t m_method;
+
+    /** If the current entry has zip64 sizes. */
+    bool m_zip64;
+
+    /** CRC32 and sizes of the current entry as stored in the archive. */
+    uint32_t m_crc;
+    uint64_t m_compressed_size;
+    uint64_t m_size;
+
+    /** CRC32 and sizes of the current entry as processed so far. */
+    uint32_t m_current_crc;
+    uint64_t m_consumed;
+    uint64_t m_written;
+
+    /** Statistics. */
+    unsigned m_num_files;
+    uint64_t m_total_size;
+
+    bool processHeader();
+    bool processData();
+    bool processDescriptor();
+    bool finishEntry();
+    bool checkEntry();
+    bool writeOutput(const char *data, size_t size);
+    bool fail(const char *reason);
+
+public:
+             ZipStreamExtractor(const std::string &to);
+            ~ZipStreamExtractor();
+    bool     feed(const char *data, size_t size);
+    bool     finish();
+    // ------------------------------------------------------------------------
+    /** Returns the number of extracted files. */
+    unsigned getNumFiles() const                     { return m_num_files; }
+    // ------------------------------------------------------------------------
+    /** Returns the total size of all extracted files. */
+    uint64_t getTotalSize() const                   { return m_total_size; }
+};   // ZipStreamExtractor
+
 #endif
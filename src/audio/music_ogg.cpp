@@ -27,16 +27,29 @@
 #include "utils/constants.hpp"
 #include "utils/file_utils.hpp"
 #include "utils/log.hpp"
+#include "utils/vs.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+std::atomic<uint32_t> MusicOggStream::m_num_underruns(0);
 
 MusicOggStream::MusicOggStream(float loop_start, float loop_end)
 {
     //m_oggStream= NULL;
-    m_soundBuffers[0] = m_soundBuffers[1]= 0;
+    for (int i = 0; i < m_num_buffers; i++)
+        m_soundBuffers[i] = 0;
     m_soundSource     = -1;
     m_pausedMusic     = true;
     m_playing.store(false);
     m_loop_start      = loop_start;
     m_loop_end        = loop_end;
+    m_pcm_read.store(0);
+    m_pcm_write.store(0);
+    m_decode_stop.store(false);
+    m_decode_finished.store(false);
+    m_decoded_since_seek = false;
 }   // MusicOggStream
 
 //-----------------------------------------------------------------------------
@@ -50,6 +63,7 @@ MusicOggStream::~MusicOggStream()
 bool MusicOggStream::load(const std::string& filename)
 {
     if (isPlaying()) stopMusic();
+    stopDecoding();
 
     m_error = true;
     m_fileName = filename;
@@ -109,7 +123,7 @@ bool MusicOggStream::load(const std::string& filename)
     if (m_vorbisInfo->channels == 1) nb_channels = AL_FORMAT_MONO16;
     else                             nb_channels = AL_FORMAT_STEREO16;
 
-    alGenBuffers(2, m_soundBuffers);
+    alGenBuffers(m_num_buffers, m_soundBuffers);
     if (check("alGenBuffers") == false) return false;
 
     alGenSources(1, &m_soundSource);
@@ -123,9 +137,133 @@ bool MusicOggStream::load(const std::string& filename)
     alSourcei (m_soundSource, AL_SOURCE_RELATIVE, AL_TRUE      );
 
     m_error=false;
+    startDecoding();
     return true;
 }   // load
 
+//-----------------------------------------------------------------------------
+/** Starts decoding the music into the ring buffer, so that the beginning of
+ *  the music is already decoded when it starts playing.
+ */
+void MusicOggStream::startDecoding()
+{
+    // Two seconds of 16 bit stereo audio at 44100 samples per second
+    m_pcm.resize(m_buffer_size * 8);
+    m_pcm_read.store(0);
+    m_pcm_write.store(0);
+    m_decode_stop.store(false);
+    m_decode_finished.store(false);
+    m_decoded_since_seek = false;
+#ifndef __SWITCH__
+    m_decode_thread = std::thread(std::bind(&MusicOggStream::decodeLoop,
+                                            this));
+#endif
+}   // startDecoding
+
+//-----------------------------------------------------------------------------
+void MusicOggStream::stopDecoding()
+{
+    if (!m_decode_thread.joinable())
+        return;
+    m_decode_mutex.lock();
+    m_decode_stop.store(true);
+    m_decode_mutex.unlock();
+    m_decode_condition.notify_all();
+    m_decode_thread.join();
+}   // stopDecoding
+
+//-----------------------------------------------------------------------------
+/** Thread function which keeps the ring buffer filled with decoded data.
+ */
+void MusicOggStream::decodeLoop()
+{
+    VS::setThreadName("MusicDecode");
+    while (!m_decode_stop.load())
+    {
+        if (decode())
+            continue;
+        if (m_decode_finished.load())
+            break;
+        // The ring buffer is full, wait till the sfx thread used some data
+        std::unique_lock<std::mutex> ul(m_decode_mutex);
+        m_decode_condition.wait(ul, [this]()
+            {
+                return m_decode_stop.load() ||
+                       getDecodedBytes() + 4096 <= m_pcm.size();
+            });
+    }
+}   // decodeLoop
+
+//-----------------------------------------------------------------------------
+/** Decodes the next part of the music into the ring buffer, and seeks to the
+ *  loop start at the end of the file or loop.
+ *  \return False if the ring buffer is full or there is no more data.
+ */
+bool MusicOggStream::decode()
+{
+    if (m_decode_finished.load())
+        return false;
+
+    const uint64_t size = m_pcm.size();
+    const uint64_t write = m_pcm_write.load(std::memory_order_relaxed);
+    const uint64_t free_space = size - getDecodedBytes();
+    if (free_space < 4096)
+        return false;
+
+    // ov_read can only write into the contiguous part of the ring buffer
+    const uint64_t offset = write % size;
+    const int len = (int)std::min(std::min(free_space, size - offset),
+                                  (uint64_t)4096);
+    const int is_big_endian = (IS_LITTLE_ENDIAN ? 0 : 1);
+    int portion;
+    long result = ov_read(&m_oggStream, m_pcm.data() + offset, len,
+                          is_big_endian, 2, 1, &portion);
+
+    if (result == OV_HOLE)
+    {
+        // Interruption in the data, decoding can continue
+        return true;
+    }
+    if (result < 0)
+    {
+        Log::error("MusicOgg", "Decoding %s failed: %s", m_fileName.c_str(),
+                   errorString((int)result).c_str());
+        m_decode_mutex.lock();
+        m_decode_finished.store(true);
+        m_decode_mutex.unlock();
+        m_decode_condition.notify_all();
+        return false;
+    }
+
+    if (result > 0)
+    {
+        m_pcm_write.store(write + result, std::memory_order_release);
+        m_decoded_since_seek = true;
+        m_decode_mutex.lock();
+        m_decode_mutex.unlock();
+        m_decode_condition.notify_all();
+    }
+
+    if (result == 0 ||
+        (m_loop_end > 0 && (m_loop_end - ov_time_tell(&m_oggStream)) < 1e-3))
+    {
+        if (!m_decoded_since_seek)
+        {
+            // Nothing to play between loop start and end of the file
+            m_decode_mutex.lock();
+            m_decode_finished.store(true);
+            m_decode_mutex.unlock();
+            m_decode_condition.notify_all();
+            return false;
+        }
+        // No more data, or reached loop end. Seek to loop start (causes the
+        // sound to loop)
+        ov_time_seek(&m_oggStream, m_loop_start);
+        m_decoded_since_seek = false;
+    }
+    return true;
+}   // decode
+
 //-----------------------------------------------------------------------------
 bool MusicOggStream::empty()
 {
@@ -158,9 +296,12 @@ bool MusicOggStream::release()
     empty();
     alDeleteSources(1, &m_soundSource);
     check("alDeleteSources");
-    alDeleteBuffers(2, m_soundBuffers);
+    alDeleteBuffers(m_num_buffers, m_soundBuffers);
     check("alDeleteBuffers");
+    m_free_buffers.clear();
 
+    // The decoding thread must not use the ogg stream anymore
+    stopDecoding();
     // Handle error correctly
     if(!m_error) ov_clear(&m_oggStream);
 
@@ -176,14 +317,25 @@ bool MusicOggStream::playMusic()
     if(isPlaying())
         return true;
 
-    if(!streamIntoBuffer(m_soundBuffers[0]))
-        return false;
+#ifdef __SWITCH__
+    while (decode()) {}
+#else
+    {
+        // Usually the data was already decoded after loading
+        std::unique_lock<std::mutex> ul(m_decode_mutex);
+        m_decode_condition.wait(ul, [this]()
+            {
+                return m_decode_finished.load() ||
+                    getDecodedBytes() >= m_num_buffers * m_buffer_size;
+            });
+    }
+#endif
 
-    if(!streamIntoBuffer(m_soundBuffers[1]))
+    m_free_buffers.assign(m_soundBuffers, m_soundBuffers + m_num_buffers);
+    queueFreeBuffers();
+    if (m_free_buffers.size() == m_num_buffers)
         return false;
 
-    alSourceQueueBuffers(m_soundSource, 2, m_soundBuffers);
-
     alSourcePlay(m_soundSource);
     m_pausedMusic = false;
     m_playing.store(true);
@@ -272,8 +424,11 @@ void MusicOggStream::update()
         return;
     }
 
+#ifdef __SWITCH__
+    while (decode()) {}
+#endif
+
     int processed= 0;
-    bool active= true;
 
     alGetSourcei(m_soundSource, AL_BUFFERS_PROCESSED, &processed);
 
@@ -283,21 +438,12 @@ void MusicOggStream::update()
 
         alSourceUnqueueBuffers(m_soundSource, 1, &buffer);
         if(!check("alSourceUnqueueBuffers")) return;
-
-        active = streamIntoBuffer(buffer);
-        float cur_time = (float)ov_time_tell(&m_oggStream);
-        if(!active || (m_loop_end > 0 && (m_loop_end - cur_time) < 1e-3))
-        {
-            // No more data, or reached loop end. Seek to loop start (causes the sound to loop)
-            ov_time_seek(&m_oggStream, m_loop_start);
-            active = streamIntoBuffer(buffer);//now there really should be data
-        }
-
-        alSourceQueueBuffers(m_soundSource, 1, &buffer);
-        if (!check("alSourceQueueBuffers")) return;
+        m_free_buffers.push_back(buffer);
     }
 
-    if (active)
+    queueFreeBuffers();
+
+    if (m_free_buffers.size() < m_num_buffers)
     {
         // For debugging
         SFXManager::checkError("before source state");
@@ -306,17 +452,19 @@ void MusicOggStream::update()
         alGetSourcei(m_soundSource, AL_SOURCE_STATE, &state);
         if (state != AL_PLAYING)
         {
+            // All queued data was played before new data was decoded
+            m_num_underruns.fetch_add(1);
             // Prevent flooding
             static int count = 0;
             count++;
             if (count<10)
                 Log::warn("MusicOgg", "Music not playing when it should be. "
-                          "Source state: %d", state);
-            alGetSourcei(m_soundSource, AL_BUFFERS_PROCESSED, &processed);
+                          "Source state: %d, %d underruns so far.", state,
+                          m_num_underruns.load());
             alSourcePlay(m_soundSource);
         }
     }
-    else
+    else if (m_decode_finished.load())
     {
         Log::warn("MusicOgg", "Attempt to stream music into buffer failed "
                               "twice in a row.");
@@ -324,33 +472,60 @@ void MusicOggStream::update()
 }   // update
 
 //-----------------------------------------------------------------------------
-bool MusicOggStream::streamIntoBuffer(ALuint buffer)
+/** Fills all played OpenAL buffers with decoded data (as far as available)
+ *  and queues them again.
+ *  \return False if not all buffers could be filled.
+ */
+bool MusicOggStream::queueFreeBuffers()
 {
-    char pcm[m_buffer_size];
-    const int isBigEndian = (IS_LITTLE_ENDIAN ? 0 : 1);
-
-    int  size = 0;
-    int  portion;
-
-    while(size < m_buffer_size)
+    while (!m_free_buffers.empty())
     {
-        int result = ov_read(&m_oggStream, pcm + size, m_buffer_size - size,
-                         isBigEndian, 2, 1, &portion);
-
-        if(result > 0)
-            size += result;
-        else
-            if(result < 0)
-                throw errorString(result);
-            else
-                break;
+        ALuint buffer = m_free_buffers.back();
+        if (!streamIntoBuffer(buffer))
+            return false;
+        alSourceQueueBuffers(m_soundSource, 1, &buffer);
+        if (!check("alSourceQueueBuffers")) return false;
+        m_free_buffers.pop_back();
     }
+    return true;
+}   // queueFreeBuffers
 
-    if(size == 0) return false;
+//-----------------------------------------------------------------------------
+/** Copies decoded data from the ring buffer into an OpenAL buffer.
+ *  \return False if not enough data is decoded yet.
+ */
+bool MusicOggStream::streamIntoBuffer(ALuint buffer)
+{
+    const bool finished = m_decode_finished.load();
+    const uint64_t available = getDecodedBytes();
+    // Avoid queueing tiny buffers, unless it's the end of the music
+    if (available == 0 || (available < m_buffer_size / 4 && !finished))
+        return false;
 
-    alBufferData(buffer, nb_channels, pcm, size, m_vorbisInfo->rate);
+    const int size = (int)std::min(available, (uint64_t)m_buffer_size);
+    const uint64_t read = m_pcm_read.load(std::memory_order_relaxed);
+    const uint64_t offset = read % m_pcm.size();
+    if (offset + size <= m_pcm.size())
+    {
+        alBufferData(buffer, nb_channels, m_pcm.data() + offset, size,
+                     m_vorbisInfo->rate);
+    }
+    else
+    {
+        // The data wraps around the end of the ring buffer
+        char pcm[m_buffer_size];
+        const size_t first = m_pcm.size() - offset;
+        memcpy(pcm, m_pcm.data() + offset, first);
+        memcpy(pcm + first, m_pcm.data(), size - first);
+        alBufferData(buffer, nb_channels, pcm, size, m_vorbisInfo->rate);
+    }
     check("alBufferData");
 
+    m_pcm_read.store(read + size, std::memory_order_release);
+    // Wake up the decoding thread if it waits for free space
+    m_decode_mutex.lock();
+    m_decode_mutex.unlock();
+    m_decode_condition.notify_all();
     return true;
 }   // streamIntoBuffer
 
@@ -37,9 +37,17 @@
 #include "audio/music.hpp"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /**
   * \brief ogg files based implementation of the Music interface
+  * The ogg file is decoded by a separate thread into a ring buffer, which
+  * is usually a few seconds ahead of the played music. \ref update (called
+  * from the sfx thread) only copies decoded data into the OpenAL buffers,
+  * so a delay in the sfx thread or a slow decode does not stop the music.
   * \ingroup audio
   */
 class MusicOggStream : public Music
@@ -59,6 +67,9 @@ public:
     virtual bool resumeMusic();
     virtual void setVolume(float volume);
     virtual bool isPlaying();
+    // ------------------------------------------------------------------------
+    /** Returns how often the music stopped because decoding was too slow. */
+    static uint32_t getNumUnderruns() { return m_num_underruns.load(); }
 
 protected:
     bool empty();
@@ -68,6 +79,18 @@ protected:
 private:
     bool release();
     bool streamIntoBuffer(ALuint buffer);
+    bool queueFreeBuffers();
+    void startDecoding();
+    void stopDecoding();
+    bool decode();
+    void decodeLoop();
+    // ------------------------------------------------------------------------
+    /** Returns the number of decoded bytes not yet copied to OpenAL. */
+    uint64_t getDecodedBytes() const
+    {
+        return m_pcm_write.load(std::memory_order_acquire) -
+               m_pcm_read.load(std::memory_order_acquire);
+    }   // getDecodedBytes
 
     float           m_loop_start;
     float           m_loop_end;
@@ -79,14 +102,47 @@ private:
 
     std::atomic_bool m_playing;
 
-    ALuint m_soundBuffers[2];
+    /** Number of OpenAL buffers queued to the source. */
+    static const int m_num_buffers = 4;
+
+    ALuint m_soundBuffers[m_num_buffers];
     ALuint m_soundSource;
     ALenum nb_channels;
 
+    /** OpenAL buffers which were played, and are waiting for new data. */
+    std::vector<ALuint> m_free_buffers;
+
     bool m_pausedMusic;
 
-    //one full second of audio at 44100 samples per second
+    //a quarter second of 16 bit stereo audio at 44100 samples per second
     static const int m_buffer_size = 11025*4;
+
+    /** Ring buffer of decoded data. It is only written by the decoding
+     *  thread and only read by the sfx thread, so the read and write
+     *  positions (in bytes since the start of decoding) are enough to
+     *  synchronise them. */
+    std::vector<char> m_pcm;
+    std::atomic<uint64_t> m_pcm_read;
+    std::atomic<uint64_t> m_pcm_write;
+
+    /** If the decoding thread should stop. */
+    std::atomic_bool m_decode_stop;
+
+    /** If there will be no more decoded data, because of an error. */
+    std::atomic_bool m_decode_finished;
+
+    /** If data was decoded since the last seek, to detect empty loops. */
+    bool m_decoded_since_seek;
+
+    std::thread m_decode_thread;
+
+    /** Used to wake up the decoding thread when data was read, and the sfx
+     *  thread when data was decoded. */
+    std::mutex m_decode_mutex;
+    std::condition_variable m_decode_condition;
+
+    /** How often the music stopped because no data was decoded in time. */
+    static std::atomic<uint32_t> m_num_underruns;
 };
 
 #endif
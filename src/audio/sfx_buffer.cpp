@@ -23,12 +23,17 @@
 #include "utils/constants.hpp"
 #include "utils/file_utils.hpp"
 #include "utils/log.hpp"
+#include "utils/time.hpp"
 
 #ifdef ENABLE_SOUND
 #  include <vorbis/codec.h>
 #  include <vorbis/vorbisfile.h>
 #endif
 
+std::atomic<uint64_t> SFXBuffer::m_loaded_bytes(0);
+std::atomic<uint32_t> SFXBuffer::m_num_decoded(0);
+std::atomic<uint64_t> SFXBuffer::m_decode_time(0);
+
 //----------------------------------------------------------------------------
 /** Creates a sfx. The parameter are taken from the parameters:
  *  \param file File name of the buffer.
@@ -50,6 +55,9 @@ SFXBuffer::SFXBuffer(const std::string& file,
     m_max_dist    = max_dist;
     m_duration    = -1.0f;
     m_file        = file;
+    m_size        = 0;
+    m_num_sources = 0;
+    m_last_use    = 0;
 
     m_rolloff     = rolloff;
     m_positional  = positional;
@@ -70,6 +78,9 @@ SFXBuffer::SFXBuffer(const std::string& file,
     m_max_dist    = 300.0f;
     m_duration    = -1.0f;
     m_positional  = false;
+    m_size        = 0;
+    m_num_sources = 0;
+    m_last_use    = 0;
     m_loaded      = false;
     m_file        = file;
 
@@ -105,6 +116,7 @@ bool SFXBuffer::load()
     
         assert(alIsBuffer(m_buffer));
     
+        uint64_t start = StkTime::getMonoTimeMs();
         if (!loadVorbisBuffer(m_file, m_buffer))
         {
             Log::error("SFXBuffer", "Could not load sound effect %s",
@@ -112,6 +124,15 @@ bool SFXBuffer::load()
             // TODO: free al buffer here?
             return false;
         }
+        uint64_t decode_time = StkTime::getMonoTimeMs() - start;
+        m_decode_time.fetch_add(decode_time);
+        m_num_decoded.fetch_add(1);
+        m_loaded_bytes.fetch_add(m_size);
+        if (UserConfigParams::logMisc())
+        {
+            Log::debug("SFXBuffer", "Decoded %s: %u bytes in %dms.",
+                       m_file.c_str(), m_size, (int)decode_time);
+        }
     }
 #endif
 
@@ -134,6 +155,8 @@ void SFXBuffer::unload()
         {
             alDeleteBuffers(1, &m_buffer);
             m_buffer = 0;
+            m_loaded_bytes.fetch_sub(m_size);
+            m_size = 0;
         }
     }
 #endif
@@ -217,6 +240,7 @@ bool SFXBuffer::loadVorbisBuffer(const std::string &name, ALuint buffer)
 
     ov_clear(&oggFile);
     fclose(file);
+    m_size = buffer_size;
 
     // Allow the xml data to overwrite the duration, but if there is no
     // duration (which is the norm), compute it:
@@ -30,6 +30,8 @@ typedef unsigned int ALuint;
 #include "utils/vec3.hpp"
 #include "utils/leak_check.hpp"
 
+#include <assert.h>
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -70,6 +72,24 @@ private:
     /** Duration of the sfx. */
     float    m_duration;
 
+    /** Size of the decoded data in bytes, 0 if not loaded. */
+    unsigned m_size;
+
+    /** Number of sound sources using this buffer, managed by the SFXManager.
+     *  A buffer can only be unloaded if it is not used. */
+    int      m_num_sources;
+
+    /** When this buffer was used last, to unload the least recently used
+     *  buffers first. */
+    uint64_t m_last_use;
+
+    /** Total size of all loaded buffers. */
+    static std::atomic<uint64_t> m_loaded_bytes;
+
+    /** Number of loaded buffers and the total time spent decoding them. */
+    static std::atomic<uint32_t> m_num_decoded;
+    static std::atomic<uint64_t> m_decode_time;
+
     bool loadVorbisBuffer(const std::string &name, ALuint buffer);
 
 public:
@@ -117,6 +137,28 @@ public:
     // ------------------------------------------------------------------------
     /** Returns how long this buffer will play. */
     float getDuration() const { return m_duration; }
+    // ------------------------------------------------------------------------
+    /** Returns the size of the decoded sound data, 0 if not loaded. */
+    unsigned getSize() const { return m_size; }
+    // ------------------------------------------------------------------------
+    int  getNumSources() const { return m_num_sources; }
+    // ------------------------------------------------------------------------
+    void addSource()    { m_num_sources++; }
+    // ------------------------------------------------------------------------
+    void removeSource() { assert(m_num_sources > 0); m_num_sources--; }
+    // ------------------------------------------------------------------------
+    uint64_t getLastUse() const { return m_last_use; }
+    // ------------------------------------------------------------------------
+    void setLastUse(uint64_t t) { m_last_use = t; }
+    // ------------------------------------------------------------------------
+    /** Returns the total size of all loaded buffers. */
+    static uint64_t getLoadedBytes() { return m_loaded_bytes.load(); }
+    // ------------------------------------------------------------------------
+    /** Returns the number of buffers decoded so far. */
+    static uint32_t getNumDecoded() { return m_num_decoded.load(); }
+    // ------------------------------------------------------------------------
+    /** Returns the total time in ms spent decoding buffers. */
+    static uint64_t getDecodeTime() { return m_decode_time.load(); }
 
 };   // class SFXBuffer
 
@@ -23,7 +23,6 @@
 #include "config/user_config.hpp"
 #include "io/file_manager.hpp"
 #include "race/race_manager.hpp"
-#include "states_screens/state_manager.hpp"
 #include "utils/stk_process.hpp"
 #include "utils/profiler.hpp"
 #include "utils/string_utils.hpp"
@@ -81,6 +80,7 @@ SFXManager::SFXManager()
     m_initialized = music_manager->initialized();
     m_master_gain = UserConfigParams::m_sfx_volume;
     m_last_update_time = std::numeric_limits<uint64_t>::max();
+    m_buffer_use_counter = 0;
     // Init position, since it can be used before positionListener is called.
     // No need to use lock here, since the thread will be created later.
     m_listener_position.getData() = Vec3(0, 0, 0);
@@ -169,8 +169,7 @@ void SFXManager::queue(SFXCommands command,  SFXBase *sfx)
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, sfx);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, sfx));
 #endif
 }   // queue
 
@@ -188,8 +187,7 @@ void SFXManager::queue(SFXCommands command, SFXBase *sfx, float f)
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, sfx, f);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, sfx, f));
 #endif
 }   // queue(float)
 
@@ -207,8 +205,7 @@ void SFXManager::queue(SFXCommands command, SFXBase *sfx, const Vec3 &p)
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, sfx, p);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, sfx, p));
 #endif
 }   // queue (Vec3)
 
@@ -220,8 +217,8 @@ void SFXManager::queue(SFXCommands command, SFXBase *sfx, const Vec3 &p, SFXBuff
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, sfx, p);
-    sfx_command->m_buffer = buffer;
+    SFXCommand sfx_command(command, sfx, p);
+    sfx_command.m_buffer = buffer;
     queueCommand(sfx_command);
 #endif
 }   // queue (Vec3)
@@ -242,8 +239,7 @@ void SFXManager::queue(SFXCommands command, SFXBase *sfx, float f,
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, sfx, f, p);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, sfx, f, p));
 #endif
 }   // queue(float, Vec3)
 
@@ -257,8 +253,7 @@ void SFXManager::queue(SFXCommands command, MusicInformation *mi)
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, mi);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, mi));
 #endif
 }   // queue(MusicInformation)
 //----------------------------------------------------------------------------
@@ -273,48 +268,123 @@ void SFXManager::queue(SFXCommands command, MusicInformation *mi, float f)
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
 
-    SFXCommand *sfx_command = new SFXCommand(command, mi, f);
-    queueCommand(sfx_command);
+    queueCommand(SFXCommand(command, mi, f));
 #endif
 }   // queue(MusicInformation)
 
 //----------------------------------------------------------------------------
 /** Enqueues a command to the sfx queue threadsafe. Then signal the
  *  sfx manager to wake up.
- *  \param command Pointer to the command to queue up.
+ *  \param command The command to queue up.
  */
-void SFXManager::queueCommand(SFXCommand *command)
+void SFXManager::queueCommand(const SFXCommand &command)
 {
 #ifdef ENABLE_SOUND
     if (!UserConfigParams::m_enable_sound || STKProcess::getType() != PT_MAIN)
         return;
-        
+
     m_sfx_commands.lock();
-    if (StateManager::get()->getGameState() != GUIEngine::MENU &&
-        m_sfx_commands.getData().size() > 20*RaceManager::get()->getNumberOfKarts()+20 &&
-        RaceManager::get()->getMinorMode() != RaceManager::MINOR_MODE_CUTSCENE)
+    if (!m_sfx_commands.getData().push(command))
     {
-        if(command->m_command==SFX_POSITION || command->m_command==SFX_LOOP ||
-           command->m_command==SFX_SPEED    || 
-           command->m_command==SFX_SPEED_POSITION                               )
+        static int count_messages = 0;
+        if (count_messages < 5)
         {
-            delete command;
-            static int count_messages = 0;
-            if(count_messages < 5)
-            {
-                Log::warn("SFXManager", "Throttling sfx - queue size %d",
-                         m_sfx_commands.getData().size());
-                count_messages++;
-            }
-            m_sfx_commands.unlock();
-            return;
-        }   // if throttling
+            Log::warn("SFXManager", "Throttling sfx - queue size %d",
+                      (int)m_sfx_commands.getData().size());
+            count_messages++;
+        }
     }
-    m_sfx_commands.getData().push_back(command);
     m_sfx_commands.unlock();
 #endif
 }   // queueCommand
 
+//----------------------------------------------------------------------------
+SFXManager::SFXCommandQueue::SFXCommandQueue()
+{
+    m_commands.resize(1024);
+    clear();
+}   // SFXCommandQueue
+
+//----------------------------------------------------------------------------
+unsigned SFXManager::SFXCommandQueue::getHashIndex(const SFXBase *sfx) const
+{
+    // The low bits of a pointer are always 0 due to alignment
+    const size_t n = sizeof(m_last_command) / sizeof(m_last_command[0]);
+    return (unsigned)(((size_t)sfx >> 4) ^ ((size_t)sfx >> 12)) & (n - 1);
+}   // getHashIndex
+
+//----------------------------------------------------------------------------
+/** Adds a command to the queue, or merges it with the last queued command of
+ *  the same sfx if both only update the same property of it.
+ *  \return False if the command was dropped because the queue is full.
+ */
+bool SFXManager::SFXCommandQueue::push(const SFXCommand &command)
+{
+    const bool is_update = command.m_command == SFX_POSITION       ||
+                           command.m_command == SFX_SPEED          ||
+                           command.m_command == SFX_SPEED_POSITION ||
+                           command.m_command == SFX_VOLUME;
+    unsigned hash_index = 0;
+    if (command.m_sfx)
+    {
+        hash_index = getHashIndex(command.m_sfx);
+        const uint64_t last = m_last_command[hash_index];
+        SFXCommand &prev = m_commands[last & (m_commands.size() - 1)];
+        if (is_update && last >= m_read && last < m_write &&
+            prev.m_sfx == command.m_sfx &&
+            prev.m_command == command.m_command)
+        {
+            prev.m_parameter = command.m_parameter;
+            return true;
+        }
+    }
+
+    if (m_write - m_read == m_commands.size())
+    {
+        // Updates are only dropped when they could not be merged, which
+        // means something else is blocking the sfx thread.
+        if (is_update)
+            return false;
+        grow();
+    }
+    if (command.m_sfx)
+        m_last_command[hash_index] = m_write;
+    m_commands[m_write & (m_commands.size() - 1)] = command;
+    m_write++;
+    return true;
+}   // push
+
+//----------------------------------------------------------------------------
+/** Doubles the size of the queue. The queue only grows if more commands than
+ *  the initial size are queued, which should never happen in practice. */
+void SFXManager::SFXCommandQueue::grow()
+{
+    std::vector<SFXCommand> commands(m_commands.size() * 2);
+    for (uint64_t i = m_read; i < m_write; i++)
+    {
+        commands[i & (commands.size() - 1)] =
+            m_commands[i & (m_commands.size() - 1)];
+    }
+    m_commands.swap(commands);
+}   // grow
+
+//----------------------------------------------------------------------------
+/** Removes the oldest command from the queue. */
+void SFXManager::SFXCommandQueue::pop()
+{
+    assert(!empty());
+    m_read++;
+}   // pop
+
+//----------------------------------------------------------------------------
+void SFXManager::SFXCommandQueue::clear()
+{
+    m_read = m_write = 0;
+    // Make sure no entry refers to a queued command
+    for (uint64_t &c : m_last_command)
+        c = std::numeric_limits<uint64_t>::max();
+}   // clear
+
 //----------------------------------------------------------------------------
 /** Puts a NULL request into the queue, which will trigger the thread to
  *  exit.
@@ -363,7 +433,7 @@ void SFXManager::mainLoop(void *obj)
            // Don't spend too much time working on audio
            ++iterCount != 30 && !me->m_sfx_commands.getData().empty()
 #else
-           me->m_sfx_commands.getData().empty() || me->m_sfx_commands.getData().front()->m_command!=SFX_EXIT
+           me->m_sfx_commands.getData().empty() || me->m_sfx_commands.getData().front().m_command!=SFX_EXIT
 #endif
     )
     {
@@ -380,12 +450,11 @@ void SFXManager::mainLoop(void *obj)
             empty = me->m_sfx_commands.getData().empty();
         }
 #endif
-        SFXCommand *current = me->m_sfx_commands.getData().front();
-        me->m_sfx_commands.getData().erase(me->m_sfx_commands.getData().begin());
+        SFXCommand current = me->m_sfx_commands.getData().front();
+        me->m_sfx_commands.getData().pop();
 
-        if (current->m_command == SFX_EXIT)
+        if (current.m_command == SFX_EXIT)
         {
-            delete current;
 #ifdef __SWITCH__
             return;
 #else
@@ -396,71 +465,71 @@ void SFXManager::mainLoop(void *obj)
         ul.unlock();
         PROFILER_POP_CPU_MARKER();
         PROFILER_PUSH_CPU_MARKER("Execute", 0, 255, 0);
-        switch (current->m_command)
+        switch (current.m_command)
         {
-        case SFX_PLAY:     current->m_sfx->reallyPlayNow();       break;
+        case SFX_PLAY:     current.m_sfx->reallyPlayNow();        break;
         case SFX_PLAY_POSITION:
-            current->m_sfx->reallyPlayNow(current->m_parameter, current->m_buffer);  break;
-        case SFX_STOP:     current->m_sfx->reallyStopNow();       break;
-        case SFX_PAUSE:    current->m_sfx->reallyPauseNow();      break;
-        case SFX_RESUME:   current->m_sfx->reallyResumeNow();     break;
-        case SFX_SPEED:    current->m_sfx->reallySetSpeed(
-                                  current->m_parameter.getX());   break;
-        case SFX_POSITION: current->m_sfx->reallySetPosition(
-                                         current->m_parameter);   break;
-        case SFX_SPEED_POSITION: current->m_sfx->reallySetSpeedPosition(
+            current.m_sfx->reallyPlayNow(current.m_parameter, current.m_buffer);   break;
+        case SFX_STOP:     current.m_sfx->reallyStopNow();        break;
+        case SFX_PAUSE:    current.m_sfx->reallyPauseNow();       break;
+        case SFX_RESUME:   current.m_sfx->reallyResumeNow();      break;
+        case SFX_SPEED:    current.m_sfx->reallySetSpeed(
+                                  current.m_parameter.getX());    break;
+        case SFX_POSITION: current.m_sfx->reallySetPosition(
+                                         current.m_parameter);    break;
+        case SFX_SPEED_POSITION: current.m_sfx->reallySetSpeedPosition(
                                          // Extract float from W component
-                                         current->m_parameter.getW(),
-                                         current->m_parameter);   break;
-        case SFX_VOLUME:   current->m_sfx->reallySetVolume(
-                                  current->m_parameter.getX());   break;
+                                         current.m_parameter.getW(),
+                                         current.m_parameter);    break;
+        case SFX_VOLUME:   current.m_sfx->reallySetVolume(
+                                  current.m_parameter.getX());    break;
         case SFX_MASTER_VOLUME:
-            current->m_sfx->reallySetMasterVolumeNow(
-                                  current->m_parameter.getX());   break;
-        case SFX_LOOP:     current->m_sfx->reallySetLoop(
-                             current->m_parameter.getX() != 0);   break;
-        case SFX_DELETE:     me->deleteSFX(current->m_sfx);       break;
+            current.m_sfx->reallySetMasterVolumeNow(
+                                  current.m_parameter.getX());    break;
+        case SFX_LOOP:     current.m_sfx->reallySetLoop(
+                             current.m_parameter.getX() != 0);    break;
+        case SFX_DELETE:     me->deleteSFX(current.m_sfx);        break;
         case SFX_PAUSE_ALL:  me->reallyPauseAllNow();             break;
         case SFX_RESUME_ALL: me->reallyResumeAllNow();            break;
         case SFX_LISTENER:   me->reallyPositionListenerNow();     break;
         case SFX_UPDATE:     me->reallyUpdateNow(current);        break;
         case SFX_MUSIC_START:
         {
-            if (!current->m_music_information->preStart())
+            if (!current.m_music_information->preStart())
                 break;
-            current->m_music_information->setDefaultVolume();
-            current->m_music_information->startMusic();           break;
+            current.m_music_information->setDefaultVolume();
+            current.m_music_information->startMusic();            break;
         }
         case SFX_MUSIC_STOP:
-            current->m_music_information->stopMusic();            break;
+            current.m_music_information->stopMusic();             break;
         case SFX_MUSIC_PAUSE:
-            current->m_music_information->pauseMusic();           break;
+            current.m_music_information->pauseMusic();            break;
         case SFX_MUSIC_RESUME:
-            current->m_music_information->resumeMusic();
+            current.m_music_information->resumeMusic();
             // This might be necessasary if the volume was changed
             // in the in-game menu
-            current->m_music_information->setDefaultVolume();     break;
+            current.m_music_information->setDefaultVolume();      break;
         case SFX_MUSIC_SWITCH_FAST:
-            current->m_music_information->switchToFastMusic();    break;
+            current.m_music_information->switchToFastMusic();     break;
         case SFX_MUSIC_SET_TMP_VOLUME:
         {
-            MusicInformation *mi = current->m_music_information;
-            mi->setTemporaryVolume(current->m_parameter.getX());  break;
+            MusicInformation *mi = current.m_music_information;
+            mi->setTemporaryVolume(current.m_parameter.getX());   break;
         }
         case SFX_MUSIC_WAITING:
-               current->m_music_information->preStart();
-               current->m_music_information->setMusicWaiting();   break;
+               current.m_music_information->preStart();
+               current.m_music_information->setMusicWaiting();    break;
         case SFX_MUSIC_DEFAULT_VOLUME:
         {
-            current->m_music_information->setDefaultVolume();
+            current.m_music_information->setDefaultVolume();
             break;
         }
         case SFX_CREATE_SOURCE:
-            current->m_sfx->init(); break;
+            current.m_sfx->init(); break;
+        case SFX_PREFETCH:
+            me->reallyPrefetchNow(current.m_buffer);              break;
         default: assert("Not yet supported.");
         }
-        delete current;
-        current = NULL;
         PROFILER_POP_CPU_MARKER();
         PROFILER_PUSH_CPU_MARKER("yield", 0, 0, 255);
         if (empty_queue && me->sfxAllowed())
@@ -482,12 +551,8 @@ void SFXManager::mainLoop(void *obj)
     me->setCanBeDeleted();
 
 #ifndef __SWITCH__
-    // Clean up memory to avoid leak detection
-    while(!me->m_sfx_commands.getData().empty())
-    {
-        delete me->m_sfx_commands.getData().front();
-        me->m_sfx_commands.getData().erase(me->m_sfx_commands.getData().begin());
-    }
+    // Drop all commands queued after the exit command
+    me->m_sfx_commands.getData().clear();
 #endif // __SWITCH__
 #endif // ENABLE_SOUD
     return;
@@ -500,16 +565,9 @@ void SFXManager::mainLoop(void *obj)
  */
 void SFXManager::toggleSound(const bool on)
 {
-    // When activating SFX, load all buffers
+    // When activating SFX, buffers are loaded again when they are used
     if (on)
     {
-        std::map<std::string, SFXBuffer*>::iterator i = m_all_sfx_types.begin();
-        for (; i != m_all_sfx_types.end(); i++)
-        {
-            SFXBuffer* buffer = (*i).second;
-            buffer->load();
-        }
-
         reallyResumeAllNow();
         m_all_sfx.lock();
         const int sfx_amount = (int)m_all_sfx.getData().size();
@@ -583,25 +641,7 @@ void SFXManager::loadSfx()
     }// nend for
 
     delete root;
-
-    // Now load them in parallel
-    const int max = (int)m_all_sfx_types.size();
-    SFXBuffer **array = new SFXBuffer *[max];
-    i = 0;
-
-    for (std::map<std::string, SFXBuffer*>::iterator it = m_all_sfx_types.begin();
-         it != m_all_sfx_types.end(); it++)
-    {
-        SFXBuffer* const buffer = (*it).second;
-        array[i++] = buffer;
-    }
-
-    for (i = 0; i < max; i++)
-    {
-        array[i]->load();
-    }
-
-    delete [] array;
+    // The buffers are only decoded when they are first used
 }   // loadSfx
 
 // -----------------------------------------------------------------------------
@@ -611,8 +651,9 @@ void SFXManager::loadSfx()
  *  enumeration for each effect, for each kart.
  *  \param sfx_name
  *  \param sfxFile must be an absolute pathname
- *  \return        whether loading this sound effect was successful
-
+ *  \param load If the buffer should be prefetched by the sfx thread,
+ *         otherwise it is loaded when first used.
+ *  \return The buffer, or NULL if the sfx manager is not initialised.
 */
 SFXBuffer* SFXManager::addSingleSfx(const std::string &sfx_name,
                                     const std::string &sfx_file,
@@ -626,7 +667,9 @@ SFXBuffer* SFXManager::addSingleSfx(const std::string &sfx_name,
     SFXBuffer* buffer = new SFXBuffer(sfx_file, positional, rolloff, 
                                       max_dist, gain);
 
+    m_buffers_mutex.lock();
     m_all_sfx_types[sfx_name] = buffer;
+    m_buffers_mutex.unlock();
 
     if (!m_initialized)
     {
@@ -635,12 +678,10 @@ SFXBuffer* SFXManager::addSingleSfx(const std::string &sfx_name,
         return NULL;
     }
 
-    if (UserConfigParams::logMisc())
-        Log::debug("SFXManager", "Loading SFX %s", sfx_file.c_str());
+    if (load)
+        prefetch(buffer);
 
-    if (load && buffer->load()) return buffer;
-
-    return NULL;
+    return buffer;
 } // addSingleSFX
 
 //----------------------------------------------------------------------------
@@ -753,7 +794,10 @@ SFXBase* SFXManager::createSoundSource(const std::string &name,
 }  // createSoundSource
 
 //----------------------------------------------------------------------------
-
+/** Returns the buffer of a sfx, which is used to play it with an existing
+ *  sound source. The buffer is prefetched by the sfx thread.
+ *  \param name The internal name of the sfx.
+ */
 SFXBuffer* SFXManager::getBuffer(const std::string &name)
 {
     std::map<std::string, SFXBuffer*>::iterator i = m_all_sfx_types.find(name);
@@ -765,6 +809,8 @@ SFXBuffer* SFXManager::getBuffer(const std::string &name)
         return NULL;
     }
 
+    // The buffer will likely be played soon
+    prefetch(i->second);
     return i->second;
 }
 
@@ -793,12 +839,150 @@ void SFXManager::deleteSFXMapping(const std::string &name)
              "SFXManager::deleteSFXMapping : Warning: sfx not found in list.");
         return;
     }
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
     (*i).second->unload();
 
     m_all_sfx_types.erase(i);
 
 }   // deleteSFXMapping
 
+//----------------------------------------------------------------------------
+/** Loads a buffer if it is not loaded yet, and marks it as used by one more
+ *  sound source, so it will not be unloaded. Called when a source is created
+ *  or switches to a new buffer, each call needs a call to detachBuffer.
+ *  \param buffer The buffer used by the source.
+ *  \return If the buffer is loaded.
+ */
+bool SFXManager::attachBuffer(SFXBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    buffer->addSource();
+    return loadBuffer(buffer);
+}   // attachBuffer
+
+//----------------------------------------------------------------------------
+/** Marks a buffer as no longer used by a sound source. It stays loaded
+ *  until it is the least recently used buffer and the memory budget for sfx
+ *  is exceeded.
+ *  \param buffer The buffer which was used by the source.
+ */
+void SFXManager::detachBuffer(SFXBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    buffer->removeSource();
+    buffer->setLastUse(++m_buffer_use_counter);
+}   // detachBuffer
+
+//----------------------------------------------------------------------------
+/** Queues a buffer to be loaded by the sfx thread, e.g. a sound effect of
+ *  the track which will likely be used during the race.
+ *  \param buffer The buffer to load.
+ */
+void SFXManager::prefetch(SFXBuffer *buffer)
+{
+    if (!sfxAllowed()) return;
+    queue(SFX_PREFETCH, NULL, Vec3(0, 0, 0), buffer);
+}   // prefetch
+
+//----------------------------------------------------------------------------
+/** Loads a buffer now.
+ *  \param buffer The buffer to load.
+ */
+void SFXManager::reallyPrefetchNow(SFXBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    loadBuffer(buffer);
+}   // reallyPrefetchNow
+
+//----------------------------------------------------------------------------
+/** Loads a buffer if necessary and marks it as recently used. If this
+ *  exceeds the memory budget for sfx, unused buffers are unloaded.
+ *  The caller must hold m_buffers_mutex.
+ *  \param buffer The buffer to load.
+ *  \return If the buffer is loaded.
+ */
+bool SFXManager::loadBuffer(SFXBuffer *buffer)
+{
+    buffer->setLastUse(++m_buffer_use_counter);
+    if (buffer->isLoaded())
+        return true;
+    if (!buffer->load())
+        return false;
+
+    if (UserConfigParams::m_sfx_memory_budget > 0 &&
+        SFXBuffer::getLoadedBytes() >
+        (uint64_t)UserConfigParams::m_sfx_memory_budget * 1024 * 1024)
+    {
+        unloadUnusedBuffers(buffer);
+    }
+    return true;
+}   // loadBuffer
+
+//----------------------------------------------------------------------------
+/** Unloads the least recently used buffers which are not used by any sound
+ *  source, until the loaded buffers fit into the memory budget for sfx.
+ *  Buffers not managed by the sfx manager (owned by their sfx) are never
+ *  unloaded. The caller must hold m_buffers_mutex.
+ *  \param keep A buffer which must not be unloaded (since it was just
+ *         loaded to be used).
+ */
+void SFXManager::unloadUnusedBuffers(const SFXBuffer *keep)
+{
+    const uint64_t budget =
+        (uint64_t)UserConfigParams::m_sfx_memory_budget * 1024 * 1024;
+
+    std::vector<SFXBuffer*> unused;
+    for (auto &p : m_all_sfx_types)
+    {
+        SFXBuffer *buffer = p.second;
+        if (buffer != keep && buffer->isLoaded() &&
+            buffer->getNumSources() == 0)
+            unused.push_back(buffer);
+    }
+    std::sort(unused.begin(), unused.end(),
+              [](const SFXBuffer *a, const SFXBuffer *b)
+              {
+                  return a->getLastUse() < b->getLastUse();
+              });
+
+    for (SFXBuffer *buffer : unused)
+    {
+        if (SFXBuffer::getLoadedBytes() <= budget)
+            break;
+        if (UserConfigParams::logMisc())
+        {
+            Log::debug("SFXManager", "Unloading unused sfx %s (%u bytes).",
+                       buffer->getFileName().c_str(), buffer->getSize());
+        }
+        buffer->unload();
+    }
+}   // unloadUnusedBuffers
+
+//----------------------------------------------------------------------------
+/** Prints the list of currently loaded sounds, and statistics about the
+ *  memory used and time spent decoding them. */
+void SFXManager::dump()
+{
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    int num_loaded = 0;
+    for (auto &p : m_all_sfx_types)
+    {
+        const SFXBuffer *buffer = p.second;
+        if (!buffer->isLoaded())
+            continue;
+        num_loaded++;
+        Log::info("SFXManager", "%s: %u bytes, used by %d sources.",
+                  p.first.c_str(), buffer->getSize(),
+                  buffer->getNumSources());
+    }
+    Log::info("SFXManager", "%d of %d sfx loaded, %d KB decoded data in "
+              "total. %d sfx decoded in %dms so far.", num_loaded,
+              (int)m_all_sfx_types.size(),
+              (int)(SFXBuffer::getLoadedBytes() / 1024),
+              (int)SFXBuffer::getNumDecoded(),
+              (int)SFXBuffer::getDecodeTime());
+}   // dump
+
 //----------------------------------------------------------------------------
 /** Make sure that the sfx thread is started at least once per frame. It also
  *  adds an update command for the music manager.
@@ -825,7 +1009,7 @@ void SFXManager::update()
  *  This function is executed once per frame (triggered by the audio thread).
  *  \param current The sfx command - used to get timestep information.
 */
-void SFXManager::reallyUpdateNow(SFXCommand *current)
+void SFXManager::reallyUpdateNow(const SFXCommand &current)
 {
 #ifdef ENABLE_SOUND
     if (!UserConfigParams::m_enable_sound)
@@ -841,7 +1025,7 @@ void SFXManager::reallyUpdateNow(SFXCommand *current)
     m_last_update_time = StkTime::getMonoTimeMs();
     float dt = float(m_last_update_time - previous_update_time) / 1000.0f;
 
-    assert(current->m_command==SFX_UPDATE);
+    assert(current.m_command==SFX_UPDATE);
     if (music_manager->getCurrentMusic())
         music_manager->getCurrentMusic()->update(dt);
     m_all_sfx.lock();
@@ -946,7 +1130,7 @@ void SFXManager::reallyResumeAllNow()
         // Some buffer not added to m_all_sfx_types need to be loaded here
         // For example sound for entering challenge house in overworld
         if ((*i)->getBuffer())
-            (*i)->getBuffer()->load();
+            reallyPrefetchNow((*i)->getBuffer());
         (*i)->reallyResumeNow();
     }   // for i in m_all_sfx
     m_all_sfx.unlock();
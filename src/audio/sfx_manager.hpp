@@ -27,6 +27,7 @@
 
 #include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -88,7 +89,8 @@ public:
         SFX_MUSIC_WAITING,
         SFX_MUSIC_DEFAULT_VOLUME,
         SFX_EXIT,
-        SFX_CREATE_SOURCE
+        SFX_CREATE_SOURCE,
+        SFX_PREFETCH
     };   // SFXCommands
 
     /**
@@ -113,17 +115,16 @@ public:
 private:
 
     /** Data structure for the queue, which stores a sfx and the command to 
-     *  execute for it. */
-    class SFXCommand : public NoCopy
+     *  execute for it. It is stored by value in the command queue, so it
+     *  must remain a small, trivially copyable object. */
+    class SFXCommand
     {
-    private:
-        LEAK_CHECK()
     public:
         /** The sound effect for which the command should be executed. */
         SFXBase *m_sfx;
 
         /** The sound buffer to play (null = no change) */
-        SFXBuffer *m_buffer = NULL;
+        SFXBuffer *m_buffer;
 
         /** Stores music information for music commands. */
         MusicInformation *m_music_information;
@@ -134,16 +135,28 @@ private:
          *  floating point values are stored in the X component. */
         Vec3        m_parameter;
         // --------------------------------------------------------------------
-        SFXCommand(SFXCommands command, SFXBase *base)
+        SFXCommand()
         {
-            m_command   = command;
-            m_sfx       = base;
+            m_command           = SFX_EXIT;
+            m_sfx               = NULL;
+            m_buffer            = NULL;
+            m_music_information = NULL;
         }   // SFXCommand()
         // --------------------------------------------------------------------
+        SFXCommand(SFXCommands command, SFXBase *base)
+        {
+            m_command           = command;
+            m_sfx               = base;
+            m_buffer            = NULL;
+            m_music_information = NULL;
+        }   // SFXCommand(SFXBase*)
+        // --------------------------------------------------------------------
         /** Constructor for music information commands. */
         SFXCommand(SFXCommands command, MusicInformation *mi)
         {
             m_command           = command;
+            m_sfx               = NULL;
+            m_buffer            = NULL;
             m_music_information = mi;
         }   // SFXCommnd(MusicInformation*)
         // --------------------------------------------------------------------
@@ -151,23 +164,29 @@ private:
          *  point parameter (which is stored in the X value of m_parameter). */
         SFXCommand(SFXCommands command, MusicInformation *mi, float f)
         {
-            m_command = command;
-            m_parameter.setX(f);
+            m_command           = command;
+            m_sfx               = NULL;
+            m_buffer            = NULL;
             m_music_information = mi;
+            m_parameter.setX(f);
         }   // SFXCommnd(MusicInformation *, float)
         // --------------------------------------------------------------------
         SFXCommand(SFXCommands command, SFXBase *base, float parameter)
         {
-            m_command   = command;
-            m_sfx       = base;
+            m_command           = command;
+            m_sfx               = base;
+            m_buffer            = NULL;
+            m_music_information = NULL;
             m_parameter.setX(parameter);
         }   // SFXCommand(float)
         // --------------------------------------------------------------------
         SFXCommand(SFXCommands command, SFXBase *base, const Vec3 &parameter)
         {
-            m_command   = command;
-            m_sfx       = base;
-            m_parameter = parameter;
+            m_command           = command;
+            m_sfx               = base;
+            m_buffer            = NULL;
+            m_music_information = NULL;
+            m_parameter         = parameter;
         }   // SFXCommand(Vec3)
         // --------------------------------------------------------------------
         /** Store a float and vec3 parameter. The float is stored as W
@@ -176,13 +195,57 @@ private:
         SFXCommand(SFXCommands command, SFXBase *base, float f,
                    const Vec3 &parameter)
         {
-            m_command   = command;
-            m_sfx       = base;
-            m_parameter = parameter;
+            m_command           = command;
+            m_sfx               = base;
+            m_buffer            = NULL;
+            m_music_information = NULL;
+            m_parameter         = parameter;
             m_parameter.setW(f);
         }   // SFXCommand(Vec3)
     };   // SFXCommand
     // ========================================================================
+    /** A ring buffer of commands, so that queueing a command neither
+     *  allocates memory nor needs to move the other queued commands.
+     *  An update of a sfx (position, speed, volume) replaces the previous
+     *  update of the same kind if that is still the last queued command
+     *  of that sfx, so e.g. the engine sounds of the karts do not fill
+     *  the queue if the sfx thread falls behind.
+     *  The queue is not thread safe, it is protected by the lock of the
+     *  Synchronised object it is stored in. */
+    class SFXCommandQueue : public NoCopy
+    {
+    private:
+        /** The commands, the size is always a power of 2. */
+        std::vector<SFXCommand> m_commands;
+
+        /** Total number of commands taken from / added to the queue. The
+         *  index of a command in m_commands is this modulo the size. */
+        uint64_t m_read, m_write;
+
+        /** A small hash table from sfx to the number of its last queued
+         *  command. A collision only prevents merging of an update. */
+        uint64_t m_last_command[256];
+
+        unsigned getHashIndex(const SFXBase *sfx) const;
+        void     grow();
+    public:
+                 SFXCommandQueue();
+        bool     push(const SFXCommand &command);
+        void     pop();
+        void     clear();
+        // --------------------------------------------------------------------
+        /** Returns the oldest command in the queue. */
+        const SFXCommand& front() const
+        {
+            assert(!empty());
+            return m_commands[m_read & (m_commands.size() - 1)];
+        }   // front
+        // --------------------------------------------------------------------
+        bool     empty() const                   { return m_read == m_write; }
+        // --------------------------------------------------------------------
+        size_t   size() const           { return (size_t)(m_write - m_read); }
+    };   // SFXCommandQueue
+    // ========================================================================
 
     /** The position of the listener. Its lock will be used to
      *  access m_listener_{position,front, up}. */
@@ -196,14 +259,24 @@ private:
 
 
     /** The buffers and info for all sound effects. These are shared among all
-     *  instances of SFXOpenal. */
+     *  instances of SFXOpenal. Buffers are only loaded when they are used
+     *  or prefetched, and changes to the map need m_buffers_mutex, since
+     *  unused buffers are unloaded by the sfx thread. */
     std::map<std::string, SFXBuffer*> m_all_sfx_types;
 
+    /** Protects loading and unloading of buffers, the number of sources
+     *  using them, and changes to m_all_sfx_types. */
+    std::mutex                m_buffers_mutex;
+
+    /** Incremented each time a buffer is used, to find the least recently
+     *  used buffers. */
+    uint64_t                  m_buffer_use_counter;
+
     /** The actual instances (sound sources) */
     Synchronised<std::vector<SFXBase*> > m_all_sfx;
 
     /** The list of sound effects to be played in the next update. */
-    Synchronised< std::vector<SFXCommand*> > m_sfx_commands;
+    Synchronised<SFXCommandQueue> m_sfx_commands;
 
     /** To play non-positional sounds without having to create a
      *  new object for each. */
@@ -231,8 +304,10 @@ private:
 
     static void mainLoop(void *obj);
     void deleteSFX(SFXBase *sfx);
-    void queueCommand(SFXCommand *command);
+    void queueCommand(const SFXCommand &command);
     void reallyPositionListenerNow();
+    bool loadBuffer(SFXBuffer *buffer);
+    void unloadUnusedBuffers(const SFXBuffer *keep);
 
 public:
     static void create();
@@ -272,13 +347,17 @@ public:
     SFXBase*                 createSoundSource(const std::string &name,
                                                const bool addToSFXList=true);
 
+    bool                     attachBuffer(SFXBuffer *buffer);
+    void                     detachBuffer(SFXBuffer *buffer);
+    void                     prefetch(SFXBuffer *buffer);
+    void                     reallyPrefetchNow(SFXBuffer *buffer);
     void                     deleteSFXMapping(const std::string &name);
     void                     pauseAll();
     void                     reallyPauseAllNow();
     void                     resumeAll();
     void                     reallyResumeAllNow();
     void                     update();
-    void                     reallyUpdateNow(SFXCommand *current);
+    void                     reallyUpdateNow(const SFXCommand &current);
     bool                     soundExist(const std::string &name);
     void                     setMasterSFXVolume(float gain);
     float                    getMasterSFXVolume() const { return m_master_gain; }
@@ -45,6 +45,7 @@ SFXOpenAL::SFXOpenAL(SFXBuffer* buffer, bool positional, float volume,
     m_gain         = -1.0f;
     m_master_gain  = 1.0f;
     m_owns_buffer  = owns_buffer;
+    m_buffer_attached = false;
     m_play_time    = 0.0f;
 
     // Don't initialise anything else if the sfx manager was not correctly
@@ -66,6 +67,8 @@ SFXOpenAL::~SFXOpenAL()
         alDeleteSources(1, &m_sound_source);
         SFXManager::checkError("deleting a source");
     }
+    if (m_buffer_attached)
+        SFXManager::get()->detachBuffer(m_sound_buffer);
 
     if (m_owns_buffer && m_sound_buffer)
     {
@@ -75,12 +78,18 @@ SFXOpenAL::~SFXOpenAL()
 }   // ~SFXOpenAL
 
 //-----------------------------------------------------------------------------
-/** Initialises the sfx. 
+/** Initialises the sfx, and loads its buffer if it is not loaded yet.
  */
 bool SFXOpenAL::init()
 {
     m_status = SFX_UNKNOWN;
 
+    if (m_buffer_attached)
+        SFXManager::get()->detachBuffer(m_sound_buffer);
+    m_buffer_attached = true;
+    if (!SFXManager::get()->attachBuffer(m_sound_buffer))
+        return false;
+
     alGenSources(1, &m_sound_source );
     if (!SFXManager::checkError("generating a source"))
         return false;
@@ -376,7 +385,12 @@ void SFXOpenAL::reallyPlayNow(SFXBuffer* buffer)
         if (m_status == SFX_PLAYING || m_status == SFX_PAUSED)
             reallyStopNow();
 
+        if (m_buffer_attached)
+            SFXManager::get()->detachBuffer(m_sound_buffer);
         m_sound_buffer = buffer;
+        m_buffer_attached = true;
+        if (!SFXManager::get()->attachBuffer(m_sound_buffer))
+            return;
         alSourcei(m_sound_source, AL_BUFFER, m_sound_buffer->getBufferID());
 
         if (!SFXManager::checkError("attaching the buffer to the source"))
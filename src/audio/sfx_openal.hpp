@@ -70,6 +70,10 @@ private:
     /** If this sfx should also free the sound buffer. */
     bool m_owns_buffer;
 
+    /** If this sfx was counted as a user of its buffer by the sfx manager,
+     *  which happens when the source is initialised. */
+    bool m_buffer_attached;
+
     /** How long the sfx has been playing. */
     float m_play_time;
 
@@ -433,6 +433,13 @@ namespace UserConfigParams
                             &m_audio_group,
                             "Number of steps for volume adjustment") );
 
+    PARAM_PREFIX IntUserConfigParam          m_sfx_memory_budget
+            PARAM_DEFAULT(  IntUserConfigParam(0, "sfx_memory_budget",
+                            &m_audio_group,
+                            "Maximum size in MB of decoded sound effects, "
+                            "unused ones are unloaded above it. 0 for no "
+                            "limit") );
+
     // ---- Race setup
     PARAM_PREFIX GroupUserConfigParam        m_race_setup_group
         PARAM_DEFAULT( GroupUserConfigParam("RaceSetup",
@@ -811,6 +818,14 @@ namespace UserConfigParams
     /** True if physics debugging should be enabled. */
     PARAM_PREFIX bool m_physics_debug PARAM_DEFAULT( false );
 
+    /** True if downward raycasts against the track should use the terrain
+     *  grid where possible. */
+    PARAM_PREFIX bool m_terrain_grid PARAM_DEFAULT( true );
+
+    /** True if the terrain grid should be compared with raycasts when a
+     *  track is loaded. */
+    PARAM_PREFIX bool m_check_terrain_grid PARAM_DEFAULT( false );
+
     /** True if FPS should be printed each frame. */
     PARAM_PREFIX bool m_fps_debug PARAM_DEFAULT(false);
 
@@ -1310,6 +1325,12 @@ namespace UserConfigParams
                                                "wasn't asked, 1: allowed, 2: "
                                                "not allowed") );
 
+    PARAM_PREFIX IntUserConfigParam        m_max_concurrent_requests
+            PARAM_DEFAULT(  IntUserConfigParam(4, "max_concurrent_requests",
+                                               "Maximum number of http "
+                                               "requests executed at the "
+                                               "same time.") );
+
     PARAM_PREFIX GroupUserConfigParam       m_hw_report_group
             PARAM_DEFAULT( GroupUserConfigParam("HWReport",
                                           "Everything related to hardware configuration.") );
@@ -25,8 +25,8 @@
 #include "font/regular_face.hpp"
 #include "guiengine/engine.hpp"
 #include "guiengine/skin.hpp"
-#include "states_screens/state_manager.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/time.hpp"
 #include "utils/translation.hpp"
 
 #ifndef SERVER_ONLY
@@ -38,6 +38,12 @@ extern "C"
 #endif
 
 FontManager *font_manager = NULL;
+
+#ifndef SERVER_ONLY
+/** Memory budget of the glyph layouts cache in bytes. */
+static const size_t MAX_CACHED_LAYOUTS_SIZE = 4 * 1024 * 1024;
+#endif
+
 // ----------------------------------------------------------------------------
 /** Constructor. It will initialize the \ref m_ft_library.
  */
@@ -49,6 +55,9 @@ FontManager::FontManager()
     m_digit_face = NULL;
     m_shaping_dpi = 128;
     m_hb_buffer = NULL;
+    m_cached_gls_size = 0;
+    m_cached_gls_hits = 0;
+    m_cached_gls_misses = 0;
     if (GUIEngine::isNoGraphics())
         return;
 
@@ -697,22 +706,90 @@ void FontManager::shape(const std::u32string& text,
 }   // shape
 
 // ----------------------------------------------------------------------------
-/* Return the cached glyph layouts for writing, it will clear all layouts if
- * not in-game and when the cached sized exceed a certain number. */
-std::vector<irr::gui::GlyphLayout>&
-                   FontManager::getCachedLayouts(const irr::core::stringw& str)
+/** Returns the approximate memory used by the glyph layouts of a text, used
+ *  to keep the layouts cache within its budget.
+ */
+static size_t getLayoutsSize(const core::stringw& str,
+                             const std::vector<gui::GlyphLayout>& gls)
 {
-    const size_t MAX_LAYOUTS = 600;
-    if (StateManager::get()->getGameState() != GUIEngine::GAME &&
-        m_cached_gls.size() > MAX_LAYOUTS)
+    size_t size = (str.size() + 1) * sizeof(wchar_t) +
+        gls.capacity() * sizeof(gui::GlyphLayout);
+    const std::u32string* orig_string = NULL;
+    for (const gui::GlyphLayout& gl : gls)
     {
-        Log::debug("FontManager",
-            "Clearing cached glyph layouts because too many.");
-        clearCachedLayouts();
+        size += gl.cluster.capacity() * sizeof(s32) +
+            gl.draw_flags.capacity() * sizeof(u8);
+        // The original string is shared by all glyphs of a line
+        if (gl.orig_string && gl.orig_string.get() != orig_string)
+        {
+            orig_string = gl.orig_string.get();
+            size += (orig_string->size() + 1) * sizeof(char32_t);
+        }
     }
-    return m_cached_gls[str];
+    return size;
+}   // getLayoutsSize
+
+// ----------------------------------------------------------------------------
+/** Return the cached glyph layouts of a text, shaping it first if it is not
+ *  in the cache yet. Least recently used layouts are removed when the cache
+ *  exceeds its memory budget, the returned layouts stay valid until the next
+ *  call which adds a layout or \ref clearCachedLayouts.
+ *  \param str The text to get layouts.
+ *  \param shape_flag Flags used when the text has to be shaped.
+ */
+const std::vector<irr::gui::GlyphLayout>&
+    FontManager::getCachedLayouts(const irr::core::stringw& str,
+                                  u32 shape_flag)
+{
+    auto it = m_cached_gls.find(str);
+    if (it != m_cached_gls.end())
+    {
+        m_cached_gls_hits++;
+        m_cached_gls_lru.splice(m_cached_gls_lru.begin(), m_cached_gls_lru,
+            it->second.m_lru);
+        return it->second.m_gls;
+    }
+
+    m_cached_gls_misses++;
+    it = m_cached_gls.emplace(str, CachedLayouts()).first;
+    CachedLayouts& cl = it->second;
+    if (!str.empty())
+        shape(StringUtils::wideToUtf32(str), cl.m_gls, shape_flag);
+    cl.m_size = getLayoutsSize(str, cl.m_gls);
+    m_cached_gls_lru.push_front(&it->first);
+    cl.m_lru = m_cached_gls_lru.begin();
+    m_cached_gls_size += cl.m_size;
+
+    // Never remove the layouts which are about to be returned
+    while (m_cached_gls_size > MAX_CACHED_LAYOUTS_SIZE &&
+        m_cached_gls_lru.size() > 1)
+    {
+        auto oldest = m_cached_gls.find(*m_cached_gls_lru.back());
+        assert(oldest != m_cached_gls.end());
+        m_cached_gls_size -= oldest->second.m_size;
+        m_cached_gls_lru.pop_back();
+        m_cached_gls.erase(oldest);
+    }
+    return cl.m_gls;
 }   // getCachedLayouts
 
+// ----------------------------------------------------------------------------
+/** Removes all cached glyph layouts, used when the language or fonts are
+ *  changed.
+ */
+void FontManager::clearCachedLayouts()
+{
+    Log::debug("FontManager", "Clearing %d cached glyph layouts (%d kB), "
+        "%u hits and %u misses.", (int)m_cached_gls.size(),
+        (int)(m_cached_gls_size / 1024), m_cached_gls_hits,
+        m_cached_gls_misses);
+    m_cached_gls.clear();
+    m_cached_gls_lru.clear();
+    m_cached_gls_size = 0;
+    m_cached_gls_hits = 0;
+    m_cached_gls_misses = 0;
+}   // clearCachedLayouts
+
 // ----------------------------------------------------------------------------
 /** Convert text to glyph layouts for fast rendering with (optional) caching
  *  enabled.
@@ -730,10 +807,7 @@ void FontManager::initGlyphLayouts(const core::stringw& text,
         return;
     }
 
-    auto& cached_gls = getCachedLayouts(text);
-    if (cached_gls.empty())
-        shape(StringUtils::wideToUtf32(text), cached_gls, shape_flag);
-    gls = cached_gls;
+    gls = getCachedLayouts(text, shape_flag);
 }   // initGlyphLayouts
 
 // ----------------------------------------------------------------------------
@@ -897,7 +971,8 @@ void FontManager::loadFonts()
 // ----------------------------------------------------------------------------
 /** Unit testing that will try to load all translations in STK, and discover if
  *  there is any characters required by it are not supported in \ref
- *  m_normal_ttf.
+ *  m_normal_ttf. It also shapes all translated strings of each language
+ *  twice to measure the glyph layouts cache.
  */
 void FontManager::unitTesting()
 {
@@ -943,6 +1018,33 @@ void FontManager::unitTesting()
                     lang.c_str());
             }
         }
+
+        if (GUIEngine::isNoGraphics())
+            continue;
+        std::vector<core::stringw> strings;
+        for (const std::string& s : translations->getCurrentAllStrings())
+            strings.push_back(StringUtils::utf8ToWide(s));
+        clearCachedLayouts();
+        uint64_t start = StkTime::getMonoTimeMs();
+        for (const core::stringw& s : strings)
+            getCachedLayouts(s);
+        uint64_t shaped = StkTime::getMonoTimeMs();
+        const unsigned misses = m_cached_gls_misses;
+        const bool evicted = m_cached_gls.size() != misses;
+        for (const core::stringw& s : strings)
+            getCachedLayouts(s);
+        uint64_t cached = StkTime::getMonoTimeMs();
+        assert(m_cached_gls_size <= MAX_CACHED_LAYOUTS_SIZE ||
+            m_cached_gls.size() == 1);
+        // Nothing was removed from the cache, so the second pass must
+        // only have hits
+        assert(evicted || m_cached_gls_misses == misses);
+        Log::info("UnitTest", "Language %s: shaped %d strings in %dms, "
+            "cached in %dms, %d layouts using %d kB%s.", lang.c_str(),
+            (int)strings.size(), (int)(shaped - start),
+            (int)(cached - shaped), (int)m_cached_gls.size(),
+            (int)(m_cached_gls_size / 1024), evicted ? " (evicted)" : "");
     }
+    clearCachedLayouts();
 #endif
 }   // unitTesting
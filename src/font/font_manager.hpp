@@ -28,6 +28,7 @@
 #include "utils/no_copy.hpp"
 
 #include <string>
+#include <list>
 #include <map>
 #include <typeindex>
 #include <unordered_map>
@@ -71,9 +72,47 @@ private:
     /** Map FT_Face to index for quicker layout. */
     std::map<FT_Face, uint16_t> m_ft_faces_to_index;
 
+    /** FNV-1a hash of a text, used to look up \ref m_cached_gls. */
+    struct StringHash
+    {
+        size_t operator()(const irr::core::stringw& str) const
+        {
+            uint32_t hash = 2166136261u;
+            for (unsigned i = 0; i < str.size(); i++)
+            {
+                hash ^= (uint32_t)str[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    };
+
+    /** Glyph layouts of a text in \ref m_cached_gls. */
+    struct CachedLayouts
+    {
+        /** The shaped text. */
+        std::vector<irr::gui::GlyphLayout> m_gls;
+        /** Approximate memory used by this entry in bytes. */
+        size_t m_size;
+        /** Position of this entry in \ref m_cached_gls_lru. */
+        std::list<const irr::core::stringw*>::iterator m_lru;
+    };
+
     /** Text drawn to glyph layouts cache. */
-    std::map<irr::core::stringw,
-        std::vector<irr::gui::GlyphLayout> > m_cached_gls;
+    std::unordered_map<irr::core::stringw, CachedLayouts, StringHash>
+                                             m_cached_gls;
+
+    /** Keys of \ref m_cached_gls, most recently used first. The least
+     *  recently used layouts are removed once \ref m_cached_gls_size goes
+     *  above the budget. */
+    std::list<const irr::core::stringw*>    m_cached_gls_lru;
+
+    /** Sum of the size of all cached layouts in bytes. */
+    size_t                                   m_cached_gls_size;
+
+    /** Statistics of the layout cache. */
+    unsigned                                 m_cached_gls_hits;
+    unsigned                                 m_cached_gls_misses;
 
     bool m_has_color_emoji;
     // ------------------------------------------------------------------------
@@ -135,10 +174,13 @@ public:
                std::vector<irr::gui::GlyphLayout>& gls,
                irr::u32 shape_flag = 0);
     // ------------------------------------------------------------------------
-    std::vector<irr::gui::GlyphLayout>& getCachedLayouts
-                  (const irr::core::stringw& str);
+    const std::vector<irr::gui::GlyphLayout>& getCachedLayouts
+                  (const irr::core::stringw& str, irr::u32 shape_flag = 0);
+    // ------------------------------------------------------------------------
+    void clearCachedLayouts();
     // ------------------------------------------------------------------------
-    void clearCachedLayouts()                         { m_cached_gls.clear(); }
+    /** Returns the memory used by the glyph layouts cache in bytes. */
+    size_t getCachedLayoutsSize() const           { return m_cached_gls_size; }
     // ------------------------------------------------------------------------
     void initGlyphLayouts(const irr::core::stringw& text,
                           std::vector<irr::gui::GlyphLayout>& gls,
@@ -123,7 +123,7 @@ void FontWithFace::init()
 void FontWithFace::reset()
 {
     m_new_char_holder.clear();
-    m_character_glyph_info_map.clear();
+    m_glyph_info.clear();
     for (unsigned int i = 0; i < m_spritebank->getTextureCount(); i++)
     {
         STKTexManager::getInstance()->removeTexture(
@@ -150,7 +150,7 @@ void FontWithFace::loadGlyphInfo(wchar_t c)
     unsigned int font_number = 0;
     unsigned int glyph_index = 0;
     m_face_ttf->getFontAndGlyphFromChar(c, &font_number, &glyph_index);
-    m_character_glyph_info_map[c] = GlyphInfo(font_number, glyph_index);
+    m_glyph_info.set(c, GlyphInfo(font_number, glyph_index));
 #endif
 }   // loadGlyphInfo
 
@@ -435,11 +435,10 @@ const FontArea* FontWithFace::getUnknownFontArea() const
     static FontArea area;
     return &area;
 #else
-    std::map<wchar_t, GlyphInfo>::const_iterator n =
-        m_character_glyph_info_map.find(L'?');
-    assert(n != m_character_glyph_info_map.end());
-    const FontArea* area = m_face_ttf->getFontArea(n->second.font_number,
-        n->second.glyph_index);
+    const GlyphInfo* info = m_glyph_info.find(L'?');
+    assert(info != NULL);
+    const FontArea* area = m_face_ttf->getFontArea(info->font_number,
+        info->glyph_index);
     assert(area != NULL);
     return area;
 #endif
@@ -453,15 +452,14 @@ const FontArea* FontWithFace::getUnknownFontArea() const
 const FontArea& FontWithFace::getAreaFromCharacter(const wchar_t c,
                                                    bool* fallback_font) const
 {
-    std::map<wchar_t, GlyphInfo>::const_iterator n =
-        m_character_glyph_info_map.find(c);
+    const GlyphInfo* info = m_glyph_info.find(c);
     // Not found, return the first font area, which is a white-space
-    if (n == m_character_glyph_info_map.end())
+    if (info == NULL)
         return *getUnknownFontArea();
 
 #ifndef SERVER_ONLY
-    const FontArea* area = m_face_ttf->getFontArea(n->second.font_number,
-        n->second.glyph_index);
+    const FontArea* area = m_face_ttf->getFontArea(info->font_number,
+        info->glyph_index);
     if (area != NULL)
     {
         if (fallback_font != NULL)
@@ -506,9 +504,7 @@ core::dimension2d<u32> FontWithFace::getDimension(const core::stringw& text,
             m_font_max_height * scale, 1.0f/*inverse shaping*/, scale);
     }
 
-    auto& gls = font_manager->getCachedLayouts(text);
-    if (gls.empty() && !text.empty())
-        font_manager->shape(StringUtils::wideToUtf32(text), gls);
+    const auto& gls = font_manager->getCachedLayouts(text);
 
     return gui::getGlyphLayoutsDimension(gls,
         m_font_max_height * scale, m_inverse_shaping, scale);
@@ -974,9 +970,7 @@ void FontWithFace::drawText(const core::stringw& text,
         return;
     }
 
-    auto& gls = font_manager->getCachedLayouts(text);
-    if (gls.empty() && !text.empty())
-        font_manager->shape(StringUtils::wideToUtf32(text), gls);
+    const auto& gls = font_manager->getCachedLayouts(text);
 
     render(gls, position, color, hcenter, vcenter, clip,
         font_settings, char_collector);
@@ -1022,27 +1016,27 @@ std::vector<gui::GlyphLayout> FontWithFace::
             layouts.push_back(gl);
             continue;
         }
-        auto ret = m_character_glyph_info_map.find(c);
-        if (ret == m_character_glyph_info_map.end())
+        const GlyphInfo* info = m_glyph_info.find(c);
+        if (info == NULL)
         {
             unsigned font = 0;
             unsigned glyph = 0;
             if (!m_face_ttf->getFontAndGlyphFromChar(c, &font, &glyph))
             {
-                m_character_glyph_info_map[c] = GlyphInfo(font, glyph);
+                m_glyph_info.set(c, GlyphInfo(font, glyph));
                 continue;
             }
-            m_character_glyph_info_map[c] = GlyphInfo(font, glyph);
-            ret = m_character_glyph_info_map.find(c);
+            m_glyph_info.set(c, GlyphInfo(font, glyph));
+            info = m_glyph_info.find(c);
             insertGlyph(font, glyph);
         }
         const FontArea* area = m_face_ttf->getFontArea
-            (ret->second.font_number, ret->second.glyph_index);
+            (info->font_number, info->glyph_index);
         if (area == NULL)
             continue;
-        gl.index = ret->second.glyph_index;
+        gl.index = info->glyph_index;
         gl.x_advance = area->advance_x;
-        gl.face_idx = ret->second.font_number;
+        gl.face_idx = info->font_number;
         gl.flags = gui::GLF_QUICK_DRAW;
         layouts.push_back(gl);
     }
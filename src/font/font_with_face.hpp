@@ -28,6 +28,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #ifndef SERVER_ONLY
 #include <ft2build.h>
@@ -149,6 +151,64 @@ private:
         unsigned int glyph_index;
     };
 
+    /** Stores the \ref GlyphInfo of each tested character. Characters below
+     *  \ref FLAT_SIZE, which covers the alphabetic scripts used by most
+     *  translations, are looked up directly in an array, others (like CJK)
+     *  are hashed. */
+    class GlyphInfoTable
+    {
+    private:
+        static const unsigned FLAT_SIZE = 0x1000;
+
+        /** Directly indexed by character, allocated on first use. */
+        std::vector<GlyphInfo> m_flat;
+
+        /** True if the character at the same index in \ref m_flat has been
+         *  tested. */
+        std::vector<bool> m_flat_loaded;
+
+        /** Characters above \ref FLAT_SIZE. */
+        std::unordered_map<wchar_t, GlyphInfo> m_others;
+    public:
+        // --------------------------------------------------------------------
+        /** Returns the \ref GlyphInfo of a character, or NULL if it has not
+         *  been tested yet. */
+        const GlyphInfo* find(wchar_t c) const
+        {
+            if ((unsigned)c < FLAT_SIZE)
+            {
+                if (m_flat.empty() || !m_flat_loaded[c])
+                    return NULL;
+                return &m_flat[c];
+            }
+            auto it = m_others.find(c);
+            return it == m_others.end() ? NULL : &it->second;
+        }   // find
+        // --------------------------------------------------------------------
+        void set(wchar_t c, const GlyphInfo& info)
+        {
+            if ((unsigned)c < FLAT_SIZE)
+            {
+                if (m_flat.empty())
+                {
+                    m_flat.resize(FLAT_SIZE);
+                    m_flat_loaded.resize(FLAT_SIZE, false);
+                }
+                m_flat[c] = info;
+                m_flat_loaded[c] = true;
+                return;
+            }
+            m_others[c] = info;
+        }   // set
+        // --------------------------------------------------------------------
+        void clear()
+        {
+            m_flat.clear();
+            m_flat_loaded.clear();
+            m_others.clear();
+        }   // clear
+    };   // GlyphInfoTable
+
     /** \ref FaceTTF to load glyph from. */
     FaceTTF*                     m_face_ttf;
 
@@ -180,7 +240,7 @@ private:
      *  width. */
     float                        m_inverse_shaping;
     /** Store a list of loaded and tested character to a \ref GlyphInfo. */
-    std::map<wchar_t, GlyphInfo> m_character_glyph_info_map;
+    GlyphInfoTable               m_glyph_info;
 
     // ------------------------------------------------------------------------
     float getCharWidth(const FontArea& area, bool fallback, float scale) const;
@@ -190,24 +250,18 @@ private:
      *  \return True if tested. */
     bool loadedChar(wchar_t c) const
     {
-        std::map<wchar_t, GlyphInfo>::const_iterator n =
-            m_character_glyph_info_map.find(c);
-        if (n != m_character_glyph_info_map.end())
-            return true;
-        return false;
+        return m_glyph_info.find(c) != NULL;
     }
     // ------------------------------------------------------------------------
-    /** Get the \ref GlyphInfo from \ref m_character_glyph_info_map about a
-     *  character.
+    /** Get the \ref GlyphInfo from \ref m_glyph_info about a character.
      *  \param c Character to get.
      *  \return \ref GlyphInfo of this character. */
     const GlyphInfo& getGlyphInfo(wchar_t c) const
     {
-        std::map<wchar_t, GlyphInfo>::const_iterator n =
-            m_character_glyph_info_map.find(c);
+        const GlyphInfo* info = m_glyph_info.find(c);
         // Make sure we always find GlyphInfo
-        assert(n != m_character_glyph_info_map.end());
-        return n->second;
+        assert(info != NULL);
+        return *info;
     }
     // ------------------------------------------------------------------------
     /** Tells whether a character is supported by all TTFs in \ref m_face_ttf
@@ -216,13 +270,8 @@ private:
      *  \return True if it's supported. */
     bool supportChar(wchar_t c)
     {
-        std::map<wchar_t, GlyphInfo>::const_iterator n =
-            m_character_glyph_info_map.find(c);
-        if (n != m_character_glyph_info_map.end())
-        {
-            return n->second.glyph_index > 0;
-        }
-        return false;
+        const GlyphInfo* info = m_glyph_info.find(c);
+        return info != NULL && info->glyph_index > 0;
     }
     // ------------------------------------------------------------------------
     void loadGlyphInfo(wchar_t c);
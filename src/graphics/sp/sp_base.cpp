@@ -111,6 +111,12 @@ std::vector<std::shared_ptr<SPDynamicDrawCall> > g_dy_dc;
 // ----------------------------------------------------------------------------
 float g_frustums[5][24] = { { } };
 // ----------------------------------------------------------------------------
+// Mesh buffer bounding boxes of a node in structure of arrays layout, culled
+// against all frustums at once
+std::array<std::vector<float>, 6> g_culling_boxes;
+// ----------------------------------------------------------------------------
+std::vector<uint8_t> g_culling_result;
+// ----------------------------------------------------------------------------
 unsigned sp_solid_poly_count = 0;
 // ----------------------------------------------------------------------------
 unsigned sp_shadow_poly_count = 0;
@@ -751,8 +757,35 @@ void addObject(SPMeshNode* node)
     }
 
     const core::matrix4& model_matrix = node->getAbsoluteTransformation();
+    const unsigned mb_count = node->getSPM()->getMeshBufferCount();
+    for (std::vector<float>& v : g_culling_boxes)
+    {
+        v.clear();
+    }
+    for (unsigned m = 0; m < mb_count; m++)
+    {
+        core::aabbox3df bb = node->getSPM()->getSPMeshBuffer(m)
+            ->getBoundingBox();
+        model_matrix.transformBoxEx(bb);
+        g_culling_boxes[0].push_back(bb.MinEdge.X);
+        g_culling_boxes[1].push_back(bb.MinEdge.Y);
+        g_culling_boxes[2].push_back(bb.MinEdge.Z);
+        g_culling_boxes[3].push_back(bb.MaxEdge.X);
+        g_culling_boxes[4].push_back(bb.MaxEdge.Y);
+        g_culling_boxes[5].push_back(bb.MaxEdge.Z);
+    }
+    const float* boxes[6] =
+    {
+        g_culling_boxes[0].data(), g_culling_boxes[1].data(),
+        g_culling_boxes[2].data(), g_culling_boxes[3].data(),
+        g_culling_boxes[4].data(), g_culling_boxes[5].data()
+    };
+    g_culling_result.resize(mb_count);
+    GE::mathCullBoxes(g_culling_result.data(), boxes, mb_count,
+        &g_frustums[0][0], g_handle_shadow ? 5 : 1);
+
     bool added_for_skinning = false;
-    for (unsigned m = 0; m < node->getSPM()->getMeshBufferCount(); m++)
+    for (unsigned m = 0; m < mb_count; m++)
     {
         SPMeshBuffer* mb = node->getSPM()->getSPMeshBuffer(m);
         SPShader* shader = node->getShader(m);
@@ -760,41 +793,12 @@ void addObject(SPMeshNode* node)
         {
             continue;
         }
-        core::aabbox3df bb = mb->getBoundingBox();
-        model_matrix.transformBoxEx(bb);
-        std::vector<bool> discard;
+        const core::aabbox3df bb(boxes[0][m], boxes[1][m], boxes[2][m],
+            boxes[3][m], boxes[4][m], boxes[5][m]);
         const bool handle_shadow = node->isInShadowPass() &&
             g_handle_shadow && shader->hasShader(RP_SHADOW);
-        discard.resize((handle_shadow ? 5 : 1), false);
-
-        for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
-        {
-            for (int i = 0; i < 24; i += 4)
-            {
-                bool outside = true;
-                for (int j = 0; j < 8; j++)
-                {
-                    const float dist =
-                        getCorner(bb, j).X * g_frustums[dc_type][i] +
-                        getCorner(bb, j).Y * g_frustums[dc_type][i + 1] +
-                        getCorner(bb, j).Z * g_frustums[dc_type][i + 2] +
-                        g_frustums[dc_type][i + 3];
-                    outside = outside && dist < 0.0f;
-                    if (!outside)
-                    {
-                        break;
-                    }
-                }
-                if (outside)
-                {
-                    discard[dc_type] = true;
-                    break;
-                }
-            }
-        }
-        if (handle_shadow ?
-            (discard[0] && discard[1] && discard[2] && discard[3] &&
-            discard[4]) : discard[0])
+        const uint8_t discard = g_culling_result[m];
+        if (handle_shadow ? discard == 0x1f : (discard & 1) != 0)
         {
             continue;
         }
@@ -842,7 +846,7 @@ void addObject(SPMeshNode* node)
 
         for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
         {
-            if (discard[dc_type])
+            if ((discard >> dc_type) & 1)
             {
                 continue;
             }
@@ -932,38 +936,17 @@ void handleDynamicDrawCall()
         SPShader* shader = dydc->getShader();
         core::aabbox3df bb = dydc->getBoundingBox();
         dydc->getAbsoluteTransformation().transformBoxEx(bb);
-        std::vector<bool> discard;
         const bool handle_shadow =
             g_handle_shadow && shader->hasShader(RP_SHADOW);
-        discard.resize((handle_shadow ? 5 : 1), false);
-        for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
+        const float* box[6] =
         {
-            for (int i = 0; i < 24; i += 4)
-            {
-                bool outside = true;
-                for (int j = 0; j < 8; j++)
-                {
-                    const float dist =
-                        getCorner(bb, j).X * g_frustums[dc_type][i] +
-                        getCorner(bb, j).Y * g_frustums[dc_type][i + 1] +
-                        getCorner(bb, j).Z * g_frustums[dc_type][i + 2] +
-                        g_frustums[dc_type][i + 3];
-                    outside = outside && dist < 0.0f;
-                    if (!outside)
-                    {
-                        break;
-                    }
-                }
-                if (outside)
-                {
-                    discard[dc_type] = true;
-                    break;
-                }
-            }
-        }
-        if (handle_shadow ?
-            (discard[0] && discard[1] && discard[2] && discard[3] &&
-            discard[4]) : discard[0])
+            &bb.MinEdge.X, &bb.MinEdge.Y, &bb.MinEdge.Z,
+            &bb.MaxEdge.X, &bb.MaxEdge.Y, &bb.MaxEdge.Z
+        };
+        uint8_t discard = 0;
+        GE::mathCullBoxes(&discard, box, 1, &g_frustums[0][0],
+            handle_shadow ? 5 : 1);
+        if (handle_shadow ? discard == 0x1f : (discard & 1) != 0)
         {
             continue;
         }
@@ -986,7 +969,7 @@ void handleDynamicDrawCall()
 
         for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
         {
-            if (discard[dc_type])
+            if ((discard >> dc_type) & 1)
             {
                 continue;
             }
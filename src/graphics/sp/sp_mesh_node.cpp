@@ -178,7 +178,7 @@ IMesh* SPMeshNode::getMeshForCurrentFrame()
         for (unsigned i = 0; i < arm.m_joint_names.size(); i++)
         {
             m_joint_nodes.at(arm.m_joint_names[i])->setAbsoluteTransformation
-                (AbsoluteTransformation * arm.m_world_matrices[i].first);
+                (AbsoluteTransformation * arm.m_world_matrices[i]);
         }
     }
     return m_mesh;
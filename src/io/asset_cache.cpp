@@ -0,0 +1,208 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "io/asset_cache.hpp"
+
+#include "config/user_config.hpp"
+#include "guiengine/engine.hpp"
+#include "io/file_manager.hpp"
+#include "race/race_manager.hpp"
+#include "states_screens/state_manager.hpp"
+#include "tracks/arena_graph.hpp"
+#include "tracks/track.hpp"
+#include "tracks/track_manager.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/log.hpp"
+#include "utils/time.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace AssetCache
+{
+// ----------------------------------------------------------------------------
+/** Header in front of each cached file, the data follows directly. */
+struct CacheHeader
+{
+    char     m_magic[4];
+    uint32_t m_version;
+    uint64_t m_content_hash;
+    uint64_t m_size;
+};   // CacheHeader
+
+// ----------------------------------------------------------------------------
+std::string getCacheFile(const std::string& type, uint64_t content_hash)
+{
+    char hex[17] = {};
+    snprintf(hex, 17, "%016llx", (unsigned long long)content_hash);
+    return file_manager->getBakedAssetsDir() + type + "-" + hex + ".bin";
+}   // getCacheFile
+
+// ----------------------------------------------------------------------------
+/** Loads cached data of the given type computed from data with the given
+ *  hash.
+ *  \return True if data is found with the current version.
+ */
+bool load(const std::string& type, uint64_t content_hash, std::string* data)
+{
+    const std::string path = getCacheFile(type, content_hash);
+    FILE* fp = FileUtils::fopenU8Path(path, "rb");
+    if (!fp)
+        return false;
+
+    CacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+        memcmp(header.m_magic, "STKB", 4) == 0 &&
+        header.m_version == VERSION &&
+        header.m_content_hash == content_hash;
+    if (ok)
+    {
+        data->resize((size_t)header.m_size);
+        ok = header.m_size == 0 ||
+            fread(&(*data)[0], (size_t)header.m_size, 1, fp) == 1;
+    }
+    fclose(fp);
+    if (!ok)
+    {
+        Log::warn("AssetCache", "Ignoring invalid or outdated '%s'.",
+            path.c_str());
+        data->clear();
+    }
+    return ok;
+}   // load
+
+// ----------------------------------------------------------------------------
+/** Saves data of the given type computed from data with the given hash. It
+ *  is written to a temporary file first, so other processes sharing the
+ *  directory never see a partially written file.
+ */
+void save(const std::string& type, uint64_t content_hash,
+          const std::string& data)
+{
+    const std::string path = getCacheFile(type, content_hash);
+    const std::string tmp_path = path + ".tmp";
+    FILE* fp = FileUtils::fopenU8Path(tmp_path, "wb");
+    if (!fp)
+    {
+        Log::warn("AssetCache", "Can't write '%s'.", tmp_path.c_str());
+        return;
+    }
+
+    CacheHeader header;
+    memcpy(header.m_magic, "STKB", 4);
+    header.m_version = VERSION;
+    header.m_content_hash = content_hash;
+    header.m_size = data.size();
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+        (data.empty() || fwrite(data.data(), data.size(), 1, fp) == 1);
+    ok = fclose(fp) == 0 && ok;
+    if (!ok)
+    {
+        Log::warn("AssetCache", "Failed to write '%s'.", tmp_path.c_str());
+        file_manager->removeFile(tmp_path);
+        return;
+    }
+    // Rename fails on windows if the file exists
+    file_manager->removeFile(path);
+    if (FileUtils::renameU8Path(tmp_path, path) != 0)
+    {
+        Log::warn("AssetCache", "Failed to rename '%s'.", tmp_path.c_str());
+        file_manager->removeFile(tmp_path);
+    }
+}   // save
+
+// ----------------------------------------------------------------------------
+/** Loads a track the way a server does (with a single AI kart), which
+ *  saves the bullet BVH and the terrain grid of its track mesh (and the
+ *  arena graph of arenas).
+ *  \param track The track to load.
+ */
+void bakeTrackMesh(Track* track)
+{
+    RaceManager* race_manager = RaceManager::get();
+    race_manager->setNumPlayers(0);
+    race_manager->setNumKarts(1);
+    race_manager->setReverseTrack(false);
+    race_manager->setMinorMode(track->isArena() ?
+        RaceManager::MINOR_MODE_FREE_FOR_ALL :
+        RaceManager::MINOR_MODE_NORMAL_RACE);
+    race_manager->startSingleRace(track->getIdent(), 1,
+        false/*from_overworld*/);
+    race_manager->exitRace();
+    // No screen is ever created when no graphics is on
+    StateManager::get()->enterMenuState();
+}   // bakeTrackMesh
+
+// ----------------------------------------------------------------------------
+/** Used by --bake-assets, computes and saves the cached data of all
+ *  installed tracks: the arena graphs, and with --no-graphics also the
+ *  bullet BVH and terrain grid of the track mesh, by loading each race track
+ *  and each arena with a navmesh. Soccer fields (which need teams) and
+ *  arenas without navmesh (which can't be used with an AI kart) have their
+ *  track mesh data saved the first time they are loaded in a race.
+ */
+void bakeAllAssets()
+{
+    const double start = StkTime::getRealTime();
+    unsigned baked_graphs = 0;
+    for (unsigned i = 0; i < track_manager->getNumberOfTracks(); i++)
+    {
+        Track* track = track_manager->getTrack(i);
+        if (!track->hasNavMesh())
+            continue;
+        const std::string navmesh = track->getTrackFile("navmesh.xml");
+        if (!file_manager->fileExists(navmesh))
+            continue;
+        Log::info("AssetCache", "Baking arena graph of '%s'.",
+            track->getIdent().c_str());
+        delete new ArenaGraph(navmesh);
+        baked_graphs++;
+    }
+
+    unsigned baked_meshes = 0;
+    if (!GUIEngine::isNoGraphics())
+    {
+        Log::warn("AssetCache", "Track meshes are only baked with "
+            "--no-graphics.");
+    }
+    else if (!UserConfigParams::m_terrain_grid)
+    {
+        Log::warn("AssetCache", "Track meshes are not baked with "
+            "--no-terrain-grid.");
+    }
+    else
+    {
+        for (unsigned i = 0; i < track_manager->getNumberOfTracks(); i++)
+        {
+            Track* track = track_manager->getTrack(i);
+            if (!track->isRaceTrack() &&
+                !(track->isArena() && track->hasNavMesh()))
+                continue;
+            Log::info("AssetCache", "Baking track mesh of '%s'.",
+                track->getIdent().c_str());
+            bakeTrackMesh(track);
+            baked_meshes++;
+        }
+    }
+    Log::info("AssetCache", "Baked %d arena graph(s) and %d track mesh(es) "
+        "in %f seconds into '%s'.", baked_graphs, baked_meshes,
+        StkTime::getRealTime() - start,
+        file_manager->getBakedAssetsDir().c_str());
+}   // bakeAllAssets
+
+}   // namespace AssetCache
@@ -0,0 +1,64 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_ASSET_CACHE_HPP
+#define HEADER_ASSET_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ *  \brief Stores derived data which is expensive to compute at load time
+ *  (bullet BVH of track meshes, arena graph shortest paths) in the baked
+ *  assets directory.
+ *  Each entry is keyed by a hash of the data it was computed from, and
+ *  stored with a format version, so changed assets or an updated STK will
+ *  never read stale data, they just compute (and save) it again.
+ *  \ingroup io
+ */
+namespace AssetCache
+{
+    /** Increase this if the layout of any cached data changes. */
+    const uint32_t VERSION = 1;
+
+    // ------------------------------------------------------------------------
+    /** FNV-1a hash, call it repeatedly with the previous result to hash
+     *  data in several parts. */
+    inline uint64_t hash(const void* data, size_t size,
+                         uint64_t h = 14695981039346656037ULL)
+    {
+        const uint8_t* p = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            h ^= p[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }   // hash
+    // ------------------------------------------------------------------------
+    bool load(const std::string& type, uint64_t content_hash,
+              std::string* data);
+    // ------------------------------------------------------------------------
+    void save(const std::string& type, uint64_t content_hash,
+              const std::string& data);
+    // ------------------------------------------------------------------------
+    void bakeAllAssets();
+};   // namespace AssetCache
+
+#endif
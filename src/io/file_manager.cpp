@@ -266,6 +266,7 @@ FileManager::FileManager()
     checkAndCreateScreenshotDir();
     checkAndCreateReplayDir();
     checkAndCreateCachedTexturesDir();
+    checkAndCreateBakedAssetsDir();
     checkAndCreateGPDir();
 
     redirectOutput();
@@ -435,10 +436,20 @@ void FileManager::init()
         i!=allfiles.end(); i++)
     {
         if((*i)=="." || (*i)=="..") continue;
+        std::string full_path=tmp+"/"+*i;
+        // Directories are addons which were extracted while downloading,
+        // but were not installed (e.g. the download failed or STK quit)
+        if(isDirectory(full_path))
+        {
+            if(UserConfigParams::logAddons())
+                Log::verbose("[FileManager]", "Deleting tmp directory '%s'.",
+                             full_path.c_str());
+            removeDirectory(full_path);
+            continue;
+        }
         // For now there should be only zip files or .part files
         // (not fully downloaded files) in tmp. Warn about any
         // other files.
-        std::string full_path=tmp+"/"+*i;
         if(StringUtils::getExtension(*i)!="zip" &&
            StringUtils::getExtension(*i)!="part"    )
         {
@@ -446,13 +457,6 @@ void FileManager::init()
                        full_path.c_str());
             continue;
         }
-        if(isDirectory(full_path))
-        {
-            // Gee, a .zip file which is a directory - stay away from it
-            Log::warn("[FileManager]", "'%s' is a directory and will not be deleted.",
-                      full_path.c_str());
-            continue;
-        }
         struct stat mystat;
         FileUtils::statU8Path(full_path, &mystat);
         StkTime::TimeType current = StkTime::getTimeSinceEpoch();
@@ -841,6 +845,14 @@ std::string FileManager::getCachedTexturesDir() const
     return m_cached_textures_dir;
 }   // getCachedTexturesDir
 
+//-----------------------------------------------------------------------------
+/** Returns the directory in which baked physics and graph data is cached.
+ */
+std::string FileManager::getBakedAssetsDir() const
+{
+    return m_baked_assets_dir;
+}   // getBakedAssetsDir
+
 //-----------------------------------------------------------------------------
 /** Returns the directory in which user-defined grand prix should be stored.
  */
@@ -1209,6 +1221,31 @@ void FileManager::checkAndCreateCachedTexturesDir()
 
 }   // checkAndCreateCachedTexturesDir
 
+// ----------------------------------------------------------------------------
+/** Creates the directory for baked assets (see AssetCache). This will set
+ *  m_baked_assets_dir with the appropriate path.
+ */
+void FileManager::checkAndCreateBakedAssetsDir()
+{
+#if defined(WIN32) || defined(__HAIKU__)
+    m_baked_assets_dir = m_user_config_dir + "baked-assets/";
+#elif defined(__APPLE__)
+    m_baked_assets_dir = getenv("HOME");
+    m_baked_assets_dir += "/Library/Application Support/SuperTuxKart/BakedAssets/";
+#else
+    m_baked_assets_dir = checkAndCreateLinuxDir("XDG_CACHE_HOME", "supertuxkart", ".cache/", ".");
+    m_baked_assets_dir += "baked-assets/";
+#endif
+
+    if (!checkAndCreateDirectory(m_baked_assets_dir))
+    {
+        Log::error("FileManager", "Can not create baked assets directory '%s', "
+            "falling back to '.'.", m_baked_assets_dir.c_str());
+        m_baked_assets_dir = "./";
+    }
+
+}   // checkAndCreateBakedAssetsDir
+
 // ----------------------------------------------------------------------------
 /** Creates the directories for user-defined grand prix. This will set m_gp_dir
  *  with the appropriate path.
@@ -37,10 +37,7 @@ Bowling::Bowling(AbstractKart *kart)
         : Flyable(kart, PowerupManager::POWERUP_BOWLING, 50.0f /* mass */)
 {
     m_has_hit_kart = false;
-    m_roll_sfx = SFXManager::get()->createSoundSource("bowling_roll");
-    fixSFXSplitscreen(m_roll_sfx);
-    m_roll_sfx->play();
-    m_roll_sfx->setLoop(true);
+    createRollSfx();
 }   // Bowling
 
 // ----------------------------------------------------------------------------
@@ -171,6 +168,17 @@ bool Bowling::hit(AbstractKart* kart, PhysicalObject* obj)
     return was_real_hit;
 }   // hit
 
+// ----------------------------------------------------------------------------
+/** Creates and starts the sfx for the rolling ball.
+ */
+void Bowling::createRollSfx()
+{
+    m_roll_sfx = SFXManager::get()->createSoundSource("bowling_roll");
+    fixSFXSplitscreen(m_roll_sfx);
+    m_roll_sfx->play();
+    m_roll_sfx->setLoop(true);
+}   // createRollSfx
+
 // ----------------------------------------------------------------------------
 void Bowling::removeRollSfx()
 {
@@ -223,7 +231,8 @@ void Bowling::onFireFlyable()
 
     const Vec3& normal = m_owner->getNormal();
     createPhysics(y_offset, btVector3(0.0f, 0.0f, m_speed*2),
-                  new btSphereShape(0.5f*m_extend.getY()),
+                  m_shape ? m_shape
+                          : new btSphereShape(0.5f*m_extend.getY()),
                   0.4f /*restitution*/,
                   -70.0f*normal /*gravity*/,
                   true /*rotates*/);
@@ -237,3 +246,19 @@ void Bowling::onFireFlyable()
     // should not live forever, auto-destruct after 20 seconds
     m_max_lifespan = stk_config->time2Ticks(20);
 }   // onFireFlyable
+
+// ----------------------------------------------------------------------------
+/** Stops the rolling sfx when the ball is kept to be reused. */
+void Bowling::onRecycleFlyable()
+{
+    Flyable::onRecycleFlyable();
+    removeRollSfx();
+}   // onRecycleFlyable
+
+// ----------------------------------------------------------------------------
+/** Starts the rolling sfx again when the ball is reused. */
+void Bowling::onReuseFlyable(AbstractKart *kart)
+{
+    Flyable::onReuseFlyable(kart);
+    createRollSfx();
+}   // onReuseFlyable
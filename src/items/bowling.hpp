@@ -48,6 +48,7 @@ private:
 
     /** A sound effect for rolling ball. */
     SFXBase     *m_roll_sfx;
+    void createRollSfx();
     void removeRollSfx();
 
 public:
@@ -59,6 +60,10 @@ public:
     virtual HitEffect *getHitEffect() const OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void onRecycleFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void onReuseFlyable(AbstractKart *kart) OVERRIDE;
 
 };   // Bowling
 
@@ -141,7 +141,8 @@ void Cake::onFireFlyable()
         m_initial_velocity = Vec3(0.0f, up_velocity, m_speed);
 
         createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+                      m_shape ? m_shape
+                              : new btCylinderShape(0.5f*m_extend),
                       0.5f /* restitution */, gravity_vector,
                       true /* rotation */, false /* backwards */, &trans);
     }
@@ -155,7 +156,8 @@ void Cake::onFireFlyable()
         m_initial_velocity = Vec3(0.0f, up_velocity, m_speed);
 
         createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+                      m_shape ? m_shape
+                              : new btCylinderShape(0.5f*m_extend),
                       0.5f /* restitution */, gravity_vector,
                       true /* rotation */, backwards, &trans);
     }
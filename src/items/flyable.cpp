@@ -66,29 +66,10 @@ Flyable::Flyable(AbstractKart *kart, PowerupManager::PowerupType type,
                  float mass)
        : Moveable(), TerrainInfo(), m_mass(mass)
 {
-    // get the appropriate data from the static fields
-    m_speed                        = m_st_speed[type];
-    m_extend                       = m_st_extend[type];
-    m_max_height                   = m_st_max_height[type];
-    m_min_height                   = m_st_min_height[type];
-    m_average_height               = (m_min_height+m_max_height)/2.0f;
-    m_force_updown                 = m_st_force_updown[type];
-    m_owner                        = kart;
     m_type                         = type;
-    m_has_hit_something            = false;
     m_shape                        = NULL;
     m_animation                    = NULL;
-    m_adjust_up_velocity           = true;
-    m_ticks_since_thrown           = 0;
-    m_position_offset              = Vec3(0,0,0);
-    m_owner_has_temporary_immunity = true;
-    m_do_terrain_info              = true;
-    m_deleted_once                 = false;
-    m_max_lifespan                 = -1;
-    m_compressed_gravity_vector    = 0;
-    // It will be reset for each state restore
-    m_has_server_state = true;
-    m_last_deleted_ticks = -1;
+    resetFlyable(kart);
 
     // Add the graphical model
 #ifndef SERVER_ONLY
@@ -106,16 +87,47 @@ Flyable::Flyable(AbstractKart *kart, PowerupManager::PowerupType type,
     // Smooth network body for flyable doesn't seem to be needed, most of the
     // time it rewinds almost the same
     SmoothNetworkBody::setEnable(false);
-    m_created_ticks = World::getWorld()->getTicksSinceStart();
 }   // Flyable
 
 // ----------------------------------------------------------------------------
-/** Creates a bullet physics body for the flyable item.
+/** Initialises all values that are not constant for a type of flyable, i.e.
+ *  everything that must be reset when a flyable is reused for a new kart.
+ *  \param kart The kart that fires this flyable.
+ */
+void Flyable::resetFlyable(AbstractKart *kart)
+{
+    // get the appropriate data from the static fields
+    m_speed                        = m_st_speed[m_type];
+    m_extend                       = m_st_extend[m_type];
+    m_max_height                   = m_st_max_height[m_type];
+    m_min_height                   = m_st_min_height[m_type];
+    m_average_height               = (m_min_height+m_max_height)/2.0f;
+    m_force_updown                 = m_st_force_updown[m_type];
+    m_owner                        = kart;
+    m_has_hit_something            = false;
+    m_adjust_up_velocity           = true;
+    m_ticks_since_thrown           = 0;
+    m_position_offset              = Vec3(0,0,0);
+    m_owner_has_temporary_immunity = true;
+    m_do_terrain_info              = true;
+    m_deleted_once                 = false;
+    m_max_lifespan                 = -1;
+    m_compressed_gravity_vector    = 0;
+    // It will be reset for each state restore
+    m_has_server_state = true;
+    m_last_deleted_ticks = -1;
+    m_created_ticks = World::getWorld()->getTicksSinceStart();
+}   // resetFlyable
+
+// ----------------------------------------------------------------------------
+/** Creates a bullet physics body for the flyable item. If the flyable is
+ *  fired again (or reused), the existing body is reinitialised.
  *  \param forw_offset How far ahead of the kart the flyable should be
  *         positioned. Necessary to avoid exploding a rocket inside of the
  *         firing kart.
  *  \param velocity Initial velocity of the flyable.
- *  \param shape Collision shape of the flyable.
+ *  \param shape Collision shape of the flyable. This is m_shape if the
+ *         flyable was fired before, otherwise a new shape.
  *  \param gravity Gravity to use for this flyable.
  *  \param rotates True if the item should rotate, otherwise the angular factor
  *         is set to 0 preventing rotations from happening.
@@ -129,8 +141,13 @@ void Flyable::createPhysics(float forw_offset, const Vec3 &velocity,
                             const bool rotates, const bool turn_around,
                             const btTransform* custom_direction)
 {
-    // Remove previously physics data if any
+    // Remove the body from the physics world if it was fired before
     removePhysics();
+    if (shape != m_shape)
+    {
+        delete m_shape;
+        m_shape = shape;
+    }
     // Get Kart heading direction
     btTransform trans = ( !custom_direction ? m_owner->getAlignedTransform()
                                             : *custom_direction          );
@@ -154,7 +171,6 @@ void Flyable::createPhysics(float forw_offset, const Vec3 &velocity,
 
     trans  *= offset_transform;
 
-    m_shape = shape;
     createBody(m_mass, trans, m_shape, restitution);
     m_user_pointer.set(this);
     Physics::get()->addBody(getBody());
@@ -218,6 +234,7 @@ void Flyable::init(const XMLNode &node, scene::IMesh *model,
 Flyable::~Flyable()
 {
     removePhysics();
+    delete m_shape;
     if (m_animation)
     {
         m_animation->handleResetRace();
@@ -226,19 +243,12 @@ Flyable::~Flyable()
 }   // ~Flyable
 
 //-----------------------------------------------------------------------------
-/* Called when delete this flyable or re-firing during rewind. */
+/* Called when delete this flyable, re-firing during rewind or recycling it.
+ * The body and shape are kept, so they can be used again when re-firing. */
 void Flyable::removePhysics()
 {
-    if (m_shape)
-    {
-        delete m_shape;
-        m_shape = NULL;
-    }
-    if (m_body.get())
-    {
+    if (m_body && m_body->getBroadphaseHandle())
         Physics::get()->removeBody(m_body.get());
-        m_body.reset();
-    }
 }   // removePhysics
 
 //-----------------------------------------------------------------------------
@@ -246,6 +256,8 @@ void Flyable::removePhysics()
  *  All 3 parameters first are of type 'out'. 'inFrontOf' can be set if you
  *  wish to know the closest kart in front of some karts (will ignore those
  *  behind). Useful e.g. for throwing projectiles in front only.
+ *  While the projectiles are updated the karts stored in the projectile
+ *  manager are used, which are shared by all projectiles.
  */
 
 void Flyable::getClosestKart(const AbstractKart **minKart,
@@ -253,6 +265,14 @@ void Flyable::getClosestKart(const AbstractKart **minKart,
                              const AbstractKart* inFrontOf,
                              const bool backwards) const
 {
+    if (inFrontOf == NULL && ProjectileManager::get()->hasKartTargets())
+    {
+        *minKart = ProjectileManager::get()->getClosestKart(getXYZ(), m_owner,
+                                                            minDistSquared,
+                                                            minDelta);
+        return;
+    }
+
     btTransform trans_projectile = (inFrontOf != NULL ? inFrontOf->getTrans()
                                                       : getTrans());
 
@@ -808,6 +828,44 @@ void Flyable::onDeleteFlyable()
     moveToInfinity();
 }   // onDeleteFlyable
 
+// ----------------------------------------------------------------------------
+/** Called when the projectile manager keeps this flyable after it was
+ *  deleted, so that it can be reused for a new flyable of the same type.
+ *  Removes it from the physics world and hides it.
+ */
+void Flyable::onRecycleFlyable()
+{
+    removePhysics();
+    if (m_animation)
+    {
+        m_animation->handleResetRace();
+        delete m_animation;
+        m_animation = NULL;
+    }
+#ifndef SERVER_ONLY
+    if (m_node)
+        m_node->setVisible(false);
+#endif
+}   // onRecycleFlyable
+
+// ----------------------------------------------------------------------------
+/** Called when a recycled flyable is used for a new kart, before it is
+ *  fired. Resets all values like the constructor does, including the
+ *  terrain information of the previous use. The cached Moveable state is
+ *  recomputed when the body is created again in createPhysics.
+ *  \param kart The kart that fires this flyable.
+ */
+void Flyable::onReuseFlyable(AbstractKart *kart)
+{
+    resetFlyable(kart);
+    TerrainInfo::operator=(TerrainInfo());
+    SmoothNetworkBody::reset();
+#ifndef SERVER_ONLY
+    if (m_node)
+        m_node->setVisible(true);
+#endif
+}   // onReuseFlyable
+
 // ----------------------------------------------------------------------------
 /* Make specifc sfx lower volume if needed in splitscreen multiplayer. */
 void Flyable::fixSFXSplitscreen(SFXBase* sfx)
@@ -76,6 +76,8 @@ private:
      *  animation. NULL otherwise. */
     AbstractKartAnimation *m_animation;
 
+    void              resetFlyable(AbstractKart *kart);
+
 protected:
     /** Kart which shot this flyable. */
     AbstractKart*     m_owner;
@@ -84,7 +86,8 @@ protected:
     PowerupManager::PowerupType
                       m_type;
 
-    /** Collision shape of this Flyable. */
+    /** Collision shape of this Flyable. It is kept when the flyable is
+     *  fired again, since its size only depends on the type. */
     btCollisionShape *m_shape;
 
     /** Maximum height above terrain. */
@@ -273,6 +276,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void onDeleteFlyable();
     // ------------------------------------------------------------------------
+    virtual void onRecycleFlyable();
+    // ------------------------------------------------------------------------
+    virtual void onReuseFlyable(AbstractKart *kart);
+    // ------------------------------------------------------------------------
     void setCreatedTicks(int ticks)                { m_created_ticks = ticks; }
 };   // Flyable
 
@@ -31,7 +31,6 @@
 #include "modes/profile_world.hpp"
 #include "network/network_config.hpp"
 #include "network/race_event_manager.hpp"
-#include "physics/triangle_mesh.hpp"
 #include "tracks/arena_graph.hpp"
 #include "tracks/arena_node.hpp"
 #include "tracks/track.hpp"
@@ -293,10 +292,8 @@ Item* ItemManager::dropNewItem(ItemState::ItemType type,
         pos = server_xyz ? *server_xyz : kart->getXYZ();
         Vec3 to = pos + kart->getTrans().getBasis() * Vec3(0, -10000, 0);
         Vec3 hit_point;
-        Track::getCurrentTrack()->getTriangleMesh().castRay(pos, to,
-                                                            &hit_point,
-                                                            &material_hit,
-                                                            &normal);
+        Track::getCurrentTrack()->castRayToTerrain(pos, to, &hit_point,
+                                                   &material_hit, &normal);
 
         // We will get no material if the kart is 'over nothing' when dropping
         // the bubble gum. In most cases this means that the item does not need
@@ -693,9 +690,8 @@ bool ItemManager::randomItemsForArena(const AlignedArray<btTransform>& pos)
         const Material* m;
         Vec3 normal;
         Vec3 hit_point;
-        const TriangleMesh& tm = Track::getCurrentTrack()->getTriangleMesh();
-        bool success = tm.castRay(loc, an->getCenter() + (-10000*quad_normal),
-                                   &hit_point, &m, &normal);
+        bool success = Track::getCurrentTrack()->castRayToTerrain(loc,
+            an->getCenter() + (-10000*quad_normal), &hit_point, &m, &normal);
 
         if (success)
         {
@@ -100,14 +100,16 @@ void Plunger::onFireFlyable()
         m_initial_velocity = btVector3(0.0f, up_velocity, plunger_speed);
 
         createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+                      m_shape ? m_shape
+                              : new btCylinderShape(0.5f*m_extend),
                       0.5f /* restitution */ , btVector3(.0f,gravity,.0f),
                       /* rotates */false , /*turn around*/false, &trans);
     }
     else
     {
         createPhysics(forward_offset, btVector3(pitch, 0.0f, plunger_speed),
-                      new btCylinderShape(0.5f*m_extend),
+                      m_shape ? m_shape
+                              : new btCylinderShape(0.5f*m_extend),
                       0.5f /* restitution */, btVector3(.0f,gravity,.0f),
                       false /* rotates */, m_reverse_mode, &kart_transform);
     }
@@ -126,7 +128,7 @@ void Plunger::onFireFlyable()
     }
 
     if (m_rubber_band)
-        m_rubber_band->reset();
+        m_rubber_band->reset(m_owner);
 
     m_keep_alive = -1;
     m_moved_to_infinity = false;
@@ -307,3 +309,15 @@ void Plunger::onDeleteFlyable()
     if (m_rubber_band)
         m_rubber_band->remove();
 }   // onDeleteFlyable
+
+// ----------------------------------------------------------------------------
+/** The rubber band is kept with the plunger to be reused. Its graphics are
+ *  removed, and it is attached to the new owner when the plunger is fired
+ *  again.
+ */
+void Plunger::onRecycleFlyable()
+{
+    Flyable::onRecycleFlyable();
+    if (m_rubber_band)
+        m_rubber_band->remove();
+}   // onRecycleFlyable
@@ -75,6 +75,8 @@ public:
     virtual void onFireFlyable() OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onDeleteFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void onRecycleFlyable() OVERRIDE;
 
 };   // Plunger
 
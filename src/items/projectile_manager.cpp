@@ -35,8 +35,27 @@
 #include "utils/stk_process.hpp"
 #include "utils/string_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <typeinfo>
 
+namespace
+{
+    /** The order in which the types of projectiles are updated. This is the
+     *  order of the unique identities (which start with the rewinder name)
+     *  of the projectiles, so they are updated in the same order as they
+     *  are sorted in m_active_projectiles. */
+    const PowerupManager::PowerupType UPDATE_ORDER[] =
+    {
+        PowerupManager::POWERUP_CAKE,   PowerupManager::POWERUP_BOWLING,
+        PowerupManager::POWERUP_PLUNGER, PowerupManager::POWERUP_RUBBERBALL
+    };
+
+    /** Maximum number of removed projectiles of each type that are kept to
+     *  be reused. */
+    const unsigned int MAX_RECYCLED_PROJECTILES = 8;
+}   // anonymous namespace
+
 //=============================================================================================
 ProjectileManager* g_projectile_manager[PT_COUNT];
 //---------------------------------------------------------------------------------------------
@@ -84,6 +103,9 @@ void ProjectileManager::removeTextures()
 void ProjectileManager::cleanup()
 {
     m_active_projectiles.clear();
+    m_projectiles_dirty = true;
+    for (auto &recycled : m_recycled_projectiles)
+        recycled.clear();
     for(HitEffects::iterator i  = m_active_hit_effects.begin();
         i != m_active_hit_effects.end(); ++i)
     {
@@ -134,36 +156,187 @@ void ProjectileManager::update(int ticks)
 }   // update
 
 // -----------------------------------------------------------------------------
-/** Updates all rockets on the server (or no networking). */
+/** Updates all rockets on the server (or no networking). The projectiles are
+ *  updated one type after the other, and removed projectiles are only
+ *  erased after all projectiles were updated, so the per type lists stay
+ *  valid during the update.
+ */
 void ProjectileManager::updateServer(int ticks)
 {
+    if (m_active_projectiles.empty())
+        return;
+
+    updateKartTargets();
+    m_kart_targets_valid = true;
+
+    std::vector<Flyable*> deleted;
+    for (PowerupManager::PowerupType type : UPDATE_ORDER)
+    {
+        const std::vector<Flyable*> &projectiles = getProjectiles(type);
+        for (unsigned int i = 0; i < projectiles.size(); i++)
+        {
+            Flyable *f = projectiles[i];
+            if (!f->hasServerState())
+                continue;
+            bool can_be_deleted = f->updateAndDelete(ticks);
+            if (can_be_deleted)
+            {
+                HitEffect* he = f->getHitEffect();
+                if (he)
+                    addHitEffect(he);
+
+                f->onDeleteFlyable();
+                // Flyables will be deleted by computeError in client
+                if (!NetworkConfig::get()->isNetworking() ||
+                    NetworkConfig::get()->isServer())
+                    deleted.push_back(f);
+            }
+        }   // for i < projectiles.size()
+    }   // for type in UPDATE_ORDER
+    m_kart_targets_valid = false;
+
+    if (deleted.empty())
+        return;
     auto p = m_active_projectiles.begin();
     while (p != m_active_projectiles.end())
     {
-        if (!p->second->hasServerState())
-        {
-            p++;
-            continue;
-        }
-        bool can_be_deleted = p->second->updateAndDelete(ticks);
-        if (can_be_deleted)
+        if (std::find(deleted.begin(), deleted.end(), p->second.get()) !=
+            deleted.end())
         {
-            HitEffect* he = p->second->getHitEffect();
-            if (he)
-                addHitEffect(he);
-
-            p->second->onDeleteFlyable();
-            // Flyables will be deleted by computeError in client
-            if (!NetworkConfig::get()->isNetworking() ||
-                NetworkConfig::get()->isServer())
-                p = m_active_projectiles.erase(p);
+            std::shared_ptr<Flyable> f = p->second;
+            p = m_active_projectiles.erase(p);
+            recycleProjectile(std::move(f));
         }
         else
             p++;
     }   // while p!=m_active_projectiles.end()
-
+    m_projectiles_dirty = true;
 }   // updateServer
 
+// -----------------------------------------------------------------------------
+/** Returns all active projectiles of the given type, in the order in which
+ *  they are stored in m_active_projectiles. The lists of all types are
+ *  rebuilt if projectiles were added or removed.
+ *  \param type Type of the projectiles.
+ */
+const std::vector<Flyable*>&
+    ProjectileManager::getProjectiles(PowerupManager::PowerupType type)
+{
+    if (m_projectiles_dirty)
+    {
+        for (std::vector<Flyable*> &projectiles : m_projectiles)
+            projectiles.clear();
+        for (auto &p : m_active_projectiles)
+            m_projectiles[p.second->getType()].push_back(p.second.get());
+        m_projectiles_dirty = false;
+    }
+    return m_projectiles[type];
+}   // getProjectiles
+
+// -----------------------------------------------------------------------------
+/** Stores the position of all karts which can be targeted, sorted by their
+ *  x coordinate, so that all projectiles can share them in getClosestKart.
+ *  Karts which are e.g. hit during the update of the projectiles get an
+ *  animation (or are eliminated), so they are tested again in
+ *  getClosestKart, but the position of all other karts does not change.
+ */
+void ProjectileManager::updateKartTargets()
+{
+    m_kart_targets.clear();
+    World *world = World::getWorld();
+    for (unsigned int i = 0; i < world->getNumKarts(); i++)
+    {
+        AbstractKart *kart = world->getKart(i);
+        if (kart->isEliminated())
+            continue;
+        KartTarget target;
+        target.m_xyz  = kart->getXYZ();
+        target.m_kart = kart;
+        target.m_team = world->hasTeam() ? (int)world->getKartTeam(i) : 0;
+        m_kart_targets.push_back(target);
+    }
+    // Karts are added by increasing world kart id, a stable sort keeps
+    // karts with the same x coordinate in this order.
+    std::stable_sort(m_kart_targets.begin(), m_kart_targets.end(),
+                     [](const KartTarget &a, const KartTarget &b)
+                     { return a.m_xyz.getX() < b.m_xyz.getX(); });
+}   // updateKartTargets
+
+// -----------------------------------------------------------------------------
+/** Returns the kart closest to a projectile which can be targeted by it, or
+ *  NULL if there is none. This gives the same result as testing all karts,
+ *  but starts with the karts closest in x direction, and stops once the
+ *  x distance alone is larger than the distance to the closest kart.
+ *  Can only be used while projectiles are updated, see hasKartTargets().
+ *  \param xyz Position of the projectile.
+ *  \param owner The kart that fired the projectile.
+ *  \param min_dist_squared Returns the squared distance to the closest kart,
+ *         with the difference in height counted twice.
+ *  \param min_delta Returns the vector from the projectile to the closest
+ *         kart, unchanged if no kart is found.
+ */
+const AbstractKart* ProjectileManager::getClosestKart(const Vec3 &xyz,
+                                                  const AbstractKart *owner,
+                                                  float *min_dist_squared,
+                                                  Vec3 *min_delta) const
+{
+    assert(m_kart_targets_valid);
+    World *world = World::getWorld();
+    const bool has_team = world->hasTeam();
+    const int owner_team =
+        has_team ? (int)world->getKartTeam(owner->getWorldKartId()) : 0;
+
+    *min_dist_squared = 999999.9f;
+    const AbstractKart *min_kart = NULL;
+
+    // Returns false if this and all karts further away in x direction
+    // can't be closer than the closest kart found so far.
+    auto test_kart = [&](const KartTarget &target) -> bool
+    {
+        float dx = target.m_xyz.getX() - xyz.getX();
+        if (dx * dx > *min_dist_squared)
+            return false;
+
+        // If a kart has star effect shown, the kart is immune, so
+        // it is not considered a target anymore.
+        const AbstractKart *kart = target.m_kart;
+        if (kart->isEliminated() || kart == owner ||
+            kart->isInvulnerable() || kart->getKartAnimation())
+            return true;
+
+        // Don't hit teammates in team world
+        if (has_team && target.m_team == owner_team)
+            return true;
+
+        Vec3 delta = target.m_xyz - xyz;
+        // the Y distance is added again because karts above or below should
+        // not be prioritized when aiming
+        float distance2 = delta.length2() +
+                          std::abs(target.m_xyz.getY() - xyz.getY()) * 2;
+        // Same as testing all karts by world kart id: in case of the same
+        // distance the kart with the lower id is used.
+        if (distance2 < *min_dist_squared ||
+            (min_kart && distance2 == *min_dist_squared &&
+             kart->getWorldKartId() < min_kart->getWorldKartId()))
+        {
+            *min_dist_squared = distance2;
+            min_kart          = kart;
+            *min_delta        = delta;
+        }
+        return true;
+    };   // test_kart
+
+    auto start = std::lower_bound(m_kart_targets.begin(), m_kart_targets.end(),
+                                  xyz.getX(),
+                                  [](const KartTarget &target, float x)
+                                  { return target.m_xyz.getX() < x; });
+    for (auto i = start; i != m_kart_targets.end() && test_kart(*i); i++) {}
+    for (auto i = start; i != m_kart_targets.begin() && test_kart(*(i - 1));
+         i--) {}
+
+    return min_kart;
+}   // getClosestKart
+
 // -----------------------------------------------------------------------------
 /** Creates a new projectile of the given type.
  *  \param kart The kart which shoots the projectile.
@@ -182,32 +355,74 @@ std::shared_ptr<Flyable>
         return it->second;
     }
 
-    std::shared_ptr<Flyable> f;
+    std::shared_ptr<Flyable> f = createProjectile(kart, type);
+    if (!f)
+        return nullptr;
+    // This cannot be done in constructor because of virtual function
+    f->onFireFlyable();
+    m_active_projectiles[uid] = f;
+    m_projectiles_dirty = true;
+    if (RewindManager::get()->isEnabled())
+        f->addForRewind(uid);
+
+    return f;
+}   // newProjectile
+
+// -----------------------------------------------------------------------------
+/** Creates a projectile of the given type, or reuses a projectile of this
+ *  type that was removed before. The projectile still needs to be fired.
+ *  \param kart The kart which shoots the projectile.
+ *  \param type Type of projectile.
+ */
+std::shared_ptr<Flyable>
+    ProjectileManager::createProjectile(AbstractKart *kart,
+                                        PowerupManager::PowerupType type)
+{
+    std::vector<std::shared_ptr<Flyable> > &recycled =
+        m_recycled_projectiles[type];
+    if (!recycled.empty())
+    {
+        std::shared_ptr<Flyable> f = recycled.back();
+        recycled.pop_back();
+        f->onReuseFlyable(kart);
+        return f;
+    }
+
     switch(type)
     {
         case PowerupManager::POWERUP_BOWLING:
-            f = std::make_shared<Bowling>(kart);
-            break;
+            return std::make_shared<Bowling>(kart);
         case PowerupManager::POWERUP_PLUNGER:
-            f = std::make_shared<Plunger>(kart);
-            break;
+            return std::make_shared<Plunger>(kart);
         case PowerupManager::POWERUP_CAKE:
-            f = std::make_shared<Cake>(kart);
-            break;
+            return std::make_shared<Cake>(kart);
         case PowerupManager::POWERUP_RUBBERBALL:
-            f = std::make_shared<RubberBall>(kart);
-            break;
+            return std::make_shared<RubberBall>(kart);
         default:
             return nullptr;
     }
-    // This cannot be done in constructor because of virtual function
-    f->onFireFlyable();
-    m_active_projectiles[uid] = f;
-    if (RewindManager::get()->isEnabled())
-        f->addForRewind(uid);
+}   // createProjectile
 
-    return f;
-}   // newProjectile
+// -----------------------------------------------------------------------------
+/** Keeps a projectile that was removed, so that it (including its scene
+ *  node and physics body) can be reused by createProjectile. Projectiles
+ *  which are still referenced elsewhere are not kept.
+ *  \param f The removed projectile.
+ */
+void ProjectileManager::recycleProjectile(std::shared_ptr<Flyable> f)
+{
+    std::vector<std::shared_ptr<Flyable> > &recycled =
+        m_recycled_projectiles[f->getType()];
+    if (f.use_count() > 1 || recycled.size() >= MAX_RECYCLED_PROJECTILES)
+        return;
+
+    // Otherwise the rewind manager would still use this projectile for its
+    // old unique identity
+    if (RewindManager::get()->isEnabled())
+        RewindManager::get()->removeRewinder(f->getUniqueIdentity());
+    f->onRecycleFlyable();
+    recycled.push_back(f);
+}   // recycleProjectile
 
 // -----------------------------------------------------------------------------
 /** Returns true if a projectile is within the given distance of the specified
@@ -243,20 +458,17 @@ int ProjectileManager::getNearbyProjectileCount(const AbstractKart * const kart,
 {
     float r2 = radius * radius;
     int projectile_count = 0;
-    for (auto i = m_active_projectiles.begin(); i != m_active_projectiles.end(); i++)
+    for (Flyable *f : getProjectiles(type))
     {
-        if (!i->second->hasServerState())
+        if (!f->hasServerState())
+            continue;
+        if (exclude_owned && (f->getOwner() == kart))
             continue;
-        if (i->second->getType() == type)
-        {
-            if (exclude_owned && (i->second->getOwner() == kart))
-                continue;
 
-            float dist2 = i->second->getXYZ().distance2(kart->getXYZ());
-            if (dist2 < r2)
-            {
-                projectile_count++;
-            }
+        float dist2 = f->getXYZ().distance2(kart->getXYZ());
+        if (dist2 < r2)
+        {
+            projectile_count++;
         }
     }
     return projectile_count;
@@ -266,12 +478,11 @@ int ProjectileManager::getNearbyProjectileCount(const AbstractKart * const kart,
 std::vector<Vec3> ProjectileManager::getBasketballPositions()
 {
     std::vector<Vec3> positions;
-    for (auto i = m_active_projectiles.begin(); i != m_active_projectiles.end(); i++)
+    for (Flyable *f : getProjectiles(PowerupManager::POWERUP_RUBBERBALL))
     {
-        if (!i->second->hasServerState())
+        if (!f->hasServerState())
             continue;
-        if (i->second->getType() == PowerupManager::POWERUP_RUBBERBALL)
-            positions.emplace_back(i->second->getXYZ());
+        positions.emplace_back(f->getXYZ());
     } // loop over projectiles
 
     return positions;
@@ -329,27 +540,27 @@ std::shared_ptr<Rewinder>
 
     AbstractKart* kart = World::getWorld()->getKart(data.getUInt8());
     int created_ticks = data.getUInt32();
-    std::shared_ptr<Flyable> f;
+    PowerupManager::PowerupType type = PowerupManager::POWERUP_NOTHING;
     switch (rn)
     {
         case RN_BOWLING:
         {
-            f = std::make_shared<Bowling>(kart);
+            type = PowerupManager::POWERUP_BOWLING;
             break;
         }
         case RN_PLUNGER:
         {
-            f = std::make_shared<Plunger>(kart);
+            type = PowerupManager::POWERUP_PLUNGER;
             break;
         }
         case RN_CAKE:
         {
-            f = std::make_shared<Cake>(kart);
+            type = PowerupManager::POWERUP_CAKE;
             break;
         }
         case RN_RUBBERBALL:
         {
-            f = std::make_shared<RubberBall>(kart);
+            type = PowerupManager::POWERUP_RUBBERBALL;
             break;
         }
         default:
@@ -357,6 +568,7 @@ std::shared_ptr<Rewinder>
             break;
         }
     }
+    std::shared_ptr<Flyable> f = createProjectile(kart, type);
     assert(f);
     f->setCreatedTicks(created_ticks);
     f->onFireFlyable();
@@ -369,6 +581,7 @@ std::shared_ptr<Rewinder>
         created_ticks);
 
     m_active_projectiles[uid] = f;
+    m_projectiles_dirty = true;
     return f;
 }   // addProjectileFromNetworkState
 
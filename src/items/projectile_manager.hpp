@@ -31,13 +31,13 @@ namespace irr
 
 #include "items/powerup_manager.hpp"
 #include "utils/no_copy.hpp"
+#include "utils/vec3.hpp"
 
 class AbstractKart;
 class Flyable;
 class HitEffect;
 class Rewinder;
 class Track;
-class Vec3;
 
 /**
   * \ingroup items
@@ -51,6 +51,37 @@ private:
      *  currently moving on the track. */
     std::map<std::string, std::shared_ptr<Flyable> > m_active_projectiles;
 
+    /** The active projectiles of each type, in the same order as in
+     *  m_active_projectiles. They are rebuilt from m_active_projectiles
+     *  when m_projectiles_dirty is set. */
+    std::vector<Flyable*> m_projectiles[PowerupManager::POWERUP_MAX];
+
+    /** True if m_active_projectiles was changed since the per type
+     *  lists were built. */
+    bool             m_projectiles_dirty;
+
+    /** Projectiles which were removed, and are kept to be reused for new
+     *  projectiles of the same type. */
+    std::vector<std::shared_ptr<Flyable> >
+                     m_recycled_projectiles[PowerupManager::POWERUP_MAX];
+
+    /** A kart that can be targeted by projectiles. */
+    struct KartTarget
+    {
+        Vec3          m_xyz;
+        AbstractKart *m_kart;
+        int           m_team;
+    };   // KartTarget
+
+    /** All karts that can be targeted, sorted by their x coordinate. This
+     *  is only valid while the projectiles are updated, see
+     *  m_kart_targets_valid. */
+    std::vector<KartTarget> m_kart_targets;
+
+    /** True while the projectiles are updated, during which the position
+     *  of targetable karts does not change. */
+    bool             m_kart_targets_valid;
+
     /** All active hit effects, i.e. hit effects which are currently
      *  being shown or have a sfx playing. */
     HitEffects       m_active_hit_effects;
@@ -58,6 +89,13 @@ private:
     std::string      getUniqueIdentity(AbstractKart* kart,
                                        PowerupManager::PowerupType type);
     void             updateServer(int ticks);
+    void             updateKartTargets();
+    const std::vector<Flyable*>&
+                     getProjectiles(PowerupManager::PowerupType type);
+    std::shared_ptr<Flyable>
+                     createProjectile(AbstractKart *kart,
+                                      PowerupManager::PowerupType type);
+    void             recycleProjectile(std::shared_ptr<Flyable> f);
 public:
     // ----------------------------------------------------------------------------------------
     static ProjectileManager* get();
@@ -68,7 +106,8 @@ public:
     // ----------------------------------------------------------------------------------------
     static void clear();
     // ----------------------------------------------------------------------------------------
-                     ProjectileManager() {}
+                     ProjectileManager() : m_projectiles_dirty(false),
+                                           m_kart_targets_valid(false) {}
                     ~ProjectileManager() {}
     void             loadData         ();
     void             cleanup          ();
@@ -81,6 +120,14 @@ public:
     int              getNearbyProjectileCount(const AbstractKart * const kart,
                                        float radius, PowerupManager::PowerupType type,
                                        bool exclude_owned=false);
+    const AbstractKart* getClosestKart(const Vec3 &xyz,
+                                       const AbstractKart *owner,
+                                       float *min_dist_squared,
+                                       Vec3 *min_delta) const;
+    // ------------------------------------------------------------------------
+    /** Returns true if getClosestKart() can be used, i.e. while the
+     *  projectiles are updated. */
+    bool             hasKartTargets() const   { return m_kart_targets_valid; }
     // ------------------------------------------------------------------------
     /** Adds a special hit effect to be shown.
      *  \param hit_effect The hit effect to be added. */
@@ -96,10 +143,16 @@ public:
     std::vector<Vec3> getBasketballPositions();
     // ------------------------------------------------------------------------
     void addByUID(const std::string& uid, std::shared_ptr<Flyable> f)
-                                             { m_active_projectiles[uid] = f; }
+    {
+        m_active_projectiles[uid] = f;
+        m_projectiles_dirty = true;
+    }   // addByUID
     // ------------------------------------------------------------------------
     void removeByUID(const std::string& uid)
-                                           { m_active_projectiles.erase(uid); }
+    {
+        m_active_projectiles.erase(uid);
+        m_projectiles_dirty = true;
+    }   // removeByUID
 };
 
 #endif
@@ -72,8 +72,7 @@ RubberBall::RubberBall(AbstractKart *kart)
     m_id = next_id[STKProcess::getType()]++;
 
     m_target = NULL;
-    m_ping_sfx = SFXManager::get()->createSoundSource("ball_bounce");
-    fixSFXSplitscreen(m_ping_sfx);
+    createPingSFX();
 }   // RubberBall
 
 // ----------------------------------------------------------------------------
@@ -88,7 +87,8 @@ void RubberBall::onFireFlyable()
         0.5f * m_owner->getKartLength() + m_extend.getZ() * 0.5f + 5.0f;
 
     createPhysics(forw_offset, btVector3(0.0f, 0.0f, m_speed*2),
-                  new btSphereShape(0.5f*m_extend.getY()), -70.0f,
+                  m_shape ? m_shape
+                          : new btSphereShape(0.5f*m_extend.getY()), -70.0f,
                   btVector3(.0f,.0f,.0f) /*gravity*/,
                   true /*rotates*/);
 
@@ -937,6 +937,15 @@ void RubberBall::restoreState(BareNetworkString *buffer, int count)
     TrackSector::rewindTo(buffer);
 }   // restoreState
 
+// ----------------------------------------------------------------------------
+/** Creates the sfx which is played when the ball bounces.
+ */
+void RubberBall::createPingSFX()
+{
+    m_ping_sfx = SFXManager::get()->createSoundSource("ball_bounce");
+    fixSFXSplitscreen(m_ping_sfx);
+}   // createPingSFX
+
 // ----------------------------------------------------------------------------
 void RubberBall::removePingSFX()
 {
@@ -947,3 +956,26 @@ void RubberBall::removePingSFX()
     m_ping_sfx->deleteSFX();
     m_ping_sfx = NULL;
 }   // removePingSFX
+
+// ----------------------------------------------------------------------------
+/** Removes the sfx and the ball from all cannons when the ball is kept to
+ *  be reused.
+ */
+void RubberBall::onRecycleFlyable()
+{
+    Flyable::onRecycleFlyable();
+    removePingSFX();
+    Track::getCurrentTrack()->getCheckManager()->removeFlyableFromCannons(this);
+}   // onRecycleFlyable
+
+// ----------------------------------------------------------------------------
+/** Resets the ball like the constructor does when it is reused.
+ *  \param kart The kart that fires this ball.
+ */
+void RubberBall::onReuseFlyable(AbstractKart *kart)
+{
+    Flyable::onReuseFlyable(kart);
+    TrackSector::reset();
+    m_target = NULL;
+    createPingSFX();
+}   // onReuseFlyable
@@ -208,6 +208,7 @@ private:
     float        getTunnelHeight(const Vec3 &next_xyz, 
                                      const float vertical_offset) const;
     bool         checkTunneling();
+    void createPingSFX();
     void removePingSFX();
 
 public:
@@ -228,6 +229,10 @@ public:
     virtual void restoreState(BareNetworkString *buffer, int count) OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void onRecycleFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void onReuseFlyable(AbstractKart *kart) OVERRIDE;
 
 };   // RubberBall
 
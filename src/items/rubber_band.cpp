@@ -54,7 +54,14 @@ RubberBand::RubberBand(Plunger *plunger, AbstractKart *kart)
 {
     m_hit_kart = NULL;
     m_attached_state = RB_TO_PLUNGER;
+    createGraphics();
+}   // RubberBand
 
+// ----------------------------------------------------------------------------
+/** Creates the quad (or dynamic draw call) of the rubber band.
+ */
+void RubberBand::createGraphics()
+{
 #ifndef SERVER_ONLY
     if (GUIEngine::isNoGraphics())
         return;
@@ -120,7 +127,7 @@ RubberBand::RubberBand(Plunger *plunger, AbstractKart *kart)
         mesh->drop();
     }
 #endif
-}   // RubberBand
+}   // createGraphics
 
 // ----------------------------------------------------------------------------
 RubberBand::~RubberBand()
@@ -129,8 +136,18 @@ RubberBand::~RubberBand()
 }   // RubberBand
 
 // ----------------------------------------------------------------------------
-void RubberBand::reset()
+/** Attaches the rubber band to the plunger again when the plunger is fired.
+ *  A plunger which is reused keeps its rubber band, whose graphics were
+ *  removed when the plunger was deleted, so they are created again.
+ *  \param kart The kart which fires the plunger.
+ */
+void RubberBand::reset(AbstractKart *kart)
 {
+    m_owner = kart;
+#ifndef SERVER_ONLY
+    if (!m_dy_dc && !m_node)
+        createGraphics();
+#endif
     m_hit_kart = NULL;
     m_attached_state = RB_TO_PLUNGER;
     updatePosition();
@@ -76,12 +76,13 @@ private:
     Vec3                m_end_position;
 
     void checkForHit(const Vec3 &k, const Vec3 &p);
+    void createGraphics();
     void updatePosition();
 
 public:
          RubberBand(Plunger *plunger, AbstractKart *kart);
         ~RubberBand();
-    void reset();
+    void reset(AbstractKart *kart);
     void updateGraphics(float dt);
     void update(int ticks);
     void hit(AbstractKart *kart_hit, const Vec3 *track_xyz=NULL);
@@ -88,9 +88,17 @@ void AbstractKart::loadKartProperties(const std::string& new_ident,
                                       std::shared_ptr<GE::GERenderInfo> ri,
                                       const KartData& kart_data)
 {
+    kart_properties_manager->onDemandLoadKartModels({ new_ident });
     m_kart_properties.reset(new KartProperties());
     KartProperties* tmp_kp = NULL;
     const KartProperties* kp = kart_properties_manager->getKart(new_ident);
+    if (kp && !kp->isKartModelLoaded())
+    {
+        // Loading the models on demand failed
+        Log::warn("Abstract_Kart", "Kart %s has no models, fallback to tux",
+            new_ident.c_str());
+        kp = kart_properties_manager->getKart(std::string("tux"));
+    }
     const KartProperties* kp_addon = NULL;
     bool new_hitbox = false;
     Vec3 gravity_shift;
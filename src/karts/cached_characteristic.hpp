@@ -20,36 +20,198 @@
 #define HEADER_CACHED_CHARACTERISTICS_HPP
 
 #include "karts/abstract_characteristic.hpp"
+#include "utils/interpolation_array.hpp"
 
 #include <assert.h>
+#include <vector>
 
+/** Resolves all characteristics of a source (usually the combination of the
+ *  base, difficulty, kart type, handicap and kart characteristics) once and
+ *  stores them in a flat struct with one typed member per characteristic.
+ *  The kart properties read directly from this struct, so getting a value
+ *  in the kart update neither needs a virtual call nor copies a vector.
+ */
 class CachedCharacteristic : public AbstractCharacteristic
 {
-private:
-    /** Used to store a value. */
-    struct SaveValue
+public:
+    /** All resolved values. Members of characteristics that are not set in
+     *  the source are 0, false or empty. */
+    struct Values
     {
-        void *content;
+        // Script-generated content generated by tools/create_kart_properties.py ccdefs
+        // Please don't change the following tag. It will be automatically detected
+        // by the script and replace the contained content.
+        // To update the code, use tools/update_characteristics.py
+        /* <characteristics-start ccdefs> */
+
+        float m_suspension_stiffness;
+        float m_suspension_rest;
+        float m_suspension_travel;
+        bool m_suspension_exp_spring_response;
+        float m_suspension_max_force;
+
+        float m_stability_roll_influence;
+        float m_stability_chassis_linear_damping;
+        float m_stability_chassis_angular_damping;
+        float m_stability_downward_impulse_factor;
+        float m_stability_track_connection_accel;
+        std::vector<float> m_stability_angular_factor;
+        float m_stability_smooth_flying_impulse;
+
+        InterpolationArray m_turn_radius;
+        float m_turn_time_reset_steer;
+        InterpolationArray m_turn_time_full_steer;
+
+        float m_engine_power;
+        float m_engine_max_speed;
+        float m_engine_generic_max_speed;
+        float m_engine_brake_factor;
+        float m_engine_brake_time_increase;
+        float m_engine_max_speed_reverse_ratio;
+
+        std::vector<float> m_gear_switch_ratio;
+        std::vector<float> m_gear_power_increase;
+
+        float m_mass;
+
+        float m_wheels_damping_relaxation;
+        float m_wheels_damping_compression;
+
+        float m_jump_animation_time;
+
+        float m_lean_max;
+        float m_lean_speed;
+
+        float m_anvil_duration;
+        float m_anvil_weight;
+        float m_anvil_speed_factor;
+
+        float m_parachute_friction;
+        float m_parachute_duration;
+        float m_parachute_duration_other;
+        float m_parachute_duration_rank_mult;
+        float m_parachute_duration_speed_mult;
+        float m_parachute_lbound_fraction;
+        float m_parachute_ubound_fraction;
+        float m_parachute_max_speed;
+
+        float m_friction_kart_friction;
 
-        SaveValue() : content(nullptr) {}
-        SaveValue(void *content) : content(content) {}
+        float m_bubblegum_duration;
+        float m_bubblegum_speed_fraction;
+        float m_bubblegum_torque;
+        float m_bubblegum_fade_in_time;
+        float m_bubblegum_shield_duration;
+
+        float m_zipper_duration;
+        float m_zipper_force;
+        float m_zipper_speed_gain;
+        float m_zipper_max_speed_increase;
+        float m_zipper_fade_out_time;
+
+        float m_swatter_duration;
+        float m_swatter_distance;
+        float m_swatter_squash_duration;
+        float m_swatter_squash_slowdown;
+
+        float m_plunger_band_max_length;
+        float m_plunger_band_force;
+        float m_plunger_band_duration;
+        float m_plunger_band_speed_increase;
+        float m_plunger_band_fade_out_time;
+        float m_plunger_in_face_time;
+
+        std::vector<float> m_startup_time;
+        std::vector<float> m_startup_boost;
+
+        float m_rescue_duration;
+        float m_rescue_vert_offset;
+        float m_rescue_height;
+
+        float m_explosion_duration;
+        float m_explosion_radius;
+        float m_explosion_invulnerability_time;
+
+        float m_nitro_duration;
+        float m_nitro_engine_force;
+        float m_nitro_engine_mult;
+        float m_nitro_consumption;
+        float m_nitro_small_container;
+        float m_nitro_big_container;
+        float m_nitro_max_speed_increase;
+        float m_nitro_fade_out_time;
+        float m_nitro_max;
+
+        float m_slipstream_duration_factor;
+        float m_slipstream_base_speed;
+        float m_slipstream_length;
+        float m_slipstream_width;
+        float m_slipstream_inner_factor;
+        float m_slipstream_min_collect_time;
+        float m_slipstream_max_collect_time;
+        float m_slipstream_add_power;
+        float m_slipstream_min_speed;
+        float m_slipstream_max_speed_increase;
+        float m_slipstream_fade_out_time;
+
+        float m_skid_increase;
+        float m_skid_decrease;
+        float m_skid_max;
+        float m_skid_time_till_max;
+        float m_skid_visual;
+        float m_skid_visual_time;
+        float m_skid_revert_visual_time;
+        float m_skid_min_speed;
+        std::vector<float> m_skid_time_till_bonus;
+        std::vector<float> m_skid_bonus_speed;
+        std::vector<float> m_skid_bonus_time;
+        std::vector<float> m_skid_bonus_force;
+        float m_skid_physical_jump_time;
+        float m_skid_graphical_jump_time;
+        float m_skid_post_skid_rotate_factor;
+        float m_skid_reduce_turn_min;
+        float m_skid_reduce_turn_max;
+        bool m_skid_enabled;
+
+        /* <characteristics-end ccdefs> */
     };
 
-    /** All values for a characteristic. A nullptr means it is not set. */
-    std::vector<SaveValue> m_values;
+private:
+    /** The resolved values. */
+    Values m_values;
+
+    /** True for each characteristic that is set in the source. */
+    bool m_is_set[CHARACTERISTIC_COUNT];
 
     /** The characteristics that hold the original values. */
     const AbstractCharacteristic *m_origin;
 
+    // ------------------------------------------------------------------------
+    /** Resolves a single characteristic from the source. */
+    template<typename T>
+    void fetch(CharacteristicType type, T *value)
+    {
+        bool is_set = false;
+        *value = T();
+        m_origin->process(type, value, &is_set);
+        m_is_set[type] = is_set;
+    }   // fetch
+
 public:
     CachedCharacteristic(const AbstractCharacteristic *origin);
     CachedCharacteristic(const CachedCharacteristic &characteristics) = delete;
-    virtual ~CachedCharacteristic();
+    virtual ~CachedCharacteristic() {}
 
     /** Fetches all cached values from the original source. */
     void updateSource();
     virtual void copyFrom(const AbstractCharacteristic *other) { assert(false); }
     virtual void process(CharacteristicType type, Value value, bool *is_set) const;
+    // ------------------------------------------------------------------------
+    /** Returns the resolved values. */
+    const Values& getValues() const { return m_values; }
+    // ------------------------------------------------------------------------
+    /** Returns if the given characteristic is set in the source. */
+    bool isSet(CharacteristicType type) const { return m_is_set[type]; }
 };
 
 #endif
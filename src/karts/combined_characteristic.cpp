@@ -19,6 +19,7 @@
 #include "karts/combined_characteristic.hpp"
 
 #include "io/file_manager.hpp"
+#include "karts/cached_characteristic.hpp"
 #include "karts/xml_characteristic.hpp"
 
 #include <assert.h>
@@ -88,6 +89,19 @@ void CombinedCharacteristic::unitTesting()
     // Note: no operator precedence supported, so (1+2*3) / 3 = 3
     assert( cc->getStabilityRollInfluence()        ==  3.0f );
     assert( cc->getStabilityChassisLinearDamping() ==  7.0f );
+
+    // The cached characteristic must resolve to the same values, and
+    // report characteristics that are not set in any source as unset.
+    CachedCharacteristic *cached = new CachedCharacteristic(cc);
+    assert( cached->getValues().m_suspension_stiffness     ==  5.5f );
+    assert( cached->getValues().m_suspension_rest          == -1.3f );
+    assert( cached->getValues().m_stability_roll_influence ==  3.0f );
+    assert( cached->getSuspensionTravel()          ==  6.0f );
+    float mass;
+    bool is_set = false;
+    cached->process(MASS, &mass, &is_set);
+    assert( !is_set );
+    delete cached;
     delete cc;
 
 }   // unitTesting
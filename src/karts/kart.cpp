@@ -736,7 +736,8 @@ void Kart::createPhysics()
     trans.setIdentity();
     createBody(mass, trans, m_kart_chassis.get(),
                m_kart_properties->getRestitution(0.0f));
-    std::vector<float> ang_fact = m_kart_properties->getStabilityAngularFactor();
+    const std::vector<float>& ang_fact =
+        m_kart_properties->getStabilityAngularFactor();
     // The angular factor (with X and Z values <1) helps to keep the kart
     // upright, especially in case of a collision.
     m_body->setAngularFactor(Vec3(ang_fact[0], ang_fact[1], ang_fact[2]));
@@ -1193,7 +1194,8 @@ float Kart::getStartupBoostFromStartTicks(int ticks) const
     if (ticks_since_ready < 0)
         return 0.0f;
     float t = stk_config->ticks2Time(ticks_since_ready);
-    std::vector<float> startup_times = m_kart_properties->getStartupTime();
+    const std::vector<float>& startup_times =
+        m_kart_properties->getStartupTime();
     for (unsigned int i = 0; i < startup_times.size(); i++)
     {
         if (t <= startup_times[i])
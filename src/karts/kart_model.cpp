@@ -1343,15 +1343,11 @@ void KartModel::initInverseBoneMatrices()
         for (GE::Armature& arm : armatures)
         {
             arm.getInterpolatedMatrices(striaght_frame);
-            for (auto& p : arm.m_world_matrices)
-            {
-                p.second = false;
-            }
+            arm.updateWorldMatrices();
             for (unsigned i = 0; i < arm.m_joint_names.size(); i++)
             {
                 core::matrix4 m;
-                arm.getWorldMatrix(arm.m_interpolated_matrices, i)
-                    .getInverse(m);
+                arm.m_world_matrices[i].getInverse(m);
                 m_inverse_bone_matrices[arm.m_joint_names[i]] = m;
             }
         }
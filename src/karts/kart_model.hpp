@@ -418,6 +418,15 @@ public:
     /** Returns the height of the kart. */
     float getHeight                 () const {return m_kart_height;      }
     // ------------------------------------------------------------------------
+    /** Sets the size of a kart whose models are not loaded (yet), e.g. if
+     *  the size is read from the baked assets cache. */
+    void setSize(float width, float height, float length)
+    {
+        m_kart_width  = width;
+        m_kart_height = height;
+        m_kart_length = length;
+    }   // setSize
+    // ------------------------------------------------------------------------
     /** Highest coordinate on up axis */
     float getHighestPoint           () const { return m_kart_highest_point;  }
     // ------------------------------------------------------------------------
@@ -436,6 +445,8 @@ public:
     /**  Name of the hat mesh to use. */
     void setHatMeshName(const std::string &name) {m_hat_name = name; }
     // ------------------------------------------------------------------------
+    const std::string& getHatMeshName() const { return m_hat_name; }
+    // ------------------------------------------------------------------------
     /** Returns the array of wheel nodes. */
     scene::ISceneNode** getWheelNodes() { return m_wheel_node; }
     // ------------------------------------------------------------------------
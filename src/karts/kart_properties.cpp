@@ -29,6 +29,7 @@
 #include "graphics/stk_tex_manager.hpp"
 #include "graphics/sp/sp_shader_manager.hpp"
 #include "graphics/sp/sp_texture_manager.hpp"
+#include "io/asset_cache.hpp"
 #include "io/file_manager.hpp"
 #include "karts/cached_characteristic.hpp"
 #include "karts/combined_characteristic.hpp"
@@ -39,15 +40,18 @@
 #include "modes/world.hpp"
 #include "io/xml_node.hpp"
 #include "utils/constants.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/translation.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 
 #include <IFileSystem.h>
+#include <IReadFile.h>
 #ifndef SERVER_ONLY
 #include <ge_main.hpp>
 #endif
@@ -70,7 +74,7 @@ std::string KartProperties::getHandicapAsString(HandicapLevel h)
  *  Otherwise the defaults are taken from STKConfig (and since they are all
  *  defined, it is guaranteed that each kart has well defined physics values).
  */
-KartProperties::KartProperties(const std::string &filename)
+KartProperties::KartProperties(const std::string &filename, bool load_model)
 {
     m_is_addon = false;
     m_icon_material = NULL;
@@ -100,10 +104,11 @@ KartProperties::KartProperties(const std::string &filename)
     m_shape                      = 32;  // close enough to a circle.
     m_engine_sfx_type            = "engine_small";
     m_nitro_min_consumption      = 64;
+    m_kart_model_loaded          = false;
     // The default constructor for stk_config uses filename=""
     if (filename != "")
     {
-        load(filename, "kart");
+        load(filename, "kart", load_model);
     }
     else
     {
@@ -214,8 +219,12 @@ void KartProperties::handleOnDemandLoadTexture()
 /** Loads the kart properties from a file.
  *  \param filename Filename to load.
  *  \param node Name of the xml node to load the data from
+ *  \param load_model If false only the size of the kart model is loaded
+ *         (from the baked assets cache if possible), the models themselves
+ *         are loaded later with loadKartModel().
  */
-void KartProperties::load(const std::string &filename, const std::string &node)
+void KartProperties::load(const std::string &filename, const std::string &node,
+                          bool load_model)
 {
     // Get the default values from STKConfig. This will also allocate any
     // pointers used in KartProperties
@@ -268,6 +277,7 @@ void KartProperties::load(const std::string &filename, const std::string &node)
         getAllData(root);
         m_characteristic = std::make_shared<XmlCharacteristic>(root);
         combineCharacteristics(HANDICAP_NONE);
+        checkCharacteristics();
     }
     catch(std::exception& err)
     {
@@ -336,6 +346,50 @@ void KartProperties::load(const std::string &filename, const std::string &node)
     else
         m_minimap_icon = NULL;
 
+    m_shadow_material = material_manager->getMaterialSPM(m_shadow_file, "",
+        "alphablend");
+
+    STKTexManager::getInstance()->unsetTextureErrorMessage();
+    file_manager->popTextureSearchPath();
+    file_manager->popModelSearchPath();
+
+    if (load_model || !loadCachedSize())
+    {
+        loadKartModel();
+        m_kart_model_size[0] = m_kart_model->getWidth();
+        m_kart_model_size[1] = m_kart_model->getHeight();
+        m_kart_model_size[2] = m_kart_model->getLength();
+        initModelSizeValues();
+        if (!load_model)
+        {
+            std::string data((const char*)m_kart_model_size, sizeof(float) * 3);
+            AssetCache::save("kart-size", getModelHash(), data);
+        }
+    }
+
+#ifndef SERVER_ONLY
+    if (GE::getDriver()->getDriverType() == video::EDT_VULKAN)
+        GE::getGEConfig()->m_ondemand_load_texture_paths.clear();
+#endif
+}   // load
+
+//-----------------------------------------------------------------------------
+/** Loads the models of this kart (if not done already). The size of the
+ *  kart model and the values depending on it are only set once in load(),
+ *  since they are read by the network thread (see getKartWidth()) while the
+ *  models are loaded and unloaded on demand.
+ */
+void KartProperties::loadKartModel()
+{
+    if (m_kart_model_loaded)
+        return;
+
+    std::string unique_id = StringUtils::insertValues("karts/%s", m_ident.c_str());
+    file_manager->pushModelSearchPath(m_root);
+    file_manager->pushTextureSearchPath(m_root, unique_id);
+    STKTexManager::getInstance()
+        ->setTextureErrorMessage("Error while loading kart '%s':", m_name);
+
     // Only load the model if the .kart file has the appropriate version,
     // otherwise warnings are printed.
     if (m_version >= 1)
@@ -343,39 +397,119 @@ void KartProperties::load(const std::string &filename, const std::string &node)
         const bool success = m_kart_model->loadModels(*this);
         if (!success)
         {
+            STKTexManager::getInstance()->unsetTextureErrorMessage();
             file_manager->popTextureSearchPath();
             file_manager->popModelSearchPath();
             throw std::runtime_error("Cannot load kart models");
         }
     }
+    STKTexManager::getInstance()->unsetTextureErrorMessage();
+    file_manager->popTextureSearchPath();
+    file_manager->popModelSearchPath();
+
+    m_kart_model_loaded = true;
+}   // loadKartModel
+
+//-----------------------------------------------------------------------------
+/** Frees the models of this kart, only the size of the kart model is kept.
+ *  Karts in a race which still use the models keep them alive.
+ */
+void KartProperties::unloadKartModel()
+{
+    if (!m_kart_model_loaded)
+        return;
 
+    const XMLNode* root = new XMLNode(m_root + "kart.xml");
+    std::shared_ptr<KartModel> kart_model =
+        std::make_shared<KartModel>(/*is_master*/true);
+    kart_model->loadInfo(*root);
+    delete root;
+    kart_model->setHatMeshName(m_kart_model->getHatMeshName());
+    kart_model->setSize(m_kart_model_size[0], m_kart_model_size[1],
+        m_kart_model_size[2]);
+    m_kart_model = kart_model;
+    m_kart_model_loaded = false;
+}   // unloadKartModel
+
+//-----------------------------------------------------------------------------
+/** Sets the default values which depend on the size of the kart model
+ *  (center of gravity shift and wheel base).
+ */
+void KartProperties::initModelSizeValues()
+{
     if(m_gravity_center_shift.getX()==UNDEFINED)
     {
         m_gravity_center_shift.setX(0);
         // Default: center at the very bottom of the kart.
         // If the kart is 'too high', its height will be changed in
         // kart.cpp, the same adjustment needs to be made here.
-        if (m_kart_model->getHeight() > m_kart_model->getLength()*0.6f)
-            m_gravity_center_shift.setY(m_kart_model->getLength()*0.6f*0.5f);
+        if (getKartHeight() > getKartLength()*0.6f)
+            m_gravity_center_shift.setY(getKartLength()*0.6f*0.5f);
         else
-            m_gravity_center_shift.setY(m_kart_model->getHeight()*0.5f);
+            m_gravity_center_shift.setY(getKartHeight()*0.5f);
 
         m_gravity_center_shift.setZ(0);
     }
 
-    setWheelBase(m_kart_model->getLength());
-    m_shadow_material = material_manager->getMaterialSPM(m_shadow_file, "",
-        "alphablend");
+    setWheelBase(getKartLength());
+}   // initModelSizeValues
 
-    STKTexManager::getInstance()->unsetTextureErrorMessage();
-    file_manager->popTextureSearchPath();
-    file_manager->popModelSearchPath();
+//-----------------------------------------------------------------------------
+/** Returns a hash of the names, sizes and modification times of the kart
+ *  config and all meshes of this kart, which identifies the cached size of
+ *  the kart model. Only the directory and the file status are read, so this
+ *  is cheap even for many karts.
+ */
+uint64_t KartProperties::getModelHash() const
+{
+    std::set<std::string> files;
+    file_manager->listFiles(files, m_root);
+    uint64_t hash = AssetCache::hash(m_ident.data(), m_ident.size());
+    for (const std::string& f : files)
+    {
+        std::string ext = StringUtils::toLowerCase(StringUtils::getExtension(f));
+        if (ext != "xml" && ext != "spm" && ext != "b3d")
+            continue;
+        hash = AssetCache::hash(f.data(), f.size(), hash);
+        // Files in archives have no status, use their size only
+        uint64_t info[2] = { 0, 0 };
+        struct stat st;
+        if (FileUtils::statU8Path(m_root + f, &st) == 0)
+        {
+            info[0] = (uint64_t)st.st_size;
+            info[1] = (uint64_t)st.st_mtime;
+        }
+        else
+        {
+            io::IReadFile* file = file_manager->getFileSystem()
+                ->createAndOpenFile((m_root + f).c_str());
+            if (!file)
+                continue;
+            info[0] = (uint64_t)file->getSize();
+            file->drop();
+        }
+        hash = AssetCache::hash(info, sizeof(info), hash);
+    }
+    return hash;
+}   // getModelHash
 
-#ifndef SERVER_ONLY
-    if (GE::getDriver()->getDriverType() == video::EDT_VULKAN)
-        GE::getGEConfig()->m_ondemand_load_texture_paths.clear();
-#endif
-}   // load
+//-----------------------------------------------------------------------------
+/** Reads the size of the kart model from the baked assets cache without
+ *  loading the models.
+ *  \return True if the size was found in the cache.
+ */
+bool KartProperties::loadCachedSize()
+{
+    std::string data;
+    if (!AssetCache::load("kart-size", getModelHash(), &data) ||
+        data.size() != sizeof(float) * 3)
+        return false;
+    memcpy(m_kart_model_size, data.data(), data.size());
+    m_kart_model->setSize(m_kart_model_size[0], m_kart_model_size[1],
+        m_kart_model_size[2]);
+    initModelSizeValues();
+    return true;
+}   // loadCachedSize
 
 // ----------------------------------------------------------------------------
 /** Returns a pointer to the KartModel object.
@@ -446,6 +580,33 @@ void KartProperties::combineCharacteristics(HandicapLevel handicap)
         (m_combined_characteristic.get());
 }   // combineCharacteristics
 
+//-----------------------------------------------------------------------------
+/** The getters access the resolved characteristics without checking, so
+ *  this reports all characteristics that are not set for this kart once,
+ *  when the kart is loaded. Their value is 0 (false or empty for other
+ *  types).
+ */
+void KartProperties::checkCharacteristics() const
+{
+    std::string missing;
+    for (int i = 0; i < AbstractCharacteristic::CHARACTERISTIC_COUNT; i++)
+    {
+        AbstractCharacteristic::CharacteristicType type =
+            static_cast<AbstractCharacteristic::CharacteristicType>(i);
+        if (m_cached_characteristic->isSet(type))
+            continue;
+        if (!missing.empty())
+            missing += ", ";
+        missing += AbstractCharacteristic::getName(type);
+    }
+    if (!missing.empty())
+    {
+        Log::error("KartProperties", "Kart '%s' does not set the "
+                   "characteristics %s, using 0 for them.", m_ident.c_str(),
+                   missing.c_str());
+    }
+}   // checkCharacteristics
+
 //-----------------------------------------------------------------------------
 /** Actually reads in the data from the xml file.
  *  \param root Root of the xml tree.
@@ -536,7 +697,8 @@ void KartProperties::getAllData(const XMLNode * root)
                 skid_node->get("max_dist", &max_dist);
                 skid_node->get("volume", &gain);
                 SFXManager::get()->addSingleSfx(m_skid_sound, full_path,
-                    true/*positional*/, rolloff, max_dist, gain);
+                    true/*positional*/, rolloff, max_dist, gain,
+                    false/*load*/);
             }
             else if (custom_skid_sound == "default")
             {
@@ -563,7 +725,8 @@ void KartProperties::getAllData(const XMLNode * root)
                 sounds_node->get("max_dist", &max_dist);
                 sounds_node->get("volume", &gain);
                 SFXManager::get()->addSingleSfx(m_engine_sfx_type, full_path,
-                    true/*positional*/, rolloff, max_dist, gain);
+                    true/*positional*/, rolloff, max_dist, gain,
+                    false/*load*/);
             }
             else
             {
@@ -692,12 +855,11 @@ bool KartProperties::isInGroup(const std::string &group) const
  *  e.g. for use in kart selection. */
 float KartProperties::getAccelerationEfficiency() const
 {
-    std::vector<float> gear_power_increase = m_combined_characteristic->getGearPowerIncrease();
-    std::vector<float> gear_switch_ratio = m_combined_characteristic->getGearSwitchRatio();
+    const std::vector<float>& gear_power_increase = getGearPowerIncrease();
+    const std::vector<float>& gear_switch_ratio = getGearSwitchRatio();
     unsigned current_gear = 0;
     float sum = 0;
-    float base_accel = m_combined_characteristic->getEnginePower()
-                     / m_combined_characteristic->getMass();
+    float base_accel = getEnginePower() / getMass();
 
     // We evaluate acceleration at increments of 0.01x max speed
     // up to 1,1x max speed.
@@ -730,643 +892,643 @@ core::stringw KartProperties::getName() const
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionStiffness() const
 {
-    return m_cached_characteristic->getSuspensionStiffness();
+    return m_cached_characteristic->getValues().m_suspension_stiffness;
 }  // getSuspensionStiffness
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionRest() const
 {
-    return m_cached_characteristic->getSuspensionRest();
+    return m_cached_characteristic->getValues().m_suspension_rest;
 }  // getSuspensionRest
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionTravel() const
 {
-    return m_cached_characteristic->getSuspensionTravel();
+    return m_cached_characteristic->getValues().m_suspension_travel;
 }  // getSuspensionTravel
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSuspensionExpSpringResponse() const
 {
-    return m_cached_characteristic->getSuspensionExpSpringResponse();
+    return m_cached_characteristic->getValues().m_suspension_exp_spring_response;
 }  // getSuspensionExpSpringResponse
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionMaxForce() const
 {
-    return m_cached_characteristic->getSuspensionMaxForce();
+    return m_cached_characteristic->getValues().m_suspension_max_force;
 }  // getSuspensionMaxForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityRollInfluence() const
 {
-    return m_cached_characteristic->getStabilityRollInfluence();
+    return m_cached_characteristic->getValues().m_stability_roll_influence;
 }  // getStabilityRollInfluence
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisLinearDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisLinearDamping();
+    return m_cached_characteristic->getValues().m_stability_chassis_linear_damping;
 }  // getStabilityChassisLinearDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisAngularDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisAngularDamping();
+    return m_cached_characteristic->getValues().m_stability_chassis_angular_damping;
 }  // getStabilityChassisAngularDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityDownwardImpulseFactor() const
 {
-    return m_cached_characteristic->getStabilityDownwardImpulseFactor();
+    return m_cached_characteristic->getValues().m_stability_downward_impulse_factor;
 }  // getStabilityDownwardImpulseFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityTrackConnectionAccel() const
 {
-    return m_cached_characteristic->getStabilityTrackConnectionAccel();
+    return m_cached_characteristic->getValues().m_stability_track_connection_accel;
 }  // getStabilityTrackConnectionAccel
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStabilityAngularFactor() const
+const std::vector<float>& KartProperties::getStabilityAngularFactor() const
 {
-    return m_cached_characteristic->getStabilityAngularFactor();
+    return m_cached_characteristic->getValues().m_stability_angular_factor;
 }  // getStabilityAngularFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilitySmoothFlyingImpulse() const
 {
-    return m_cached_characteristic->getStabilitySmoothFlyingImpulse();
+    return m_cached_characteristic->getValues().m_stability_smooth_flying_impulse;
 }  // getStabilitySmoothFlyingImpulse
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnRadius() const
+const InterpolationArray& KartProperties::getTurnRadius() const
 {
-    return m_cached_characteristic->getTurnRadius();
+    return m_cached_characteristic->getValues().m_turn_radius;
 }  // getTurnRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getTurnTimeResetSteer() const
 {
-    return m_cached_characteristic->getTurnTimeResetSteer();
+    return m_cached_characteristic->getValues().m_turn_time_reset_steer;
 }  // getTurnTimeResetSteer
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnTimeFullSteer() const
+const InterpolationArray& KartProperties::getTurnTimeFullSteer() const
 {
-    return m_cached_characteristic->getTurnTimeFullSteer();
+    return m_cached_characteristic->getValues().m_turn_time_full_steer;
 }  // getTurnTimeFullSteer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEnginePower() const
 {
-    return m_cached_characteristic->getEnginePower();
+    return m_cached_characteristic->getValues().m_engine_power;
 }  // getEnginePower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineMaxSpeed();
+    return m_cached_characteristic->getValues().m_engine_max_speed;
 }  // getEngineMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineGenericMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineGenericMaxSpeed();
+    return m_cached_characteristic->getValues().m_engine_generic_max_speed;
 }  // getEngineGenericMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeFactor() const
 {
-    return m_cached_characteristic->getEngineBrakeFactor();
+    return m_cached_characteristic->getValues().m_engine_brake_factor;
 }  // getEngineBrakeFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeTimeIncrease() const
 {
-    return m_cached_characteristic->getEngineBrakeTimeIncrease();
+    return m_cached_characteristic->getValues().m_engine_brake_time_increase;
 }  // getEngineBrakeTimeIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeedReverseRatio() const
 {
-    return m_cached_characteristic->getEngineMaxSpeedReverseRatio();
+    return m_cached_characteristic->getValues().m_engine_max_speed_reverse_ratio;
 }  // getEngineMaxSpeedReverseRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearSwitchRatio() const
+const std::vector<float>& KartProperties::getGearSwitchRatio() const
 {
-    return m_cached_characteristic->getGearSwitchRatio();
+    return m_cached_characteristic->getValues().m_gear_switch_ratio;
 }  // getGearSwitchRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearPowerIncrease() const
+const std::vector<float>& KartProperties::getGearPowerIncrease() const
 {
-    return m_cached_characteristic->getGearPowerIncrease();
+    return m_cached_characteristic->getValues().m_gear_power_increase;
 }  // getGearPowerIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getMass() const
 {
-    return m_cached_characteristic->getMass();
+    return m_cached_characteristic->getValues().m_mass;
 }  // getMass
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingRelaxation() const
 {
-    return m_cached_characteristic->getWheelsDampingRelaxation();
+    return m_cached_characteristic->getValues().m_wheels_damping_relaxation;
 }  // getWheelsDampingRelaxation
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingCompression() const
 {
-    return m_cached_characteristic->getWheelsDampingCompression();
+    return m_cached_characteristic->getValues().m_wheels_damping_compression;
 }  // getWheelsDampingCompression
 
 // ----------------------------------------------------------------------------
 float KartProperties::getJumpAnimationTime() const
 {
-    return m_cached_characteristic->getJumpAnimationTime();
+    return m_cached_characteristic->getValues().m_jump_animation_time;
 }  // getJumpAnimationTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanMax() const
 {
-    return m_cached_characteristic->getLeanMax();
+    return m_cached_characteristic->getValues().m_lean_max;
 }  // getLeanMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanSpeed() const
 {
-    return m_cached_characteristic->getLeanSpeed();
+    return m_cached_characteristic->getValues().m_lean_speed;
 }  // getLeanSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilDuration() const
 {
-    return m_cached_characteristic->getAnvilDuration();
+    return m_cached_characteristic->getValues().m_anvil_duration;
 }  // getAnvilDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilWeight() const
 {
-    return m_cached_characteristic->getAnvilWeight();
+    return m_cached_characteristic->getValues().m_anvil_weight;
 }  // getAnvilWeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilSpeedFactor() const
 {
-    return m_cached_characteristic->getAnvilSpeedFactor();
+    return m_cached_characteristic->getValues().m_anvil_speed_factor;
 }  // getAnvilSpeedFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteFriction() const
 {
-    return m_cached_characteristic->getParachuteFriction();
+    return m_cached_characteristic->getValues().m_parachute_friction;
 }  // getParachuteFriction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDuration() const
 {
-    return m_cached_characteristic->getParachuteDuration();
+    return m_cached_characteristic->getValues().m_parachute_duration;
 }  // getParachuteDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationOther() const
 {
-    return m_cached_characteristic->getParachuteDurationOther();
+    return m_cached_characteristic->getValues().m_parachute_duration_other;
 }  // getParachuteDurationOther
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationRankMult() const
 {
-    return m_cached_characteristic->getParachuteDurationRankMult();
+    return m_cached_characteristic->getValues().m_parachute_duration_rank_mult;
 }  // getParachuteDurationRankMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationSpeedMult() const
 {
-    return m_cached_characteristic->getParachuteDurationSpeedMult();
+    return m_cached_characteristic->getValues().m_parachute_duration_speed_mult;
 }  // getParachuteDurationSpeedMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteLboundFraction() const
 {
-    return m_cached_characteristic->getParachuteLboundFraction();
+    return m_cached_characteristic->getValues().m_parachute_lbound_fraction;
 }  // getParachuteLboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteUboundFraction() const
 {
-    return m_cached_characteristic->getParachuteUboundFraction();
+    return m_cached_characteristic->getValues().m_parachute_ubound_fraction;
 }  // getParachuteUboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteMaxSpeed() const
 {
-    return m_cached_characteristic->getParachuteMaxSpeed();
+    return m_cached_characteristic->getValues().m_parachute_max_speed;
 }  // getParachuteMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getFrictionKartFriction() const
 {
-    return m_cached_characteristic->getFrictionKartFriction();
+    return m_cached_characteristic->getValues().m_friction_kart_friction;
 }  // getFrictionKartFriction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumDuration() const
 {
-    return m_cached_characteristic->getBubblegumDuration();
+    return m_cached_characteristic->getValues().m_bubblegum_duration;
 }  // getBubblegumDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumSpeedFraction() const
 {
-    return m_cached_characteristic->getBubblegumSpeedFraction();
+    return m_cached_characteristic->getValues().m_bubblegum_speed_fraction;
 }  // getBubblegumSpeedFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumTorque() const
 {
-    return m_cached_characteristic->getBubblegumTorque();
+    return m_cached_characteristic->getValues().m_bubblegum_torque;
 }  // getBubblegumTorque
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumFadeInTime() const
 {
-    return m_cached_characteristic->getBubblegumFadeInTime();
+    return m_cached_characteristic->getValues().m_bubblegum_fade_in_time;
 }  // getBubblegumFadeInTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumShieldDuration() const
 {
-    return m_cached_characteristic->getBubblegumShieldDuration();
+    return m_cached_characteristic->getValues().m_bubblegum_shield_duration;
 }  // getBubblegumShieldDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperDuration() const
 {
-    return m_cached_characteristic->getZipperDuration();
+    return m_cached_characteristic->getValues().m_zipper_duration;
 }  // getZipperDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperForce() const
 {
-    return m_cached_characteristic->getZipperForce();
+    return m_cached_characteristic->getValues().m_zipper_force;
 }  // getZipperForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperSpeedGain() const
 {
-    return m_cached_characteristic->getZipperSpeedGain();
+    return m_cached_characteristic->getValues().m_zipper_speed_gain;
 }  // getZipperSpeedGain
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getZipperMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_zipper_max_speed_increase;
 }  // getZipperMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperFadeOutTime() const
 {
-    return m_cached_characteristic->getZipperFadeOutTime();
+    return m_cached_characteristic->getValues().m_zipper_fade_out_time;
 }  // getZipperFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDuration() const
 {
-    return m_cached_characteristic->getSwatterDuration();
+    return m_cached_characteristic->getValues().m_swatter_duration;
 }  // getSwatterDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDistance() const
 {
-    return m_cached_characteristic->getSwatterDistance();
+    return m_cached_characteristic->getValues().m_swatter_distance;
 }  // getSwatterDistance
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashDuration() const
 {
-    return m_cached_characteristic->getSwatterSquashDuration();
+    return m_cached_characteristic->getValues().m_swatter_squash_duration;
 }  // getSwatterSquashDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashSlowdown() const
 {
-    return m_cached_characteristic->getSwatterSquashSlowdown();
+    return m_cached_characteristic->getValues().m_swatter_squash_slowdown;
 }  // getSwatterSquashSlowdown
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandMaxLength() const
 {
-    return m_cached_characteristic->getPlungerBandMaxLength();
+    return m_cached_characteristic->getValues().m_plunger_band_max_length;
 }  // getPlungerBandMaxLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandForce() const
 {
-    return m_cached_characteristic->getPlungerBandForce();
+    return m_cached_characteristic->getValues().m_plunger_band_force;
 }  // getPlungerBandForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandDuration() const
 {
-    return m_cached_characteristic->getPlungerBandDuration();
+    return m_cached_characteristic->getValues().m_plunger_band_duration;
 }  // getPlungerBandDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandSpeedIncrease() const
 {
-    return m_cached_characteristic->getPlungerBandSpeedIncrease();
+    return m_cached_characteristic->getValues().m_plunger_band_speed_increase;
 }  // getPlungerBandSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandFadeOutTime() const
 {
-    return m_cached_characteristic->getPlungerBandFadeOutTime();
+    return m_cached_characteristic->getValues().m_plunger_band_fade_out_time;
 }  // getPlungerBandFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerInFaceTime() const
 {
-    return m_cached_characteristic->getPlungerInFaceTime();
+    return m_cached_characteristic->getValues().m_plunger_in_face_time;
 }  // getPlungerInFaceTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupTime() const
+const std::vector<float>& KartProperties::getStartupTime() const
 {
-    return m_cached_characteristic->getStartupTime();
+    return m_cached_characteristic->getValues().m_startup_time;
 }  // getStartupTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupBoost() const
+const std::vector<float>& KartProperties::getStartupBoost() const
 {
-    return m_cached_characteristic->getStartupBoost();
+    return m_cached_characteristic->getValues().m_startup_boost;
 }  // getStartupBoost
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueDuration() const
 {
-    return m_cached_characteristic->getRescueDuration();
+    return m_cached_characteristic->getValues().m_rescue_duration;
 }  // getRescueDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueVertOffset() const
 {
-    return m_cached_characteristic->getRescueVertOffset();
+    return m_cached_characteristic->getValues().m_rescue_vert_offset;
 }  // getRescueVertOffset
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueHeight() const
 {
-    return m_cached_characteristic->getRescueHeight();
+    return m_cached_characteristic->getValues().m_rescue_height;
 }  // getRescueHeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionDuration() const
 {
-    return m_cached_characteristic->getExplosionDuration();
+    return m_cached_characteristic->getValues().m_explosion_duration;
 }  // getExplosionDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionRadius() const
 {
-    return m_cached_characteristic->getExplosionRadius();
+    return m_cached_characteristic->getValues().m_explosion_radius;
 }  // getExplosionRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionInvulnerabilityTime() const
 {
-    return m_cached_characteristic->getExplosionInvulnerabilityTime();
+    return m_cached_characteristic->getValues().m_explosion_invulnerability_time;
 }  // getExplosionInvulnerabilityTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroDuration() const
 {
-    return m_cached_characteristic->getNitroDuration();
+    return m_cached_characteristic->getValues().m_nitro_duration;
 }  // getNitroDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroEngineForce() const
 {
-    return m_cached_characteristic->getNitroEngineForce();
+    return m_cached_characteristic->getValues().m_nitro_engine_force;
 }  // getNitroEngineForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroEngineMult() const
 {
-    return m_cached_characteristic->getNitroEngineMult();
+    return m_cached_characteristic->getValues().m_nitro_engine_mult;
 }  // getNitroEngineMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroConsumption() const
 {
-    return m_cached_characteristic->getNitroConsumption();
+    return m_cached_characteristic->getValues().m_nitro_consumption;
 }  // getNitroConsumption
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroSmallContainer() const
 {
-    return m_cached_characteristic->getNitroSmallContainer();
+    return m_cached_characteristic->getValues().m_nitro_small_container;
 }  // getNitroSmallContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroBigContainer() const
 {
-    return m_cached_characteristic->getNitroBigContainer();
+    return m_cached_characteristic->getValues().m_nitro_big_container;
 }  // getNitroBigContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getNitroMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_nitro_max_speed_increase;
 }  // getNitroMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroFadeOutTime() const
 {
-    return m_cached_characteristic->getNitroFadeOutTime();
+    return m_cached_characteristic->getValues().m_nitro_fade_out_time;
 }  // getNitroFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMax() const
 {
-    return m_cached_characteristic->getNitroMax();
+    return m_cached_characteristic->getValues().m_nitro_max;
 }  // getNitroMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamDurationFactor() const
 {
-    return m_cached_characteristic->getSlipstreamDurationFactor();
+    return m_cached_characteristic->getValues().m_slipstream_duration_factor;
 }  // getSlipstreamDurationFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamBaseSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamBaseSpeed();
+    return m_cached_characteristic->getValues().m_slipstream_base_speed;
 }  // getSlipstreamBaseSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamLength() const
 {
-    return m_cached_characteristic->getSlipstreamLength();
+    return m_cached_characteristic->getValues().m_slipstream_length;
 }  // getSlipstreamLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamWidth() const
 {
-    return m_cached_characteristic->getSlipstreamWidth();
+    return m_cached_characteristic->getValues().m_slipstream_width;
 }  // getSlipstreamWidth
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamInnerFactor() const
 {
-    return m_cached_characteristic->getSlipstreamInnerFactor();
+    return m_cached_characteristic->getValues().m_slipstream_inner_factor;
 }  // getSlipstreamInnerFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMinCollectTime();
+    return m_cached_characteristic->getValues().m_slipstream_min_collect_time;
 }  // getSlipstreamMinCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMaxCollectTime();
+    return m_cached_characteristic->getValues().m_slipstream_max_collect_time;
 }  // getSlipstreamMaxCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamAddPower() const
 {
-    return m_cached_characteristic->getSlipstreamAddPower();
+    return m_cached_characteristic->getValues().m_slipstream_add_power;
 }  // getSlipstreamAddPower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamMinSpeed();
+    return m_cached_characteristic->getValues().m_slipstream_min_speed;
 }  // getSlipstreamMinSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getSlipstreamMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_slipstream_max_speed_increase;
 }  // getSlipstreamMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamFadeOutTime() const
 {
-    return m_cached_characteristic->getSlipstreamFadeOutTime();
+    return m_cached_characteristic->getValues().m_slipstream_fade_out_time;
 }  // getSlipstreamFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidIncrease() const
 {
-    return m_cached_characteristic->getSkidIncrease();
+    return m_cached_characteristic->getValues().m_skid_increase;
 }  // getSkidIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidDecrease() const
 {
-    return m_cached_characteristic->getSkidDecrease();
+    return m_cached_characteristic->getValues().m_skid_decrease;
 }  // getSkidDecrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMax() const
 {
-    return m_cached_characteristic->getSkidMax();
+    return m_cached_characteristic->getValues().m_skid_max;
 }  // getSkidMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidTimeTillMax() const
 {
-    return m_cached_characteristic->getSkidTimeTillMax();
+    return m_cached_characteristic->getValues().m_skid_time_till_max;
 }  // getSkidTimeTillMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisual() const
 {
-    return m_cached_characteristic->getSkidVisual();
+    return m_cached_characteristic->getValues().m_skid_visual;
 }  // getSkidVisual
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisualTime() const
 {
-    return m_cached_characteristic->getSkidVisualTime();
+    return m_cached_characteristic->getValues().m_skid_visual_time;
 }  // getSkidVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidRevertVisualTime() const
 {
-    return m_cached_characteristic->getSkidRevertVisualTime();
+    return m_cached_characteristic->getValues().m_skid_revert_visual_time;
 }  // getSkidRevertVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMinSpeed() const
 {
-    return m_cached_characteristic->getSkidMinSpeed();
+    return m_cached_characteristic->getValues().m_skid_min_speed;
 }  // getSkidMinSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidTimeTillBonus() const
+const std::vector<float>& KartProperties::getSkidTimeTillBonus() const
 {
-    return m_cached_characteristic->getSkidTimeTillBonus();
+    return m_cached_characteristic->getValues().m_skid_time_till_bonus;
 }  // getSkidTimeTillBonus
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusSpeed() const
+const std::vector<float>& KartProperties::getSkidBonusSpeed() const
 {
-    return m_cached_characteristic->getSkidBonusSpeed();
+    return m_cached_characteristic->getValues().m_skid_bonus_speed;
 }  // getSkidBonusSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusTime() const
+const std::vector<float>& KartProperties::getSkidBonusTime() const
 {
-    return m_cached_characteristic->getSkidBonusTime();
+    return m_cached_characteristic->getValues().m_skid_bonus_time;
 }  // getSkidBonusTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusForce() const
+const std::vector<float>& KartProperties::getSkidBonusForce() const
 {
-    return m_cached_characteristic->getSkidBonusForce();
+    return m_cached_characteristic->getValues().m_skid_bonus_force;
 }  // getSkidBonusForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPhysicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidPhysicalJumpTime();
+    return m_cached_characteristic->getValues().m_skid_physical_jump_time;
 }  // getSkidPhysicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidGraphicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidGraphicalJumpTime();
+    return m_cached_characteristic->getValues().m_skid_graphical_jump_time;
 }  // getSkidGraphicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPostSkidRotateFactor() const
 {
-    return m_cached_characteristic->getSkidPostSkidRotateFactor();
+    return m_cached_characteristic->getValues().m_skid_post_skid_rotate_factor;
 }  // getSkidPostSkidRotateFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMin() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMin();
+    return m_cached_characteristic->getValues().m_skid_reduce_turn_min;
 }  // getSkidReduceTurnMin
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMax() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMax();
+    return m_cached_characteristic->getValues().m_skid_reduce_turn_max;
 }  // getSkidReduceTurnMax
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSkidEnabled() const
 {
-    return m_cached_characteristic->getSkidEnabled();
+    return m_cached_characteristic->getValues().m_skid_enabled;
 }  // getSkidEnabled
 
 
@@ -83,6 +83,15 @@ private:
      *  the kart_properties object is const. */
     mutable std::shared_ptr<KartModel> m_kart_model;
 
+    /** True if the meshes of m_kart_model are loaded, otherwise only the
+     *  size of the kart model is known. */
+    bool m_kart_model_loaded;
+
+    /** Width, height and length of the kart model. They are set once when
+     *  the kart is loaded and never changed when the models are loaded or
+     *  unloaded on demand, so they can be read from any thread. */
+    float m_kart_model_size[3];
+
     /** List of all groups the kart belongs to. */
     std::vector<std::string> m_groups;
 
@@ -197,8 +206,13 @@ private:
     InterpolationArray m_restitution;
 
     void  load              (const std::string &filename,
-                             const std::string &node);
+                             const std::string &node,
+                             bool load_model = true);
+    void  initModelSizeValues();
+    uint64_t getModelHash   () const;
+    bool  loadCachedSize    ();
     void combineCharacteristics(HandicapLevel h);
+    void checkCharacteristics() const;
 
     void setWheelBase(float kart_length)
     {
@@ -215,8 +229,11 @@ public:
     /** Returns the string representation of a handicap level. */
     static std::string      getHandicapAsString(HandicapLevel h);
 
-          KartProperties    (const std::string &filename="");
+          KartProperties    (const std::string &filename="",
+                             bool load_model = true);
          ~KartProperties    ();
+    void  loadKartModel     ();
+    void  unloadKartModel   ();
     void  copyForPlayer     (const KartProperties *source,
                              HandicapLevel h = HANDICAP_NONE);
     void  adjustForOnlineAddonKart(const KartProperties* source);
@@ -264,6 +281,22 @@ public:
      *  should not be modified, not attachModel be called on it. */
     const KartModel& getMasterKartModel() const {return *m_kart_model;        }
     // ------------------------------------------------------------------------
+    /** Returns the width of the kart model, which is known even if the
+     *  models are not loaded. */
+    float getKartWidth() const { return m_kart_model_size[0]; }
+    // ------------------------------------------------------------------------
+    /** Returns the height of the kart model. */
+    float getKartHeight() const { return m_kart_model_size[1]; }
+    // ------------------------------------------------------------------------
+    /** Returns the length of the kart model. */
+    float getKartLength() const { return m_kart_model_size[2]; }
+    // ------------------------------------------------------------------------
+    /** Returns true if the meshes of the kart model are loaded. */
+    bool isKartModelLoaded() const { return m_kart_model_loaded; }
+    // ------------------------------------------------------------------------
+    /** Returns true if karts (e.g. in a race) share the kart model. */
+    bool isKartModelInUse() const { return m_kart_model.use_count() > 1; }
+    // ------------------------------------------------------------------------
     void setHatMeshName(const std::string &hat_name);
     // ------------------------------------------------------------------------
     core::stringw getName() const;
@@ -407,12 +440,12 @@ public:
     float getStabilityChassisAngularDamping() const;
     float getStabilityDownwardImpulseFactor() const;
     float getStabilityTrackConnectionAccel() const;
-    std::vector<float> getStabilityAngularFactor() const;
+    const std::vector<float>& getStabilityAngularFactor() const;
     float getStabilitySmoothFlyingImpulse() const;
 
-    InterpolationArray getTurnRadius() const;
+    const InterpolationArray& getTurnRadius() const;
     float getTurnTimeResetSteer() const;
-    InterpolationArray getTurnTimeFullSteer() const;
+    const InterpolationArray& getTurnTimeFullSteer() const;
 
     float getEnginePower() const;
     float getEngineMaxSpeed() const;
@@ -421,8 +454,8 @@ public:
     float getEngineBrakeTimeIncrease() const;
     float getEngineMaxSpeedReverseRatio() const;
 
-    std::vector<float> getGearSwitchRatio() const;
-    std::vector<float> getGearPowerIncrease() const;
+    const std::vector<float>& getGearSwitchRatio() const;
+    const std::vector<float>& getGearPowerIncrease() const;
 
     float getMass() const;
 
@@ -473,8 +506,8 @@ public:
     float getPlungerBandFadeOutTime() const;
     float getPlungerInFaceTime() const;
 
-    std::vector<float> getStartupTime() const;
-    std::vector<float> getStartupBoost() const;
+    const std::vector<float>& getStartupTime() const;
+    const std::vector<float>& getStartupBoost() const;
 
     float getRescueDuration() const;
     float getRescueVertOffset() const;
@@ -514,10 +547,10 @@ public:
     float getSkidVisualTime() const;
     float getSkidRevertVisualTime() const;
     float getSkidMinSpeed() const;
-    std::vector<float> getSkidTimeTillBonus() const;
-    std::vector<float> getSkidBonusSpeed() const;
-    std::vector<float> getSkidBonusTime() const;
-    std::vector<float> getSkidBonusForce() const;
+    const std::vector<float>& getSkidTimeTillBonus() const;
+    const std::vector<float>& getSkidBonusSpeed() const;
+    const std::vector<float>& getSkidBonusTime() const;
+    const std::vector<float>& getSkidBonusForce() const;
     float getSkidPhysicalJumpTime() const;
     float getSkidGraphicalJumpTime() const;
     float getSkidPostSkidRotateFactor() const;
@@ -53,6 +53,7 @@ std::vector<std::string> KartPropertiesManager::m_kart_search_path;
 KartPropertiesManager::KartPropertiesManager()
 {
     m_all_groups.clear();
+    m_max_loaded_karts = 0;
 }   // KartPropertiesManager
 
 //-----------------------------------------------------------------------------
@@ -90,6 +91,7 @@ void KartPropertiesManager::unloadAllKarts()
     m_kart_available.clear();
     m_groups_2_indices.clear();
     m_all_groups.clear();
+    m_loaded_karts.clear();
 }   // unloadAllKarts
 
 //-----------------------------------------------------------------------------
@@ -148,6 +150,7 @@ void KartPropertiesManager::removeKart(const std::string &ident)
         }
     }
 
+    m_loaded_karts.remove(ident);
     delete kp;
 
     // Only used for networking and it is safe to just clear it.
@@ -156,7 +159,9 @@ void KartPropertiesManager::removeKart(const std::string &ident)
 }   // removeKart
 
 //-----------------------------------------------------------------------------
-/** Loads all kart properties and models.
+/** Loads all kart properties and models. If the number of loaded karts is
+ *  limited (see setMaxLoadedKarts) only the kart properties and the size of
+ *  each kart model are loaded, the models are loaded on demand later.
  */
 void KartPropertiesManager::loadAllKarts(bool loading_icon)
 {
@@ -186,6 +191,11 @@ void KartPropertiesManager::loadAllKarts(bool loading_icon)
             }
         }   // for all files in the currently handled directory
     }   // for i
+
+    // Tux is used as fallback for unknown karts and for the hitbox of addon
+    // karts, so it always needs its models
+    if (m_max_loaded_karts > 0)
+        onDemandLoadKartModels({ "tux" });
 }   // loadAllKarts
 
 //-----------------------------------------------------------------------------
@@ -258,7 +268,8 @@ bool KartPropertiesManager::loadKart(const std::string &dir)
     KartProperties* kart_properties;
     try
     {
-        kart_properties = new KartProperties(config_filename);
+        kart_properties = new KartProperties(config_filename,
+            /*load_model*/m_max_loaded_karts == 0);
     }
     catch (std::runtime_error& err)
     {
@@ -291,9 +302,76 @@ bool KartPropertiesManager::loadKart(const std::string &dir)
         m_groups_2_indices[groups[g]].push_back(m_karts_properties.size()-1);
     }
     m_all_kart_dirs.push_back(dir);
+
+    // If the size was not cached the models had to be loaded
+    if (m_max_loaded_karts > 0 && kart_properties->isKartModelLoaded())
+    {
+        m_loaded_karts.push_front(kart_properties->getIdent());
+        unloadUnusedKartModels();
+    }
     return true;
 }   // loadKart
 
+//-----------------------------------------------------------------------------
+/** Loads the models of the given karts if only a limited number of karts is
+ *  kept in memory, and unloads the least recently used models if there are
+ *  too many loaded karts afterwards. Must be called from the main thread
+ *  before the karts are created.
+ *  \param kart_list Identifiers of the karts to load.
+ */
+void KartPropertiesManager::onDemandLoadKartModels(
+                                        const std::set<std::string>& kart_list)
+{
+    if (m_max_loaded_karts == 0)
+        return;
+
+    for (const std::string& ident : kart_list)
+    {
+        KartProperties* kp = const_cast<KartProperties*>(getKart(ident));
+        if (!kp)
+            continue;
+
+        m_loaded_karts.remove(ident);
+        try
+        {
+            kp->loadKartModel();
+        }
+        catch (std::runtime_error& err)
+        {
+            Log::error("[KartPropertiesManager]", "Can't load kart '%s': %s",
+                ident.c_str(), err.what());
+            continue;
+        }
+        m_loaded_karts.push_front(ident);
+    }
+    unloadUnusedKartModels();
+}   // onDemandLoadKartModels
+
+//-----------------------------------------------------------------------------
+/** Unloads the least recently used kart models until at most
+ *  m_max_loaded_karts karts are loaded. Tux and karts which are currently in
+ *  a race are never unloaded.
+ */
+void KartPropertiesManager::unloadUnusedKartModels()
+{
+    auto it = m_loaded_karts.end();
+    while (m_loaded_karts.size() > m_max_loaded_karts &&
+        it != m_loaded_karts.begin())
+    {
+        it--;
+        KartProperties* kp = const_cast<KartProperties*>(getKart(*it));
+        if (kp && (kp->getIdent() == "tux" || kp->isKartModelInUse()))
+            continue;
+        if (kp)
+        {
+            Log::debug("[KartPropertiesManager]", "Unloading kart '%s'.",
+                kp->getIdent().c_str());
+            kp->unloadKartModel();
+        }
+        it = m_loaded_karts.erase(it);
+    }
+}   // unloadUnusedKartModels
+
 //-----------------------------------------------------------------------------
 /** Sets the name of a mesh to use as a hat for all karts.
  *  \param hat_name Name of the hat mash.
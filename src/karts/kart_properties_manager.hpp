@@ -21,6 +21,7 @@
 #define HEADER_KART_PROPERTIES_MANAGER_HPP
 
 #include "utils/ptr_vector.hpp"
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -65,11 +66,21 @@ private:
      *  all clients or not. */
     std::vector<bool>        m_kart_available;
 
+    /** Maximum number of karts with loaded models, 0 if the models of all
+     *  karts are loaded at startup. */
+    unsigned                 m_max_loaded_karts;
+
+    /** Identifiers of all karts with loaded models if m_max_loaded_karts
+     *  is used, the most recently used kart first. */
+    std::list<std::string>   m_loaded_karts;
+
     std::unique_ptr<AbstractCharacteristic>                         m_base_characteristic;
     std::map<std::string, std::unique_ptr<AbstractCharacteristic> > m_difficulty_characteristics;
     std::map<std::string, std::unique_ptr<AbstractCharacteristic> > m_kart_type_characteristics;
     std::map<std::string, std::unique_ptr<AbstractCharacteristic> > m_player_characteristics;
 
+    void unloadUnusedKartModels();
+
 protected:
 
     typedef PtrVector<KartProperties> KartPropertiesVector;
@@ -149,6 +160,13 @@ public:
     // ------------------------------------------------------------------------
     void onDemandLoadKartTextures(const std::set<std::string>& kart_list,
                                   bool unload_unused = true);
+    // ------------------------------------------------------------------------
+    void onDemandLoadKartModels(const std::set<std::string>& kart_list);
+    // ------------------------------------------------------------------------
+    /** Limits the number of karts whose models are kept in memory, must be
+     *  called before loadAllKarts. 0 loads all karts at startup. */
+    void setMaxLoadedKarts(unsigned max_loaded_karts)
+                                   { m_max_loaded_karts = max_loaded_karts; }
 };
 
 extern KartPropertiesManager *kart_properties_manager;
@@ -22,6 +22,7 @@
 #include "karts/rescue_animation.hpp"
 #include "items/item.hpp"
 #include "modes/linear_world.hpp"
+#include "utils/time.hpp"
 
 KartWithStats::KartWithStats(const std::string& ident,
                              unsigned int world_kart_id,
@@ -50,6 +51,8 @@ void KartWithStats::reset()
     m_bubblegum_count   = 0;
     m_brake_count       = 0;
     m_off_track_count   = 0;
+    m_update_time       = 0;
+    m_update_count      = 0;
     Kart::reset();
 }   // reset
 
@@ -60,7 +63,10 @@ void KartWithStats::reset()
  */
 void KartWithStats::update(int ticks)
 {
+    uint64_t start = StkTime::getMonoTimeUs();
     Kart::update(ticks);
+    m_update_time += StkTime::getMonoTimeUs() - start;
+    m_update_count++;
     if(getSpeed()>m_top_speed        ) m_top_speed = getSpeed();
     float dt = stk_config->ticks2Time(ticks);
     if(getControls().getSkidControl()) m_skidding_time += dt;
@@ -70,6 +70,12 @@ private:
     /** How much time this kart was skidding. */
     float        m_skidding_time;
 
+    /** Accumulated real time spent in Kart::update, in microseconds. */
+    uint64_t     m_update_time;
+
+    /** Number of calls to Kart::update. */
+    unsigned int m_update_count;
+
 public:
                  KartWithStats(const std::string& ident,
                                unsigned int world_kart_id,
@@ -120,6 +126,13 @@ public:
     /** Returns how often the kart was off track. */
     unsigned int getOffTrackCount() const { return m_off_track_count; }
     // ------------------------------------------------------------------------
+    /** Returns the accumulated real time spent in Kart::update in
+     *  microseconds. */
+    uint64_t getUpdateTime() const { return m_update_time; }
+    // ------------------------------------------------------------------------
+    /** Returns how often Kart::update was called. */
+    unsigned int getUpdateCount() const { return m_update_count; }
+    // ------------------------------------------------------------------------
 
 };   // KartWithStats
 #endif
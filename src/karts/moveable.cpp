@@ -176,7 +176,11 @@ void Moveable::updatePosition()
 }   // updatePosition
 
 //-----------------------------------------------------------------------------
-/** Creates the bullet rigid body for this moveable.
+/** Creates the bullet rigid body for this moveable. If this moveable already
+ *  has a body (e.g. a flyable which is fired again), it must have been
+ *  removed from the physics world, and it is replaced by a new body. The
+ *  motion state is reused, and the cached velocity, heading, pitch and roll
+ *  are recomputed for the new transform.
  *  \param mass Mass of this object.
  *  \param trans Transform (=position and orientation) for this object).
  *  \param shape Bullet collision shape for this object.
@@ -188,7 +192,10 @@ void Moveable::createBody(float mass, btTransform& trans,
     btVector3 inertia;
     shape->calculateLocalInertia(mass, inertia);
     m_transform = trans;
-    m_motion_state.reset(new KartMotionState(trans));
+    if (m_motion_state)
+        m_motion_state->setWorldTransform(trans);
+    else
+        m_motion_state.reset(new KartMotionState(trans));
 
     btRigidBody::btRigidBodyConstructionInfo info(mass, m_motion_state.get(),
                                                   shape, inertia);
@@ -197,6 +204,7 @@ void Moveable::createBody(float mass, btTransform& trans,
 
     // Then create a rigid body
     // ------------------------
+    assert(!m_body || !m_body->getBroadphaseHandle());
     m_body.reset(new btRigidBody(info));
     if(mass==0)
     {
@@ -211,6 +219,9 @@ void Moveable::createBody(float mass, btTransform& trans,
     // functions are not called correctly. So only init the pointer to zero.
     m_user_pointer.zero();
     m_body->setUserPointer(&m_user_pointer);
+
+    m_velocityLC = Vec3(0, 0, 0);
+    updatePosition();
 }   // createBody
 
 //-----------------------------------------------------------------------------
@@ -229,6 +229,7 @@ extern "C" {
 #include "input/input_manager.hpp"
 #include "input/keyboard_device.hpp"
 #include "input/wiimote_manager.hpp"
+#include "io/asset_cache.hpp"
 #include "io/file_manager.hpp"
 #include "items/attachment_manager.hpp"
 #include "items/item_manager.hpp"
@@ -244,6 +245,7 @@ extern "C" {
 #include "karts/official_karts.hpp"
 #include "modes/cutscene_world.hpp"
 #include "modes/demo_world.hpp"
+#include "modes/race_order.hpp"
 #include "network/protocols/connect_to_server.hpp"
 #include "network/protocols/client_lobby.hpp"
 #include "network/protocols/server_lobby.hpp"
@@ -259,6 +261,7 @@ extern "C" {
 #include "network/server.hpp"
 #include "network/server_config.hpp"
 #include "network/servers_manager.hpp"
+#include "network/simulated_network.hpp"
 #include "network/socket_address.hpp"
 #include "network/stk_host.hpp"
 #include "network/stk_peer.hpp"
@@ -279,6 +282,7 @@ extern "C" {
 #include "states_screens/dialogs/message_dialog.hpp"
 #include "tips/tips_manager.hpp"
 #include "tracks/arena_graph.hpp"
+#include "tracks/terrain_grid.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/command_line.hpp"
@@ -610,6 +614,16 @@ void cmdLineHelp()
     "       --server-config=file Specify the server_config.xml for server hosting, it will create\n"
     "                            one if not found.\n"
     "       --network-console  Enable network console.\n"
+    "       --simulate-network=latency,jitter,loss,bandwidth[,seed]\n"
+    "                          Delay and drop outgoing network packets, with latency\n"
+    "                          and jitter in ms, loss in percent and bandwidth in kbit/s\n"
+    "                          (0 for unlimited).\n"
+    "       --bake-assets      Compute and cache arena graphs of all tracks, and with\n"
+    "                          --no-graphics the physics data of all track meshes,\n"
+    "                          then exit.\n"
+    "       --no-terrain-grid  Always use raycasts to find the terrain below a point.\n"
+    "       --check-terrain-grid Compare the terrain grid with raycasts when loading\n"
+    "                          a track (use with --no-graphics and --profile-laps).\n"
     "       --wan-server=name  Start a Wan server (not a playing client).\n"
     "       --public-server    Allow direct connection to the server (without stk server)\n"
     "       --lan-server=name  Start a LAN server (not a playing client).\n"
@@ -1280,6 +1294,11 @@ int handleCmdLine(bool has_server_config, bool has_parent_process)
         STKHost::m_enable_console = true;
     }
 
+    if (CommandLine::has("--no-terrain-grid"))
+        UserConfigParams::m_terrain_grid = false;
+    if (CommandLine::has("--check-terrain-grid"))
+        UserConfigParams::m_check_terrain_grid = true;
+
     if (CommandLine::has("--disable-item-collection"))
         ItemManager::disableItemCollection();
 
@@ -1340,6 +1359,10 @@ int handleCmdLine(bool has_server_config, bool has_parent_process)
     {
         Network::m_connection_debug = true;
     }
+    if (CommandLine::has("--simulate-network", &s))
+    {
+        SimulatedNetwork::setConditions(s);
+    }
     if (CommandLine::has("--server-id-file", &s))
     {
         NetworkConfig::get()->setServerIdFile(
@@ -2285,6 +2308,12 @@ int main(int argc, char *argv[])
 
         GUIEngine::addLoadingIcon( irr_driver->getTexture(FileManager::GUI_ICON,
                                                           "options_video.png"));
+        if (NetworkConfig::get()->isServer() && GUIEngine::isNoGraphics() &&
+            ServerConfig::m_max_loaded_karts > 0)
+        {
+            kart_properties_manager->setMaxLoadedKarts(
+                ServerConfig::m_max_loaded_karts);
+        }
         kart_properties_manager -> loadAllKarts    ();
         kart_properties_manager->onDemandLoadKartTextures(
             { UserConfigParams::m_default_kart }, false/*unload_unused*/);
@@ -2372,6 +2401,12 @@ int main(int argc, char *argv[])
             exit(0);
         }
 
+        if (CommandLine::has("--bake-assets"))
+        {
+            AssetCache::bakeAllAssets();
+            exit(0);
+        }
+
 #ifndef SERVER_ONLY
         if (!GUIEngine::isNoGraphics())
         {
@@ -2855,6 +2890,12 @@ void runUnitTests()
     Log::info("UnitTest", "Arena Graph");
     ArenaGraph::unitTesting();
 
+    Log::info("UnitTest", "Terrain Grid");
+    TerrainGrid::unitTesting();
+
+    Log::info("UnitTest", "Race order");
+    RaceOrder::unitTesting();
+
     Log::info("UnitTest", "Fonts for translation");
     font_manager->unitTesting();
 
@@ -30,7 +30,6 @@
 #include "network/protocols/game_events_protocol.hpp"
 #include "network/server_config.hpp"
 #include "network/stk_host.hpp"
-#include "physics/triangle_mesh.hpp"
 #include "states_screens/race_gui.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_object_manager.hpp"
@@ -449,9 +448,8 @@ bool CaptureTheFlag::getDroppedFlagTrans(const btTransform& kt,
     const Material* material = NULL;
 
     // From TerrainInfo::update
-    const TriangleMesh &tm = Track::getCurrentTrack()->getTriangleMesh();
-    bool ret = tm.castRay(from, to, &hit_point, &material, &normal,
-        /*interpolate*/false);
+    bool ret = Track::getCurrentTrack()->castRayToTerrain(from, to,
+        &hit_point, &material, &normal);
     if (!ret || material == NULL)
         return false;
 
@@ -89,6 +89,7 @@ void LinearWorld::init()
 
     // The values are initialised in reset()
     m_kart_info.resize(m_karts.size());
+    m_race_order.reset((unsigned int)m_karts.size());
 }   // init
 
 //-----------------------------------------------------------------------------
@@ -141,6 +142,7 @@ void LinearWorld::reset(bool restart)
     // First all kart infos must be updated before the kart position can be
     // recomputed, since otherwise 'new' (initialised) valued will be compared
     // with old values.
+    m_race_order.reset(kart_amount);
     updateRacePosition();
 
 #ifdef DEBUG
@@ -860,9 +862,9 @@ btTransform LinearWorld::getRescueTransform(unsigned int index) const
 }   // getRescueTransform
 
 //-----------------------------------------------------------------------------
-/** Find the position (rank) of every kart. ATM it uses a stable O(n^2)
- *  algorithm by counting for each kart how many other karts are ahead of
- *  it.
+/** Find the position (rank) of every kart. The karts that are still racing
+ *  are kept sorted by RaceOrder, which only needs to move karts that
+ *  overtook other karts since the last call.
  */
 void LinearWorld::updateRacePosition()
 {
@@ -874,57 +876,44 @@ void LinearWorld::updateRacePosition()
     bool rank_changed = false;
 #endif
 
-    // NOTE: if you do any changes to this loop, the next loop (see
-    // DEBUG_KART_RANK below) needs to have the same changes applied
-    // so that debug output is still correct!!!!!!!!!!!
     for (unsigned int i=0; i<kart_amount; i++)
     {
         AbstractKart* kart = m_karts[i].get();
+        RaceOrder::KartState state = RaceOrder::KS_RACING;
+        if (kart->isEliminated())
+            state = RaceOrder::KS_ELIMINATED;
+        else if (kart->hasFinishedRace())
+            state = RaceOrder::KS_FINISHED;
+        m_race_order.setKart(i, m_kart_info[i].m_overall_distance,
+                             kart->getInitialPosition(), state);
+
         // Karts that are either eliminated or have finished the
         // race already have their (final) position assigned. If
         // these karts would get their rank updated, it could happen
         // that a kart that finished first will be overtaken after
         // crossing the finishing line and become second!
-        if(kart->isEliminated() || kart->hasFinishedRace())
+        if (state != RaceOrder::KS_RACING)
         {
             // This is only necessary to support debugging inconsistencies
             // in kart position parameters.
             setKartPosition(i, kart->getPosition());
-            continue;
         }
-        KartInfo& kart_info = m_kart_info[i];
-
-        int p = 1 ;
-
-        const unsigned int my_id = kart->getWorldKartId();
-        const float my_distance  = m_kart_info[my_id].m_overall_distance;
-
-        // Count karts ahead of the current kart, i.e. kart that are
-        // already finished or have covered a larger overall distance.
-        for (unsigned int j = 0 ; j < kart_amount ; j++)
-        {
-            // don't compare a kart with itself and ignore eliminated karts
-            if(j == my_id || m_karts[j]->isEliminated())
-                continue;
-
-            // If the other kart has:
-            // - finished the race (but this kart hasn't)
-            // - or is ahead
-            // - or has the same distance (very unlikely) but started earlier
-            // it is ahead --> increase position
-            if((!kart->hasFinishedRace() && m_karts[j]->hasFinishedRace()) ||
-                m_kart_info[j].m_overall_distance > my_distance            ||
-               (m_kart_info[j].m_overall_distance == my_distance &&
-                m_karts[j]->getInitialPosition()<kart->getInitialPosition() ) )
-            {
-                p++;
-            }
+    }
+    m_race_order.update();
 
-        } //next kart
+    // NOTE: if you do any changes to how karts are ranked (see
+    // RaceOrder), the loop below (see DEBUG_KART_RANK) needs to have
+    // the same changes applied so that debug output is still correct!!!
+    for (unsigned int n = 0; n < m_race_order.getNumRacingKarts(); n++)
+    {
+        const unsigned int i = m_race_order.getRacingKart(n);
+        KartInfo& kart_info = m_kart_info[i];
+        const int p = m_race_order.getPosition(n);
 
 #ifndef DEBUG
         setKartPosition(i, p);
 #else
+        AbstractKart* kart = m_karts[i].get();
         rank_changed |= kart->getPosition()!=p;
         if (!setKartPosition(i,p))
         {
@@ -943,10 +932,11 @@ void LinearWorld::updateRacePosition()
             }
 
             Log::debug("[LinearWorld]", "Who has each ranking so far :");
-            for (unsigned int d=0; d<i; d++)
+            for (unsigned int d=0; d<n; d++)
             {
-                Log::debug("[LinearWorld]", "%s has rank %d", m_karts[d]->getIdent().c_str(),
-                            m_karts[d]->getPosition());
+                AbstractKart* k = m_karts[m_race_order.getRacingKart(d)].get();
+                Log::debug("[LinearWorld]", "%s has rank %d",
+                           k->getIdent().c_str(), k->getPosition());
             }
 
             Log::debug("[LinearWorld]", "    --> And %s is being set at rank %d",
@@ -966,7 +956,7 @@ void LinearWorld::updateRacePosition()
             music_manager->switchToFastMusic();
             m_faster_music_active=true;
         }
-    }   // for i<kart_amount
+    }   // for n<getNumRacingKarts
 
     // Define this to get a detailled analyses each time a race position
     // changes.
@@ -1175,6 +1165,7 @@ void LinearWorld::saveCompleteState(BareNetworkString* bns, STKPeer* peer)
         ts->saveCompleteState(bns);
 
     CheckManager* cm = Track::getCurrentTrack()->getCheckManager();
+    cm->storePreviousPositions();
     const uint8_t cc = (uint8_t)cm->getCheckStructureCount();
     bns->addUInt8(cc);
     for (unsigned i = 0; i < cc; i++)
@@ -1211,6 +1202,7 @@ void LinearWorld::restoreCompleteState(const BareNetworkString& b)
     }
     for (unsigned i = 0; i < cc; i++)
         cm->getCheckStructure(i)->restoreCompleteState(b);
+    cm->loadPreviousPositions();
 }   // restoreCompleteState
 
 // ----------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #ifndef HEADER_LINEAR_WORLD_HPP
 #define HEADER_LINEAR_WORLD_HPP
 
+#include "modes/race_order.hpp"
 #include "modes/world_with_rank.hpp"
 #include "utils/aligned_array.hpp"
 
@@ -132,6 +133,9 @@ protected:
       */
     std::vector<KartInfo> m_kart_info;
 
+    /** Keeps the racing karts sorted to compute their positions. */
+    RaceOrder m_race_order;
+
     virtual void  checkForWrongDirection(unsigned int i, float dt);
     virtual float estimateFinishTimeForKart(AbstractKart* kart) OVERRIDE;
 
@@ -206,6 +206,22 @@ void ProfileWorld::enterRaceOverState()
     Log::verbose("profile", "Number of frames: %d time %f, Average FPS: %f",
                  m_frame_count, runtime, (float)m_frame_count/runtime);
 
+    // Print the average cost of a single kart update, which is the hot
+    // path for all kart physics and characteristics lookups.
+    uint64_t update_time = 0;
+    unsigned int update_count = 0;
+    for (unsigned int i = 0; i < m_karts.size(); i++)
+    {
+        auto kart = std::dynamic_pointer_cast<KartWithStats>(m_karts[i]);
+        update_time  += kart->getUpdateTime();
+        update_count += kart->getUpdateCount();
+    }
+    if (update_count > 0)
+    {
+        Log::verbose("profile", "Kart updates: %u, average time: %f us",
+                     update_count, (float)update_time/update_count);
+    }
+
     // Print geometry statistics if we're not in no-graphics mode
     if(!GUIEngine::isNoGraphics())
     {
@@ -0,0 +1,169 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "modes/race_order.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <random>
+
+/** Removes all karts from the order, and sets the number of karts.
+ *  \param num_karts Number of karts in the race.
+ */
+void RaceOrder::reset(unsigned int num_karts)
+{
+    m_distance.assign(num_karts, 0.0f);
+    m_initial_position.assign(num_karts, 0);
+    m_state.assign(num_karts, KS_RACING);
+    m_in_order.assign(num_karts, false);
+    m_order.clear();
+    m_order.reserve(num_karts);
+    m_num_finished = 0;
+}   // reset
+
+// ----------------------------------------------------------------------------
+/** Updates the order of all racing karts after their data was set with
+ *  setKart(). Karts that stopped racing are removed, and karts that (again)
+ *  race are added at the end before the order is sorted.
+ */
+void RaceOrder::update()
+{
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < m_order.size(); i++)
+    {
+        unsigned int kart = m_order[i];
+        if (m_state[kart] == KS_RACING)
+            m_order[n++] = kart;
+        else
+            m_in_order[kart] = false;
+    }
+    m_order.resize(n);
+
+    m_num_finished = 0;
+    for (unsigned int kart = 0; kart < m_state.size(); kart++)
+    {
+        if (m_state[kart] == KS_FINISHED)
+            m_num_finished++;
+        else if (m_state[kart] == KS_RACING && !m_in_order[kart])
+        {
+            m_order.push_back(kart);
+            m_in_order[kart] = true;
+        }
+    }
+
+    // Insertion sort: only karts that overtook other karts are moved.
+    for (unsigned int i = 1; i < m_order.size(); i++)
+    {
+        unsigned int kart = m_order[i];
+        unsigned int j    = i;
+        while (j > 0 && isAhead(kart, m_order[j - 1]))
+        {
+            m_order[j] = m_order[j - 1];
+            j--;
+        }
+        m_order[j] = kart;
+    }
+}   // update
+
+// ============================================================================
+/** Compares the positions with the ones computed by counting for each kart
+ *  how many other karts are ahead of it (which is how positions were
+ *  computed before), for randomly driving karts which overtake, get rescued,
+ *  finish and are eliminated (and rejoin, as with live join).
+ */
+void RaceOrder::unitTesting()
+{
+    std::mt19937 random(42);
+    const unsigned int kart_amounts[] = { 1, 2, 3, 8, 30, 64 };
+    for (unsigned int num_karts : kart_amounts)
+    {
+        RaceOrder order;
+        order.reset(num_karts);
+        std::vector<float>     distance(num_karts);
+        std::vector<KartState> state(num_karts, KS_RACING);
+        std::vector<int>       initial_position(num_karts);
+        std::vector<int>       expected(num_karts);
+        for (unsigned int i = 0; i < num_karts; i++)
+        {
+            // Karts start behind each other, in a random order
+            initial_position[i] = i + 1;
+            distance[i] = -3.0f * i;
+        }
+        std::shuffle(initial_position.begin(), initial_position.end(),
+                     random);
+
+        for (unsigned int frame = 0; frame < 3000; frame++)
+        {
+            for (unsigned int i = 0; i < num_karts; i++)
+            {
+                if (state[i] != KS_RACING)
+                {
+                    // Rejoin an eliminated kart once in a while
+                    if (state[i] == KS_ELIMINATED && random() % 500 == 0)
+                        state[i] = KS_RACING;
+                    continue;
+                }
+                unsigned int r = random() % 1000;
+                if (r == 0)
+                    distance[i] -= 50.0f;                  // rescue
+                else if (r < 3)
+                    state[i] = KS_ELIMINATED;
+                else if (distance[i] > 1500.0f && r < 20)
+                    state[i] = KS_FINISHED;
+                else if (r < 100)
+                    distance[i] = std::floor(distance[i]); // ties
+                else
+                    distance[i] += (random() % 1000) * 0.002f;
+            }
+
+            for (unsigned int i = 0; i < num_karts; i++)
+                order.setKart(i, distance[i], initial_position[i], state[i]);
+            order.update();
+
+            // Count the karts ahead of each racing kart
+            for (unsigned int i = 0; i < num_karts; i++)
+            {
+                if (state[i] != KS_RACING) continue;
+                expected[i] = 1;
+                for (unsigned int j = 0; j < num_karts; j++)
+                {
+                    if (j == i || state[j] == KS_ELIMINATED) continue;
+                    if (state[j] == KS_FINISHED                     ||
+                        distance[j] > distance[i]                   ||
+                        (distance[j] == distance[i] &&
+                         initial_position[j] < initial_position[i])    )
+                        expected[i]++;
+                }
+            }
+
+            unsigned int num_racing = 0;
+            for (unsigned int i = 0; i < num_karts; i++)
+                num_racing += state[i] == KS_RACING ? 1 : 0;
+            assert(order.getNumRacingKarts() == num_racing);
+            (void)num_racing;   // Only used in asserts
+            for (unsigned int n = 0; n < order.getNumRacingKarts(); n++)
+            {
+                unsigned int kart = order.getRacingKart(n);
+                assert(state[kart] == KS_RACING);
+                assert(order.getPosition(n) == expected[kart]);
+                (void)kart;   // Only used in asserts
+            }
+        }   // for frame
+    }   // for num_karts
+}   // unitTesting
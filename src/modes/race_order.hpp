@@ -0,0 +1,97 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_RACE_ORDER_HPP
+#define HEADER_RACE_ORDER_HPP
+
+#include <vector>
+
+/**
+ *  \brief Computes the race position of all karts in a linear race.
+ *  A kart that is still racing is behind all karts that have finished the
+ *  race, and behind all racing karts that have covered a larger overall
+ *  distance (or the same distance, but started ahead). Eliminated karts
+ *  are ignored, and finished or eliminated karts keep their position.
+ *  The racing karts are kept sorted between frames. Since the order only
+ *  changes when karts overtake each other, an insertion sort of the
+ *  previous order takes linear time in most frames.
+ * \ingroup modes
+ */
+class RaceOrder
+{
+public:
+    /** The state of a kart as far as ranking is concerned. */
+    enum KartState { KS_RACING, KS_FINISHED, KS_ELIMINATED };
+
+private:
+    /** Overall distance of each kart. */
+    std::vector<float>     m_distance;
+
+    /** Initial (start) position of each kart, used to break ties. */
+    std::vector<int>       m_initial_position;
+
+    /** The state of each kart. */
+    std::vector<KartState> m_state;
+
+    /** True if a kart is contained in m_order. */
+    std::vector<bool>      m_in_order;
+
+    /** Indices of all racing karts, sorted from first to last. */
+    std::vector<unsigned int> m_order;
+
+    /** Number of karts that have finished and are not eliminated. */
+    unsigned int m_num_finished;
+
+    // ------------------------------------------------------------------------
+    /** True if kart a is ahead of kart b. */
+    bool isAhead(unsigned int a, unsigned int b) const
+    {
+        return m_distance[a] > m_distance[b] ||
+               (m_distance[a] == m_distance[b] &&
+                m_initial_position[a] < m_initial_position[b]);
+    }   // isAhead
+
+public:
+         RaceOrder() : m_num_finished(0) {}
+    void reset(unsigned int num_karts);
+    void update();
+    static void unitTesting();
+    // ------------------------------------------------------------------------
+    /** Sets the data used to rank a kart, must be called for each kart
+     *  before update(). */
+    void setKart(unsigned int kart, float distance, int initial_position,
+                 KartState state)
+    {
+        m_distance[kart]         = distance;
+        m_initial_position[kart] = initial_position;
+        m_state[kart]            = state;
+    }   // setKart
+    // ------------------------------------------------------------------------
+    /** Returns the number of racing karts. */
+    unsigned int getNumRacingKarts() const
+                                     { return (unsigned int)m_order.size(); }
+    // ------------------------------------------------------------------------
+    /** Returns the index of the kart that is n-th (starting with 0) of all
+     *  racing karts. */
+    unsigned int getRacingKart(unsigned int n) const    { return m_order[n]; }
+    // ------------------------------------------------------------------------
+    /** Returns the race position of the n-th racing kart. */
+    int getPosition(unsigned int n) const    { return m_num_finished + n + 1; }
+};   // RaceOrder
+
+#endif
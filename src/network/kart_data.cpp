@@ -1,6 +1,5 @@
 #include "network/kart_data.hpp"
 
-#include "karts/kart_model.hpp"
 #include "karts/kart_properties.hpp"
 #include "network/network_string.hpp"
 
@@ -10,9 +9,11 @@ KartData::KartData(const KartProperties* kp)
     m_kart_type = kp->getKartType();
     if (!m_kart_type.empty())
     {
-        m_width  = kp->getMasterKartModel().getWidth();
-        m_height = kp->getMasterKartModel().getHeight();
-        m_length = kp->getMasterKartModel().getLength();
+        // The master kart model can be replaced on the main thread while
+        // this runs in the lobby, the cached size is never changed
+        m_width  = kp->getKartWidth();
+        m_height = kp->getKartHeight();
+        m_length = kp->getKartLength();
         m_gravity_shift = kp->getGravityCenterShift();
     }
     else
@@ -23,12 +23,14 @@
 #include "network/event.hpp"
 #include "network/network_config.hpp"
 #include "network/network_string.hpp"
+#include "network/simulated_network.hpp"
 #include "network/socket_address.hpp"
 #include "network/stk_ipv6.hpp"
 #include "utils/file_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/time.hpp"
 
+#include <algorithm>
 #include <string.h>
 #if defined(WIN32)
 #  include "ws2tcpip.h"
@@ -65,6 +67,7 @@ Network::Network(int peer_count, int channel_limit,
 {
     m_ipv6_socket = false;
     m_port = 0;
+    m_simulated_network = NULL;
     m_host = enet_host_create(address, peer_count, channel_limit, 0, 0);
     if (!m_host && change_port_if_bound)
     {
@@ -102,6 +105,8 @@ Network::Network(int peer_count, int channel_limit,
                 m_port = ntohs(sin->sin_port);
             }
         }
+        if (SimulatedNetwork::isEnabled())
+            m_simulated_network = new SimulatedNetwork(m_host);
     }
 }   // Network
 
@@ -111,6 +116,7 @@ Network::Network(int peer_count, int channel_limit,
  */
 Network::~Network()
 {
+    delete m_simulated_network;
     if (m_host)
     {
         enet_host_destroy(m_host);
@@ -123,6 +129,38 @@ ENetPeer* Network::connectTo(const ENetAddress &address)
     return enet_host_connect(m_host, &address, EVENT_CHANNEL_COUNT, 0);
 }   // connectTo
 
+// ----------------------------------------------------------------------------
+/** Services the ENet host like enet_host_service. With a simulated network
+ *  the delayed datagrams are sent in time while waiting for an event, this
+ *  is needed wherever the host is serviced outside STKHost::mainLoop
+ *  (e.g. while connecting to a server).
+ *  \param event Receives the event if one occurred.
+ *  \param timeout Time in ms to wait for an event.
+ */
+int Network::service(ENetEvent* event, uint32_t timeout)
+{
+    if (!m_simulated_network)
+        return enet_host_service(m_host, event, timeout);
+
+    const uint64_t end = StkTime::getMonoTimeMs() + timeout;
+    while (true)
+    {
+        m_simulated_network->update();
+        const uint64_t now = StkTime::getMonoTimeMs();
+        uint32_t wait = now < end ? (uint32_t)(end - now) : 0;
+        const int next_send = m_simulated_network->getTimeToNextSend();
+        if (next_send >= 0)
+            wait = std::min(wait, (uint32_t)next_send);
+        const int result = enet_host_service(m_host, event, wait);
+        if (result != 0 || StkTime::getMonoTimeMs() >= end)
+        {
+            // Send what enet_host_service queued, if it is due already
+            m_simulated_network->update();
+            return result;
+        }
+    }
+}   // service
+
 // ----------------------------------------------------------------------------
 /** \brief Sends a packet whithout ENet adding its headers.
  *  This function is used in particular to achieve the STUN protocol.
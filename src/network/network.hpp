@@ -36,6 +36,7 @@
 
 class BareNetworkString;
 class NetworkString;
+class SimulatedNetwork;
 class SocketAddress;
 
 /** \class EnetHost
@@ -51,6 +52,10 @@ private:
     uint16_t m_port;
 
     bool m_ipv6_socket;
+
+    /** Simulated network conditions of the host, or NULL if disabled. */
+    SimulatedNetwork* m_simulated_network;
+
     /** Where to log packets. If NULL for FILE* logging is disabled. */
     static Synchronised<FILE*> m_log_file;
 
@@ -67,6 +72,7 @@ public:
     static void logPacket(const BareNetworkString &ns, bool incoming);
     static void closeLog();
     ENetPeer *connectTo(const ENetAddress &address);
+    int      service(ENetEvent* event, uint32_t timeout);
     void     sendRawPacket(const BareNetworkString &buffer,
                            const SocketAddress& dst);
     int receiveRawPacket(char *buffer, int buf_len,
@@ -80,6 +86,8 @@ public:
     ENetHost* getENetHost() { return m_host; }
     // ------------------------------------------------------------------------
     bool isIPv6Socket() { return m_ipv6_socket; }
+    // ------------------------------------------------------------------------
+    SimulatedNetwork* getSimulatedNetwork() { return m_simulated_network; }
 };   // class Network
 
 #endif // HEADER_ENET_SOCKET_HPP
@@ -471,7 +471,7 @@ bool ConnectToServer::tryConnect(int timeout, int retry, bool another_port,
             "retry remain: %d", connecting_address.c_str(),
             nw->getPort(), m_retry_count);
         int res;
-        while ((res = enet_host_service(nw->getENetHost(), &event, timeout)) != 0)
+        while ((res = nw->service(&event, timeout)) != 0)
         {
             if (event.type == ENET_EVENT_TYPE_CONNECT)
             {
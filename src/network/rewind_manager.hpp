@@ -190,6 +190,12 @@ public:
     // ------------------------------------------------------------------------
     bool addRewinder(std::shared_ptr<Rewinder> rewinder);
     // ------------------------------------------------------------------------
+    /** Removes a rewinder which is not used anymore, but not deleted (e.g.
+     *  a flyable which is kept to be reused). Must not be called while
+     *  iterating over all rewinders. */
+    void removeRewinder(const std::string& name)
+                                               { m_all_rewinder.erase(name); }
+    // ------------------------------------------------------------------------
     /** Returns true if currently a rewind is happening. */
     bool isRewinding() const { return m_is_rewinding; }
 
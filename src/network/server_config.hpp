@@ -280,6 +280,13 @@ namespace ServerConfig
         "kart which server is missing, tux's kart physics and kart type of "
         "the original addon is sent."));
 
+    SERVER_CFG_PREFIX IntServerConfigParam m_max_loaded_karts
+        SERVER_CFG_DEFAULT(IntServerConfigParam(0, "max-loaded-karts",
+        "Maximum number of kart models kept in memory by a server without "
+        "graphics, karts are loaded when they are used in a race and the "
+        "least recently used ones are unloaded. 0 loads all karts at "
+        "startup."));
+
     SERVER_CFG_PREFIX FloatServerConfigParam m_flag_return_timeout
         SERVER_CFG_DEFAULT(FloatServerConfigParam(20.0f, "flag-return-timeout",
         "Time in seconds when a flag is dropped a by player in CTF "
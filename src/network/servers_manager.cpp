@@ -321,6 +321,12 @@ std::shared_ptr<ServerList> ServersManager::getLANRefreshRequest() const
          *  functions are called, which will cause a crash. */
         virtual void afterOperation() OVERRIDE {}
         // --------------------------------------------------------------------
+        /** The operation is a LAN broadcast, not a curl transfer. */
+        virtual bool supportsConcurrentTransfer() const OVERRIDE
+        {
+            return false;
+        }   // supportsConcurrentTransfer
+        // --------------------------------------------------------------------
     };   // LANRefreshRequest
     // ========================================================================
 
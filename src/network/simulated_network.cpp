@@ -0,0 +1,187 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "network/simulated_network.hpp"
+#include "utils/log.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/time.hpp"
+
+#include <algorithm>
+
+uint32_t SimulatedNetwork::m_latency = 0;
+uint32_t SimulatedNetwork::m_jitter = 0;
+uint32_t SimulatedNetwork::m_bandwidth = 0;
+float SimulatedNetwork::m_loss = 0.0f;
+uint32_t SimulatedNetwork::m_seed = 0;
+bool SimulatedNetwork::m_enabled = false;
+std::mutex SimulatedNetwork::m_hosts_mutex;
+std::map<ENetHost*, SimulatedNetwork*> SimulatedNetwork::m_hosts;
+
+// ----------------------------------------------------------------------------
+/** Parses the network conditions from the command line, in the format
+ *  latency,jitter,loss,bandwidth[,seed]: latency and jitter in ms, loss in
+ *  percent and bandwidth in kbit/s (0 for unlimited).
+ *  \return False if the conditions could not be parsed.
+ */
+bool SimulatedNetwork::setConditions(const std::string& conditions)
+{
+#ifndef ENET_HAS_SEND_CALLBACK
+    Log::error("SimulatedNetwork", "Network simulation needs the ENet "
+        "bundled with STK.");
+    return false;
+#else
+    std::vector<std::string> values = StringUtils::split(conditions, ',');
+    unsigned latency = 0, jitter = 0, bandwidth = 0, seed = 0;
+    float loss = 0.0f;
+    if (values.size() < 4 || values.size() > 5 ||
+        !StringUtils::fromString(values[0], latency) ||
+        !StringUtils::fromString(values[1], jitter) ||
+        !StringUtils::fromString(values[2], loss) ||
+        !StringUtils::fromString(values[3], bandwidth) ||
+        (values.size() == 5 && !StringUtils::fromString(values[4], seed)) ||
+        loss < 0.0f || loss > 100.0f)
+    {
+        Log::error("SimulatedNetwork", "Invalid network conditions '%s'.",
+            conditions.c_str());
+        return false;
+    }
+    m_latency = latency;
+    m_jitter = jitter;
+    m_loss = loss / 100.0f;
+    m_bandwidth = bandwidth * 125;
+    m_seed = seed;
+    m_enabled = true;
+    Log::info("SimulatedNetwork", "Simulating %dms latency, %dms jitter, "
+        "%.1f%% loss, %dkbit/s bandwidth, seed %d.", latency, jitter, loss,
+        bandwidth, seed);
+    return true;
+#endif
+}   // setConditions
+
+// ----------------------------------------------------------------------------
+SimulatedNetwork::SimulatedNetwork(ENetHost* host)
+                : m_host(host), m_link_free_time(0),
+                  m_random(m_seed + host->address.port)
+{
+#ifdef ENET_HAS_SEND_CALLBACK
+    std::lock_guard<std::mutex> lock(m_hosts_mutex);
+    m_hosts[m_host] = this;
+    m_host->send = sendCallback;
+#endif
+}   // SimulatedNetwork
+
+// ----------------------------------------------------------------------------
+/** Datagrams still pending are dropped, like they would be by a socket which
+ *  is closed. */
+SimulatedNetwork::~SimulatedNetwork()
+{
+#ifdef ENET_HAS_SEND_CALLBACK
+    std::lock_guard<std::mutex> lock(m_hosts_mutex);
+    m_host->send = NULL;
+    m_hosts.erase(m_host);
+#endif
+}   // ~SimulatedNetwork
+
+// ----------------------------------------------------------------------------
+int ENET_CALLBACK SimulatedNetwork::sendCallback(ENetHost* host,
+                                                 const ENetAddress* address,
+                                                 const ENetBuffer* buffers,
+                                                 size_t buffer_count)
+{
+    std::lock_guard<std::mutex> lock(m_hosts_mutex);
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end())
+        return enet_socket_send(host->socket, address, buffers, buffer_count);
+    return it->second->send(address, buffers, buffer_count);
+}   // sendCallback
+
+// ----------------------------------------------------------------------------
+/** Queues a datagram to be sent after the simulated delay, or drops it.
+ *  Either way ENet is told all data was sent, like a real socket does not
+ *  know about losses in the network.
+ */
+int SimulatedNetwork::send(const ENetAddress* address,
+                           const ENetBuffer* buffers, size_t buffer_count)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < buffer_count; i++)
+        length += buffers[i].dataLength;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    if (m_loss > 0.0f && dist(m_random) < m_loss)
+        return (int)length;
+
+    uint64_t now = StkTime::getMonoTimeMs();
+    uint64_t arrival_time = now;
+    if (m_bandwidth > 0)
+    {
+        // Drop if more than 1 second of data is queued already, like the
+        // buffer of a congested router
+        uint64_t start = std::max(now * 1000, m_link_free_time);
+        if (start > now * 1000 + 1000000)
+            return (int)length;
+        m_link_free_time = start + (uint64_t)length * 1000000 / m_bandwidth;
+        arrival_time = m_link_free_time / 1000;
+    }
+    arrival_time += m_latency;
+    if (m_jitter > 0)
+        arrival_time += (uint64_t)(dist(m_random) * (float)m_jitter);
+
+    Datagram datagram;
+    datagram.m_address = *address;
+    datagram.m_data.reserve(length);
+    for (size_t i = 0; i < buffer_count; i++)
+    {
+        const uint8_t* data = (const uint8_t*)buffers[i].data;
+        datagram.m_data.insert(datagram.m_data.end(), data,
+            data + buffers[i].dataLength);
+    }
+    m_pending.emplace(arrival_time, std::move(datagram));
+    return (int)length;
+}   // send
+
+// ----------------------------------------------------------------------------
+/** Sends all datagrams whose simulated delay has passed. */
+void SimulatedNetwork::update()
+{
+    uint64_t now = StkTime::getMonoTimeMs();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_pending.empty() && m_pending.begin()->first <= now)
+    {
+        Datagram& datagram = m_pending.begin()->second;
+        ENetBuffer buffer;
+        buffer.data = datagram.m_data.data();
+        buffer.dataLength = datagram.m_data.size();
+        enet_socket_send(m_host->socket, &datagram.m_address, &buffer, 1);
+        m_pending.erase(m_pending.begin());
+    }
+}   // update
+
+// ----------------------------------------------------------------------------
+/** Returns the time in ms until the next datagram needs to be sent, or -1 if
+ *  there is none. */
+int SimulatedNetwork::getTimeToNextSend() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.empty())
+        return -1;
+    uint64_t now = StkTime::getMonoTimeMs();
+    uint64_t due = m_pending.begin()->first;
+    return due > now ? (int)(due - now) : 0;
+}   // getTimeToNextSend
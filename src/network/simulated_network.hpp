@@ -0,0 +1,111 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_SIMULATED_NETWORK_HPP
+#define HEADER_SIMULATED_NETWORK_HPP
+
+#include "utils/no_copy.hpp"
+#include "utils/types.hpp"
+
+#include <enet/enet.h>
+
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+/** \class SimulatedNetwork
+ *  \brief Simulates latency, jitter, packet loss and limited bandwidth on
+ *  the outgoing datagrams of an ENet host, so network code can be tested
+ *  and profiled with local servers and clients.
+ *  It replaces the socket send of the ENet host, and holds back each
+ *  datagram until its simulated arrival time, when \ref update sends it
+ *  with the real socket. Losses and jitter use their own random generator,
+ *  seeded from the given seed and the port of the host. Arrival times are
+ *  based on the real time a datagram is sent, so two runs are not
+ *  reproducible, only the statistical conditions are the same.
+ *  \ingroup network
+ */
+class SimulatedNetwork : public NoCopy
+{
+private:
+    struct Datagram
+    {
+        ENetAddress m_address;
+        std::vector<uint8_t> m_data;
+    };
+
+    /** The host whose outgoing datagrams are simulated. */
+    ENetHost* m_host;
+
+    /** Datagrams not sent yet, sorted by the time they are due. */
+    std::multimap<uint64_t, Datagram> m_pending;
+
+    /** Time in us the simulated link has sent all queued data. */
+    uint64_t m_link_free_time;
+
+    std::mt19937 m_random;
+
+    /** Protects the queue, ENet can be serviced outside the listening
+     *  thread while connecting. */
+    mutable std::mutex m_mutex;
+
+    /** Latency and maximum additional jitter in ms. */
+    static uint32_t m_latency, m_jitter;
+
+    /** Outgoing bandwidth in bytes per second, 0 for unlimited. */
+    static uint32_t m_bandwidth;
+
+    /** Probability to drop a datagram. */
+    static float m_loss;
+
+    static uint32_t m_seed;
+
+    static bool m_enabled;
+
+    static std::mutex m_hosts_mutex;
+
+    static std::map<ENetHost*, SimulatedNetwork*> m_hosts;
+
+    // ------------------------------------------------------------------------
+    static int ENET_CALLBACK sendCallback(ENetHost* host,
+                                          const ENetAddress* address,
+                                          const ENetBuffer* buffers,
+                                          size_t buffer_count);
+    // ------------------------------------------------------------------------
+    int send(const ENetAddress* address, const ENetBuffer* buffers,
+             size_t buffer_count);
+
+public:
+    // ------------------------------------------------------------------------
+    static bool setConditions(const std::string& conditions);
+    // ------------------------------------------------------------------------
+    static bool isEnabled()                              { return m_enabled; }
+    // ------------------------------------------------------------------------
+    SimulatedNetwork(ENetHost* host);
+    // ------------------------------------------------------------------------
+    ~SimulatedNetwork();
+    // ------------------------------------------------------------------------
+    void update();
+    // ------------------------------------------------------------------------
+    int getTimeToNextSend() const;
+
+};   // class SimulatedNetwork
+
+#endif // HEADER_SIMULATED_NETWORK_HPP
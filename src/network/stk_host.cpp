@@ -33,6 +33,7 @@
 #include "network/protocols/server_lobby.hpp"
 #include "network/protocol_manager.hpp"
 #include "network/server_config.hpp"
+#include "network/simulated_network.hpp"
 #include "network/child_loop.hpp"
 #include "network/stk_ipv6.hpp"
 #include "network/stk_peer.hpp"
@@ -321,6 +322,9 @@ void STKHost::init()
     m_network          = NULL;
     m_exit_timeout.store(std::numeric_limits<uint64_t>::max());
     m_client_ping.store(0);
+    m_wakeup_socket = ENET_SOCKET_NULL;
+    m_wakeup_pending = false;
+    m_peers_snapshot = std::make_shared<const PeerMap>();
 
     // Start with initialising ENet
     // ============================
@@ -746,6 +750,7 @@ void STKHost::disconnectAllPeers(bool timeout_waiting)
         m_exit_timeout.store(StkTime::getMonoTimeMs() + 2000);
     }
     m_peers.clear();
+    publishPeers();
 }   // disconnectAllPeers
 
 //-----------------------------------------------------------------------------
@@ -779,10 +784,129 @@ void STKHost::stopListening()
 {
     if (m_exit_timeout.load() == std::numeric_limits<uint64_t>::max())
         m_exit_timeout.store(0);
+    std::unique_lock<std::mutex> lock(m_enet_cmd_mutex);
+    wakeUpListeningThread();
+    lock.unlock();
     if (m_listening_thread.joinable())
         m_listening_thread.join();
 }   // stopListening
 
+// ----------------------------------------------------------------------------
+/** Creates the loopback socket which is used to wake up the listening thread
+ *  when a new ENet command is added. Without it the listening thread falls
+ *  back to polling.
+ */
+void STKHost::createWakeupSocket()
+{
+    ENetSocket s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s == ENET_SOCKET_NULL)
+    {
+        Log::warn("STKHost", "Failed to create wake up socket.");
+        return;
+    }
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    // Connect it to itself, so send can be used without an address
+    if (bind(s, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(s, (struct sockaddr*)&addr, &len) != 0 ||
+        connect(s, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        enet_socket_set_option(s, ENET_SOCKOPT_NONBLOCK, 1) != 0)
+    {
+        Log::warn("STKHost", "Failed to set up wake up socket.");
+        enet_socket_destroy(s);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_enet_cmd_mutex);
+    m_wakeup_socket = s;
+    m_wakeup_pending = false;
+}   // createWakeupSocket
+
+// ----------------------------------------------------------------------------
+/** Wakes up the listening thread if it is waiting for network events, so
+ *  new ENet commands are handled immediately. \ref m_enet_cmd_mutex must be
+ *  locked by the caller.
+ */
+void STKHost::wakeUpListeningThread()
+{
+    if (m_wakeup_pending || m_wakeup_socket == ENET_SOCKET_NULL)
+        return;
+    m_wakeup_pending = true;
+    char c = 0;
+    send(m_wakeup_socket, &c, 1, 0);
+}   // wakeUpListeningThread
+
+// ----------------------------------------------------------------------------
+/** Blocks the listening thread until a packet arrives on the ENet host or the
+ *  direct socket, a new ENet command is added, or the periodic work of ENet
+ *  and \ref mainLoop needs to run.
+ *  \param host The ENet host.
+ *  \param direct_socket The LAN discovery socket if it should be checked,
+ *         or NULL.
+ */
+void STKHost::waitForNetworkEvents(ENetHost* host, Network* direct_socket)
+{
+    // ENet needs to be serviced regularly for resending and pings if there
+    // are any peers, and the ping / validation timers of mainLoop are at
+    // least 100ms
+    uint32_t timeout = 100;
+    for (size_t i = 0; i < host->peerCount; i++)
+    {
+        if (host->peers[i].state != ENET_PEER_STATE_DISCONNECTED)
+        {
+            timeout = 10;
+            break;
+        }
+    }
+
+    ENetSocketSet read_set;
+    ENET_SOCKETSET_EMPTY(read_set);
+    ENET_SOCKETSET_ADD(read_set, host->socket);
+    ENetSocket max_socket = host->socket;
+    if (direct_socket)
+    {
+        ENetSocket ds = direct_socket->getENetHost()->socket;
+        ENET_SOCKETSET_ADD(read_set, ds);
+        max_socket = std::max(max_socket, ds);
+    }
+
+    // Send delayed datagrams of a simulated network in time
+    SimulatedNetwork* sn = getNetwork()->getSimulatedNetwork();
+    if (sn)
+    {
+        int next_send = sn->getTimeToNextSend();
+        if (next_send >= 0)
+            timeout = std::min(timeout, (uint32_t)next_send);
+    }
+
+    std::unique_lock<std::mutex> lock(m_enet_cmd_mutex);
+    ENetSocket wakeup_socket = m_wakeup_socket;
+    // Commands added before the wake up socket existed
+    if (!m_enet_cmd.empty())
+        return;
+    lock.unlock();
+
+    if (wakeup_socket == ENET_SOCKET_NULL)
+        timeout = 1;
+    else
+    {
+        ENET_SOCKETSET_ADD(read_set, wakeup_socket);
+        max_socket = std::max(max_socket, wakeup_socket);
+    }
+
+    if (enet_socketset_select(max_socket, &read_set, NULL, timeout) > 0 &&
+        wakeup_socket != ENET_SOCKET_NULL &&
+        ENET_SOCKETSET_CHECK(read_set, wakeup_socket))
+    {
+        char buffer[16];
+        while (recv(wakeup_socket, buffer, sizeof(buffer), 0) > 0)
+        {
+        }
+    }
+}   // waitForNetworkEvents
+
 // ----------------------------------------------------------------------------
 /** \brief Thread function checking if data is received.
  *  This function tries to get data from network low-level functions as
@@ -820,6 +944,7 @@ void STKHost::mainLoop(ProcessType pt)
         }
     }
 
+    createWakeupSocket();
     uint64_t last_ping_time = StkTime::getMonoTimeMs();
     uint64_t last_update_speed_time = StkTime::getMonoTimeMs();
     uint64_t last_ping_time_update_for_client = StkTime::getMonoTimeMs();
@@ -847,7 +972,9 @@ void STKHost::mainLoop(ProcessType pt)
         }
 
         auto sl = LobbyProtocol::get<ServerLobby>();
-        if (direct_socket && sl && sl->waitingForPlayers())
+        const bool check_direct_socket =
+            direct_socket && sl && sl->waitingForPlayers();
+        if (check_direct_socket)
         {
             try
             {
@@ -864,6 +991,7 @@ void STKHost::mainLoop(ProcessType pt)
         {
             std::unique_lock<std::mutex> peer_lock(m_peers_mutex);
             const float timeout = ServerConfig::m_validation_timeout;
+            bool peers_changed = false;
             bool need_ping = false;
             if (sl && (!sl->isRacing() || sl->allowJoinedPlayersWaiting()) &&
                 last_ping_time < StkTime::getMonoTimeMs())
@@ -985,19 +1113,22 @@ void STKHost::mainLoop(ProcessType pt)
                     enet_host_flush(host);
                     enet_peer_reset(it->first);
                     it = m_peers.erase(it);
+                    peers_changed = true;
                 }
                 else
                 {
                     it++;
                 }
             }
+            if (peers_changed)
+                publishPeers();
             peer_lock.unlock();
         }
 
-        std::vector<std::tuple<ENetPeer*, ENetPacket*, uint32_t,
-            ENetCommandType, ENetAddress> > copied_list;
+        std::vector<ENetCommand> copied_list;
         std::unique_lock<std::mutex> lock(m_enet_cmd_mutex);
         std::swap(copied_list, m_enet_cmd);
+        m_wakeup_pending = false;
         lock.unlock();
         for (auto& p : copied_list)
         {
@@ -1043,12 +1174,13 @@ void STKHost::mainLoop(ProcessType pt)
                 // Remove the stk peer of it
                 std::lock_guard<std::mutex> lock(m_peers_mutex);
                 m_peers.erase(peer);
+                publishPeers();
                 break;
             }
         }
 
         bool need_ping_update = false;
-        while (enet_host_service(host, &event, 10) != 0)
+        while (enet_host_service(host, &event, 0) != 0)
         {
             auto lp = LobbyProtocol::get<LobbyProtocol>();
             if (!is_server &&
@@ -1081,6 +1213,7 @@ void STKHost::mainLoop(ProcessType pt)
                 std::unique_lock<std::mutex> lock(m_peers_mutex);
                 m_peers[event.peer] = stk_peer;
                 size_t new_peer_count = m_peers.size();
+                publishPeers();
                 lock.unlock();
                 stk_event = new Event(&event, stk_peer);
                 Log::info("STKHost", "%s has just connected. There are "
@@ -1113,16 +1246,17 @@ void STKHost::mainLoop(ProcessType pt)
                     stk_event = new Event(&event, peer);
                     m_peers.erase(event.peer);
                     new_peer_count = m_peers.size();
+                    publishPeers();
                 }
                 Log::info("STKHost", "%s has just disconnected. There are "
                     "now %u peers.", addr.c_str(), new_peer_count);
             }   // ENET_EVENT_TYPE_DISCONNECT
 
-            std::unique_lock<std::mutex> lock(m_peers_mutex);
-            if (!stk_event && m_peers.find(event.peer) != m_peers.end())
+            auto peers = getPeersSnapshot();
+            auto peer_it = peers->find(event.peer);
+            if (!stk_event && peer_it != peers->end())
             {
-                std::shared_ptr<STKPeer> peer = m_peers.at(event.peer);
-                lock.unlock();
+                std::shared_ptr<STKPeer> peer = peer_it->second;
                 if (isPingPacket(event.packet->data, event.packet->dataLength))
                 {
                     if (!is_server)
@@ -1218,7 +1352,23 @@ void STKHost::mainLoop(ProcessType pt)
             else
                 delete stk_event;
         }   // while enet_host_service
+
+        SimulatedNetwork* sn = getNetwork()->getSimulatedNetwork();
+        if (sn)
+            sn->update();
+
+        if (m_exit_timeout.load() > StkTime::getMonoTimeMs())
+        {
+            waitForNetworkEvents(host,
+                check_direct_socket ? direct_socket : NULL);
+        }
     }   // while m_exit_timeout.load() > StkTime::getMonoTimeMs()
+
+    std::unique_lock<std::mutex> lock(m_enet_cmd_mutex);
+    if (m_wakeup_socket != ENET_SOCKET_NULL)
+        enet_socket_destroy(m_wakeup_socket);
+    m_wakeup_socket = ENET_SOCKET_NULL;
+    lock.unlock();
     delete direct_socket;
     Log::info("STKHost", "Listening has been stopped.");
 }   // mainLoop
@@ -1240,7 +1390,7 @@ void STKHost::handleDirectSocketRequest(Network* direct_socket,
     char buffer[LEN];
 
     SocketAddress sender;
-    int len = direct_socket->receiveRawPacket(buffer, LEN, &sender, 1);
+    int len = direct_socket->receiveRawPacket(buffer, LEN, &sender, 0);
     if(len<=0) return;
     BareNetworkString message(buffer, len);
     std::string command;
@@ -1307,8 +1457,7 @@ void STKHost::handleDirectSocketRequest(Network* direct_socket,
  */
 bool STKHost::peerExists(const SocketAddress& peer)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto p : m_peers)
+    for (auto& p : *getPeersSnapshot())
     {
         auto stk_peer = p.second;
         if (stk_peer->getAddress() == peer ||
@@ -1327,11 +1476,44 @@ bool STKHost::peerExists(const SocketAddress& peer)
 std::shared_ptr<STKPeer> STKHost::getServerPeerForClient() const
 {
     assert(NetworkConfig::get()->isClient());
-    if (m_peers.size() != 1)
+    auto peers = getPeersSnapshot();
+    if (peers->size() != 1)
         return nullptr;
-    return m_peers.begin()->second;
+    return peers->begin()->second;
 }   // getServerPeerForClient
 
+//-----------------------------------------------------------------------------
+/** Sends the same data to many peers. The packets are encrypted for each
+ *  peer without holding any peer lock, and all of them are queued with a
+ *  single lock of \ref m_enet_cmd_mutex.
+ *  \param peers Peers to send the data to.
+ *  \param data Data to sent.
+ *  \param reliable If the data should be sent reliable or now.
+ */
+void STKHost::sendPacketToPeers(const std::vector<std::shared_ptr<STKPeer> >&
+                                peers, NetworkString *data, bool reliable)
+{
+    if (peers.empty())
+        return;
+
+    std::vector<ENetCommand> cmds;
+    cmds.reserve(peers.size());
+    for (auto& peer : peers)
+    {
+        ENetPacket* packet = peer->createPacket(data, reliable);
+        if (packet)
+        {
+            cmds.emplace_back(peer->getENetPeer(), packet,
+                EVENT_CHANNEL_NORMAL, ECT_SEND_PACKET,
+                peer->getENetAddress());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_enet_cmd_mutex);
+    m_enet_cmd.insert(m_enet_cmd.end(), cmds.begin(), cmds.end());
+    wakeUpListeningThread();
+}   // sendPacketToPeers
+
 //-----------------------------------------------------------------------------
 /** Sends data to all validated peers currently in server
  *  \param data Data to sent.
@@ -1339,12 +1521,13 @@ std::shared_ptr<STKPeer> STKHost::getServerPeerForClient() const
  */
 void STKHost::sendPacketToAllPeersInServer(NetworkString *data, bool reliable)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto p : m_peers)
+    std::vector<std::shared_ptr<STKPeer> > peers;
+    for (auto& p : *getPeersSnapshot())
     {
         if (p.second->isValidated())
-            p.second->sendPacket(data, reliable);
+            peers.push_back(p.second);
     }
+    sendPacketToPeers(peers, data, reliable);
 }   // sendPacketToAllPeersInServer
 
 //-----------------------------------------------------------------------------
@@ -1354,12 +1537,13 @@ void STKHost::sendPacketToAllPeersInServer(NetworkString *data, bool reliable)
  */
 void STKHost::sendPacketToAllPeers(NetworkString *data, bool reliable)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto p : m_peers)
+    std::vector<std::shared_ptr<STKPeer> > peers;
+    for (auto& p : *getPeersSnapshot())
     {
         if (p.second->isValidated() && !p.second->isWaitingForGame())
-            p.second->sendPacket(data, reliable);
+            peers.push_back(p.second);
     }
+    sendPacketToPeers(peers, data, reliable);
 }   // sendPacketToAllPeers
 
 //-----------------------------------------------------------------------------
@@ -1371,16 +1555,17 @@ void STKHost::sendPacketToAllPeers(NetworkString *data, bool reliable)
 void STKHost::sendPacketExcept(STKPeer* peer, NetworkString *data,
                                bool reliable)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto p : m_peers)
+    std::vector<std::shared_ptr<STKPeer> > peers;
+    for (auto& p : *getPeersSnapshot())
     {
         STKPeer* stk_peer = p.second.get();
         if (!stk_peer->isSamePeer(peer) && p.second->isValidated() &&
             !p.second->isWaitingForGame())
         {
-            stk_peer->sendPacket(data, reliable);
+            peers.push_back(p.second);
         }
     }
+    sendPacketToPeers(peers, data, reliable);
 }   // sendPacketExcept
 
 //-----------------------------------------------------------------------------
@@ -1392,26 +1577,27 @@ void STKHost::sendPacketExcept(STKPeer* peer, NetworkString *data,
 void STKHost::sendPacketToAllPeersWith(std::function<bool(STKPeer*)> predicate,
                                        NetworkString* data, bool reliable)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto p : m_peers)
+    std::vector<std::shared_ptr<STKPeer> > peers;
+    for (auto& p : *getPeersSnapshot())
     {
         STKPeer* stk_peer = p.second.get();
         if (!stk_peer->isValidated())
             continue;
         if (predicate(stk_peer))
-            stk_peer->sendPacket(data, reliable);
+            peers.push_back(p.second);
     }
+    sendPacketToPeers(peers, data, reliable);
 }   // sendPacketToAllPeersWith
 
 //-----------------------------------------------------------------------------
 /** Sends a message from a client to the server. */
 void STKHost::sendToServer(NetworkString *data, bool reliable)
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    if (m_peers.empty())
+    auto peers = getPeersSnapshot();
+    if (peers->empty())
         return;
     assert(NetworkConfig::get()->isClient());
-    m_peers.begin()->second->sendPacket(data, reliable);
+    peers->begin()->second->sendPacket(data, reliable);
 }   // sendToServer
 
 //-----------------------------------------------------------------------------
@@ -1419,8 +1605,7 @@ std::vector<std::shared_ptr<NetworkPlayerProfile> >
     STKHost::getAllPlayerProfiles() const
 {
     std::vector<std::shared_ptr<NetworkPlayerProfile> > p;
-    std::unique_lock<std::mutex> lock(m_peers_mutex);
-    for (auto& peer : m_peers)
+    for (auto& peer : *getPeersSnapshot())
     {
         if (peer.second->isDisconnected() || !peer.second->isValidated())
             continue;
@@ -1429,7 +1614,6 @@ std::vector<std::shared_ptr<NetworkPlayerProfile> >
         auto peer_profile = peer.second->getPlayerProfiles();
         p.insert(p.end(), peer_profile.begin(), peer_profile.end());
     }
-    lock.unlock();
     return p;
 }   // getAllPlayerProfiles
 
@@ -1437,8 +1621,7 @@ std::vector<std::shared_ptr<NetworkPlayerProfile> >
 std::set<uint32_t> STKHost::getAllPlayerOnlineIds() const
 {
     std::set<uint32_t> online_ids;
-    std::unique_lock<std::mutex> lock(m_peers_mutex);
-    for (auto& peer : m_peers)
+    for (auto& peer : *getPeersSnapshot())
     {
         if (peer.second->isDisconnected() || !peer.second->isValidated())
             continue;
@@ -1448,28 +1631,27 @@ std::set<uint32_t> STKHost::getAllPlayerOnlineIds() const
                 peer.second->getPlayerProfiles()[0]->getOnlineId());
         }
     }
-    lock.unlock();
     return online_ids;
 }   // getAllPlayerOnlineIds
 
 //-----------------------------------------------------------------------------
 std::shared_ptr<STKPeer> STKHost::findPeerByHostId(uint32_t id) const
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    auto ret = std::find_if(m_peers.begin(), m_peers.end(),
+    auto peers = getPeersSnapshot();
+    auto ret = std::find_if(peers->begin(), peers->end(),
         [id](const std::pair<ENetPeer*, std::shared_ptr<STKPeer> >& p)
         {
             return p.second->getHostId() == id;
         });
-    return ret != m_peers.end() ? ret->second : nullptr;
+    return ret != peers->end() ? ret->second : nullptr;
 }   // findPeerByHostId
 
 //-----------------------------------------------------------------------------
 std::shared_ptr<STKPeer>
     STKHost::findPeerByName(const core::stringw& name) const
 {
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    auto ret = std::find_if(m_peers.begin(), m_peers.end(),
+    auto peers = getPeersSnapshot();
+    auto ret = std::find_if(peers->begin(), peers->end(),
         [name](const std::pair<ENetPeer*, std::shared_ptr<STKPeer> >& p)
         {
             bool found = false;
@@ -1483,7 +1665,7 @@ std::shared_ptr<STKPeer>
             }
             return found;
         });
-    return ret != m_peers.end() ? ret->second : nullptr;
+    return ret != peers->end() ? ret->second : nullptr;
 }   // findPeerByName
 
 //-----------------------------------------------------------------------------
@@ -1500,7 +1682,10 @@ void STKHost::initClientNetwork(ENetEvent& event, Network* new_network)
     auto stk_peer = std::make_shared<STKPeer>(event.peer, this,
         m_next_unique_host_id++);
     stk_peer->setValidated(true);
+    std::unique_lock<std::mutex> lock(m_peers_mutex);
     m_peers[event.peer] = stk_peer;
+    publishPeers();
+    lock.unlock();
     auto pm = ProtocolManager::lock();
     if (pm && !pm->isExiting())
         pm->propagateEvent(new Event(&event, stk_peer));
@@ -1530,8 +1715,7 @@ std::vector<std::shared_ptr<NetworkPlayerProfile> >
     STKHost::getPlayersForNewGame(bool* has_always_on_spectators) const
 {
     std::vector<std::shared_ptr<NetworkPlayerProfile> > players;
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto& p : m_peers)
+    for (auto& p : *getPeersSnapshot())
     {
         auto& stk_peer = p.second;
         // Handle always spectate for peer
@@ -1564,8 +1748,7 @@ void STKHost::updatePlayers(unsigned* ingame, unsigned* waiting,
     uint32_t ingame_players = 0;
     uint32_t waiting_players = 0;
     uint32_t total_players = 0;
-    std::lock_guard<std::mutex> lock(m_peers_mutex);
-    for (auto& p : m_peers)
+    for (auto& p : *getPeersSnapshot())
     {
         auto& stk_peer = p.second;
         if (!stk_peer->isValidated())
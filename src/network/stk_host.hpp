@@ -69,6 +69,11 @@ enum ENetCommandType : unsigned int
     ECT_RESET = 2
 };
 
+/** Peer to receive, packet to send, integer data, command type and the
+ *  address of the peer when the command was created. */
+typedef std::tuple<ENetPeer*, ENetPacket*, uint32_t, ENetCommandType,
+    ENetAddress> ENetCommand;
+
 class STKHost
 {
 private:
@@ -86,20 +91,35 @@ private:
     /** Network console thread */
     std::thread m_network_console;
 
-    /** Make sure the removing or adding a peer is thread-safe. */
+    /** Make sure the removing or adding a peer is thread-safe, readers use
+     *  \ref m_peers_snapshot instead. */
     mutable std::mutex m_peers_mutex;
 
     /** Let (atm enet_peer_send and enet_peer_disconnect) run in the listening
      *  thread. */
-    std::vector<std::tuple</*peer receive*/ENetPeer*,
-        /*packet to send*/ENetPacket*, /*integer data*/uint32_t,
-        ENetCommandType, ENetAddress> > m_enet_cmd;
+    std::vector<ENetCommand> m_enet_cmd;
 
     /** Protect \ref m_enet_cmd from multiple threads usage. */
     std::mutex m_enet_cmd_mutex;
 
-    /** The list of peers connected to this instance. */
-    std::map<ENetPeer*, std::shared_ptr<STKPeer> > m_peers;
+    /** Loopback socket of the listening thread, a datagram sent to it wakes
+     *  up the thread if it is waiting for network events. Protected by
+     *  \ref m_enet_cmd_mutex. */
+    ENetSocket m_wakeup_socket;
+
+    /** True if a wake up datagram was sent which the listening thread has
+     *  not handled yet. Protected by \ref m_enet_cmd_mutex. */
+    bool m_wakeup_pending;
+
+    typedef std::map<ENetPeer*, std::shared_ptr<STKPeer> > PeerMap;
+
+    /** The list of peers connected to this instance, only used with
+     *  \ref m_peers_mutex locked. */
+    PeerMap m_peers;
+
+    /** Immutable copy of \ref m_peers which is replaced after each change of
+     *  it, so readers can iterate the peers without locking. */
+    std::shared_ptr<const PeerMap> m_peers_snapshot;
 
     /** Next unique host id. It is increased whenever a new peer is added (see
      *  getPeer()), but not decreased whena host (=peer) disconnects. This
@@ -286,11 +306,34 @@ public:
     // ------------------------------------------------------------------------
     void setErrorMessage(const irr::core::stringw &message);
     // ------------------------------------------------------------------------
+    void sendPacketToPeers(const std::vector<std::shared_ptr<STKPeer> >& peers,
+                           NetworkString *data, bool reliable);
+    // ------------------------------------------------------------------------
+    void createWakeupSocket();
+    // ------------------------------------------------------------------------
+    /** Publishes the current peers for readers, \ref m_peers_mutex must be
+     *  locked by the caller. */
+    void publishPeers()
+    {
+        std::atomic_store(&m_peers_snapshot,
+            std::make_shared<const PeerMap>(m_peers));
+    }
+    // ------------------------------------------------------------------------
+    /** Returns the peers when they were last changed, it stays valid and
+     *  unchanged while it is used. */
+    std::shared_ptr<const PeerMap> getPeersSnapshot() const
+                               { return std::atomic_load(&m_peers_snapshot); }
+    // ------------------------------------------------------------------------
+    void wakeUpListeningThread();
+    // ------------------------------------------------------------------------
+    void waitForNetworkEvents(ENetHost* host, Network* direct_socket);
+    // ------------------------------------------------------------------------
     void addEnetCommand(ENetPeer* peer, ENetPacket* packet, uint32_t i,
                         ENetCommandType ect, ENetAddress ea)
     {
         std::lock_guard<std::mutex> lock(m_enet_cmd_mutex);
         m_enet_cmd.emplace_back(peer, packet, i, ect, ea);
+        wakeUpListeningThread();
     }
     // ------------------------------------------------------------------------
     /** Returns the last error (or "" if no error has happened). */
@@ -312,9 +355,8 @@ public:
     /** Returns a copied list of peers. */
     std::vector<std::shared_ptr<STKPeer> > getPeers() const
     {
-        std::lock_guard<std::mutex> lock(m_peers_mutex);
         std::vector<std::shared_ptr<STKPeer> > peers;
-        for (auto p : m_peers)
+        for (auto& p : *getPeersSnapshot())
         {
             peers.push_back(p.second);
         }
@@ -333,8 +375,7 @@ public:
     /** Returns the number of currently connected peers. */
     unsigned int getPeerCount() const
     {
-        std::lock_guard<std::mutex> lock(m_peers_mutex);
-        return (unsigned)m_peers.size();
+        return (unsigned)getPeersSnapshot()->size();
     }
     // ------------------------------------------------------------------------
     /** Sets the global host id of this host (client use). */
@@ -101,9 +101,27 @@ void STKPeer::reset()
  *  \param encrypted If the data is sent encrypted or not.
  */
 void STKPeer::sendPacket(NetworkString *data, bool reliable, bool encrypted)
+{
+    ENetPacket* packet = createPacket(data, reliable, encrypted);
+    if (packet)
+    {
+        m_host->addEnetCommand(m_enet_peer, packet,
+                encrypted ? EVENT_CHANNEL_NORMAL : EVENT_CHANNEL_UNENCRYPTED,
+                ECT_SEND_PACKET, m_address);
+    }
+}   // sendPacket
+
+//-----------------------------------------------------------------------------
+/** Creates the (encrypted if supported) packet to send the data to this
+ *  peer, the packet still needs to be queued in STKHost.
+ *  \return The packet, or NULL if this peer is disconnected or encryption
+ *          failed.
+ */
+ENetPacket* STKPeer::createPacket(NetworkString *data, bool reliable,
+                                  bool encrypted)
 {
     if (m_disconnected.load())
-        return;
+        return NULL;
 
     ENetPacket* packet = NULL;
     if (m_crypto && encrypted)
@@ -119,19 +137,14 @@ void STKPeer::sendPacket(NetworkString *data, bool reliable, bool encrypted)
             ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT)));
     }
 
-    if (packet)
+    if (packet && Network::m_connection_debug)
     {
-        if (Network::m_connection_debug)
-        {
-            Log::verbose("STKPeer", "sending packet of size %d to %s at %lf",
-                packet->dataLength, getAddress().toString().c_str(),
-                StkTime::getRealTime());
-        }
-        m_host->addEnetCommand(m_enet_peer, packet,
-                encrypted ? EVENT_CHANNEL_NORMAL : EVENT_CHANNEL_UNENCRYPTED,
-                ECT_SEND_PACKET, m_address);
+        Log::verbose("STKPeer", "sending packet of size %d to %s at %lf",
+            packet->dataLength, getAddress().toString().c_str(),
+            StkTime::getRealTime());
     }
-}   // sendPacket
+    return packet;
+}   // createPacket
 
 //-----------------------------------------------------------------------------
 /** Returns if the peer is connected or not.
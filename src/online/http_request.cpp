@@ -195,28 +195,80 @@ namespace Online
      */
     void HTTPRequest::operation()
     {
+        if (!m_curl_session || !beginTransfer())
+            return;
+
+        m_curl_code = curl_easy_perform(m_curl_session);
+        Request::operation();
+        endTransfer();
+    }   // operation
+
+    // ------------------------------------------------------------------------
+    /** Prepares this request to be run by the curl multi handle of the
+     *  RequestManager. This does the same as \ref execute up to the actual
+     *  transfer, which is done by the RequestManager; once it is finished
+     *  \ref finishTransfer must be called.
+     *  \param share A curl share handle to reuse TLS sessions, can be NULL.
+     *  \return The curl handle to add to the multi handle, or NULL if the
+     *          transfer could not be started.
+     */
+    CURL* HTTPRequest::startTransfer(CURLSH *share)
+    {
+        assert(isBusy());
+        prepareOperation();
         if (!m_curl_session)
+            return NULL;
+        if (share)
+            curl_easy_setopt(m_curl_session, CURLOPT_SHARE, share);
+        if (!beginTransfer())
+            return NULL;
+        return m_curl_session;
+    }   // startTransfer
+
+    // ------------------------------------------------------------------------
+    /** Called by the RequestManager once the transfer started with
+     *  \ref startTransfer is finished (and its curl handle was removed from
+     *  the multi handle). It does the rest of \ref execute.
+     *  \param code The curl result of the transfer.
+     */
+    void HTTPRequest::finishTransfer(CURLcode code)
+    {
+        m_curl_code = code;
+        endTransfer();
+        if (RequestManager::get()->getAbort() && isAbortable())
+        {
+            // The share handle of the RequestManager must not be used by
+            // this curl handle anymore when it is deleted
+            freeSession();
             return;
+        }
+        setExecuted();
+        afterOperation();
+    }   // finishTransfer
 
-        FILE *fout = NULL;
+    // ------------------------------------------------------------------------
+    /** Sets where the downloaded data is written to and the POST parameters.
+     *  \return False if the file to download into can not be opened.
+     */
+    bool HTTPRequest::beginTransfer()
+    {
         if (m_filename.size() > 0)
         {
-            fout = FileUtils::fopenU8Path(m_filename + ".part", "wb");
+            m_file = FileUtils::fopenU8Path(m_filename + ".part", "wb");
 
-            if (!fout)
+            if (!m_file)
             {
                 Log::error("HTTPRequest",
                            "Can't open '%s' for writing, ignored.",
                            (m_filename+".part").c_str());
-                return;
+                return false;
             }
-            curl_easy_setopt(m_curl_session,  CURLOPT_WRITEDATA,     fout  );
+            curl_easy_setopt(m_curl_session,  CURLOPT_WRITEDATA,     m_file);
             curl_easy_setopt(m_curl_session,  CURLOPT_WRITEFUNCTION, fwrite);
         }
         else
         {
-            curl_easy_setopt(m_curl_session, CURLOPT_WRITEDATA,
-                             &m_string_buffer);
+            curl_easy_setopt(m_curl_session, CURLOPT_WRITEDATA, this);
             curl_easy_setopt(m_curl_session, CURLOPT_WRITEFUNCTION,
                              &HTTPRequest::writeCallback);
         }
@@ -269,12 +321,19 @@ namespace Online
         const std::string& uagent = StringUtils::getUserAgentString();
         curl_easy_setopt(m_curl_session, CURLOPT_USERAGENT, uagent.c_str());
 
-        m_curl_code = curl_easy_perform(m_curl_session);
-        Request::operation();
+        return true;
+    }   // beginTransfer
 
-        if (fout)
+    // ------------------------------------------------------------------------
+    /** Closes the file the data was downloaded into, and moves it to its
+     *  final name if the transfer was successful.
+     */
+    void HTTPRequest::endTransfer()
+    {
+        if (m_file)
         {
-            fclose(fout);
+            fclose(m_file);
+            m_file = NULL;
             if (m_curl_code == CURLE_OK)
             {
                 if(UserConfigParams::logAddons())
@@ -298,8 +357,8 @@ namespace Online
                     m_curl_code = CURLE_WRITE_ERROR;
                 }
             }   // m_curl_code ==CURLE_OK
-        }   // if fout
-    }   // operation
+        }   // if m_file
+    }   // endTransfer
 
     // ------------------------------------------------------------------------
     /** Cleanup once the download is finished. The value of progress is
@@ -314,6 +373,14 @@ namespace Online
             setProgress(-1.0f);
 
         Request::afterOperation();
+        freeSession();
+    }   // afterOperation
+
+    // ------------------------------------------------------------------------
+    /** Frees the curl data structures of this request.
+     */
+    void HTTPRequest::freeSession()
+    {
         if (m_http_header)
         {
             curl_slist_free_all(m_http_header);
@@ -324,21 +391,21 @@ namespace Online
             curl_easy_cleanup(m_curl_session);
             m_curl_session = NULL;
         }
-    }   // afterOperation
+    }   // freeSession
 
     // ------------------------------------------------------------------------
-    /** Callback from curl. This stores the data received by curl in the
-     *  buffer of this request.
+    /** Callback from curl. This passes the data received by curl to
+     *  \ref writeData of the request.
      *  \param content Pointer to the data received by curl.
      *  \param size Size of one block.
      *  \param nmemb Number of blocks received.
-     *  \param userp Pointer to the user buffer.
+     *  \param userp Pointer to the request.
      */
     size_t HTTPRequest::writeCallback(void *contents, size_t size,
                                       size_t nmemb, void *userp)
     {
-        ((std::string*)userp)->append((char*)contents, size * nmemb);
-        return size * nmemb;
+        return ((HTTPRequest*)userp)->writeData((const char*)contents,
+                                                size * nmemb);
     }   // writeCallback
 
     // ----------------------------------------------------------------------------
@@ -80,6 +80,13 @@ namespace Online
         std::string m_string_buffer;
 
         struct curl_slist* m_http_header = NULL;
+
+        /** File the data is written to while downloading into a file. */
+        FILE *m_file = NULL;
+
+        bool beginTransfer();
+        void endTransfer();
+        void freeSession();
     protected:
         /** Contains a filename if the data should be saved into a file
          *  instead of being kept in in memory. Otherwise this is "". */
@@ -100,6 +107,17 @@ namespace Online
 
         static size_t writeCallback(void *contents, size_t size,
                                     size_t nmemb,   void *userp);
+        // --------------------------------------------------------------------
+        /** Called from the RequestManager thread with each block of data
+         *  received, unless the data is saved into a file. It can be
+         *  overwritten to process data while it is downloaded.
+         *  \return The number of bytes handled, anything else than size
+         *          aborts the download. */
+        virtual size_t writeData(const char *data, size_t size)
+        {
+            m_string_buffer.append(data, size);
+            return size;
+        }   // writeData
         void init();
 
     public :
@@ -117,9 +135,16 @@ namespace Online
             }
         }
         virtual bool       isAllowedToAdd() const OVERRIDE;
+        CURL*              startTransfer(CURLSH *share);
+        void               finishTransfer(CURLcode code);
         void               setApiURL(const std::string& url, const std::string &action);
         void               setAddonsURL(const std::string& path);
 
+        // ------------------------------------------------------------------------
+        /** Returns if this request is a plain curl transfer, which the
+         *  RequestManager can run concurrently with other transfers. Requests
+         *  that replace \ref operation must return false. */
+        virtual bool supportsConcurrentTransfer() const        { return true; }
         // ------------------------------------------------------------------------
         /** Returns true if there was an error downloading the file. */
         virtual bool hadDownloadError() const { return m_curl_code != CURLE_OK; }
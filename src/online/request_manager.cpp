@@ -22,9 +22,11 @@
 
 #include "config/player_manager.hpp"
 #include "config/user_config.hpp"
+#include "online/http_request.hpp"
 #include "states_screens/state_manager.hpp"
 #include "utils/vs.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <stdio.h>
@@ -76,12 +78,36 @@ namespace Online
         m_time_since_poll       = m_menu_polling_interval;
         curl_global_init(CURL_GLOBAL_DEFAULT);
         m_abort.setAtomic(false);
+
+        m_num_transfers            = 0;
+        m_num_new_connections      = 0;
+        m_max_concurrent_transfers = 0;
+        m_total_transfer_time      = 0.0;
+        m_max_transfer_time        = 0.0;
+        m_curl_multi = curl_multi_init();
+        if (!m_curl_multi)
+        {
+            Log::warn("RequestManager", "Can't create curl multi handle, "
+                "requests will be executed one at a time.");
+        }
+        m_curl_share = curl_share_init();
+        if (m_curl_share)
+        {
+            curl_share_setopt(m_curl_share, CURLSHOPT_SHARE,
+                CURL_LOCK_DATA_SSL_SESSION);
+        }
     }   // RequestManager
 
     // ------------------------------------------------------------------------
     RequestManager::~RequestManager()
     {
         m_thread.join();
+        // The thread only exits once all transfers are finished
+        assert(m_transfers.empty());
+        if (m_curl_multi)
+            curl_multi_cleanup(m_curl_multi);
+        if (m_curl_share)
+            curl_share_cleanup(m_curl_share);
         curl_global_cleanup();
     }   // ~RequestManager
 
@@ -161,6 +187,12 @@ namespace Online
 
         // Wake up the network http thread
         m_condition_variable.notify_one();
+        // curl_multi_wakeup is available since libcurl 7.68.0
+#if LIBCURL_VERSION_NUM >= 0x074400
+        // In case it is waiting for running transfers
+        if (m_curl_multi)
+            curl_multi_wakeup(m_curl_multi);
+#endif
         m_request_queue.unlock();
     }   // addRequest
 
@@ -175,43 +207,59 @@ namespace Online
         VS::setThreadName("RequestManager");
         RequestManager *me = (RequestManager*) obj;
 
-        me->m_current_request = nullptr;
         std::unique_lock<std::mutex> ul = me->m_request_queue.acquireMutex();
-        while (me->m_request_queue.getData().empty() ||
-               me->m_request_queue.getData().top()->getType() != Request::RT_QUIT)
+        while (true)
         {
-            bool empty = me->m_request_queue.getData().empty();
+            auto& queue = me->m_request_queue.getData();
 
-            // Wait in cond_wait for a request to arrive. The 'while' is necessary
+            // The quit request is only handled once all transfers started
+            // before it are finished (aborted transfers finish quickly).
+            if (!queue.empty() && queue.top()->getType() == Request::RT_QUIT &&
+                me->m_transfers.empty())
+                break;
+
+            // Wait in cond_wait for a request to arrive. The loop is necessary
             // since "spurious wakeups from the pthread_cond_wait ... may occur"
             // (pthread_cond_wait man page)!
-            while (empty)
+            if (queue.empty() && me->m_transfers.empty())
             {
                 me->m_condition_variable.wait(ul);
-                empty = me->m_request_queue.getData().empty();
+                continue;
             }
             // We pause the request manager thread when going into background in iOS
             // So this will only be evaluated a while
             if (me->m_paused.load())
                 StkTime::sleep(1);
-            me->m_current_request = me->m_request_queue.getData().top();
-            me->m_request_queue.getData().pop();
 
-            if (me->m_current_request->getType() == Request::RT_QUIT)
+            // Take as many requests as there are free transfer slots
+            const unsigned max_transfers =
+                std::max((int)UserConfigParams::m_max_concurrent_requests, 1);
+            std::vector<std::shared_ptr<Request> > requests;
+            while (!queue.empty() &&
+                   queue.top()->getType() != Request::RT_QUIT &&
+                   me->m_transfers.size() + requests.size() < max_transfers)
             {
-                break;
+                requests.push_back(queue.top());
+                queue.pop();
             }
 
             ul.unlock();
-            me->m_current_request->execute();
-            // This test is necessary in case that execute() was aborted
-            // (otherwise the assert in addResult will be triggered).
-            if (!me->getAbort())
-                me->addResult(me->m_current_request);
-            me->m_current_request = nullptr;
+            for (std::shared_ptr<Request>& request : requests)
+                me->startRequest(request);
+            me->performTransfers();
             ul = me->m_request_queue.acquireMutex();
         } // while handle all requests
 
+        if (me->m_num_transfers > 0)
+        {
+            Log::info("RequestManager", "%u transfers, %u new connections, "
+                "average %.0fms, longest %.0fms, up to %u at the same time.",
+                me->m_num_transfers, me->m_num_new_connections,
+                me->m_total_transfer_time * 1000.0 / me->m_num_transfers,
+                me->m_max_transfer_time * 1000.0,
+                me->m_max_concurrent_transfers);
+        }
+
         // Signal that the request manager can now be deleted.
         // We signal this even before cleaning up memory, since there's no
         // need to keep the user waiting for STK to exit.
@@ -224,6 +272,110 @@ namespace Online
         }
     }   // mainLoop
 
+    // ------------------------------------------------------------------------
+    /** Starts a request taken from the request queue. HTTP requests are added
+     *  to the curl multi handle, any other request is executed immediately.
+     *  \param request The request to start.
+     */
+    void RequestManager::startRequest(std::shared_ptr<Online::Request> request)
+    {
+        // Abort as early as possible if abort is requested
+        if (getAbort() && request->isAbortable())
+            return;
+
+        std::shared_ptr<HTTPRequest> http =
+            std::dynamic_pointer_cast<HTTPRequest>(request);
+        if (!http || !http->supportsConcurrentTransfer() || !m_curl_multi)
+        {
+            request->execute();
+            // This test is necessary in case that execute() was aborted
+            // (otherwise the assert in addResult will be triggered).
+            if (!getAbort())
+                addResult(request);
+            return;
+        }
+
+        CURL *curl = http->startTransfer(m_curl_share);
+        if (!curl)
+        {
+            http->finishTransfer(CURLE_FAILED_INIT);
+            if (!getAbort())
+                addResult(request);
+            return;
+        }
+        m_transfers[curl] = http;
+        curl_multi_add_handle(m_curl_multi, curl);
+        m_max_concurrent_transfers =
+            std::max(m_max_concurrent_transfers, (unsigned)m_transfers.size());
+    }   // startRequest
+
+    // ------------------------------------------------------------------------
+    /** Lets curl work on all running transfers and finishes the completed
+     *  ones. Then it waits for network activity for up to 100ms (or until
+     *  \ref addRequest wakes it up with newer libcurl), so new requests can
+     *  be started in the main loop.
+     */
+    void RequestManager::performTransfers()
+    {
+        if (m_transfers.empty())
+            return;
+
+        int running = 0;
+        curl_multi_perform(m_curl_multi, &running);
+
+        int msgs_left = 0;
+        CURLMsg *msg = NULL;
+        while ((msg = curl_multi_info_read(m_curl_multi, &msgs_left)) != NULL)
+        {
+            if (msg->msg == CURLMSG_DONE)
+                finishTransfer(msg->easy_handle, msg->data.result);
+        }
+
+        if (m_transfers.empty())
+            return;
+        // curl_multi_poll is available since libcurl 7.66.0
+#if LIBCURL_VERSION_NUM >= 0x074200
+        curl_multi_poll(m_curl_multi, NULL, 0, 100, NULL);
+#else
+        curl_multi_wait(m_curl_multi, NULL, 0, 100, NULL);
+#endif
+    }   // performTransfers
+
+    // ------------------------------------------------------------------------
+    /** Removes a completed transfer from the curl multi handle, records its
+     *  latency and passes its result to the request.
+     *  \param curl The curl handle of the transfer.
+     *  \param code The curl result of the transfer.
+     */
+    void RequestManager::finishTransfer(CURL *curl, CURLcode code)
+    {
+        auto it = m_transfers.find(curl);
+        assert(it != m_transfers.end());
+        std::shared_ptr<HTTPRequest> request = it->second;
+        m_transfers.erase(it);
+
+        double total = 0.0, connect = 0.0, tls = 0.0;
+        long new_connections = 0;
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &tls);
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+        m_num_transfers++;
+        m_num_new_connections += (unsigned)new_connections;
+        m_total_transfer_time += total;
+        m_max_transfer_time = std::max(m_max_transfer_time, total);
+        Log::debug("RequestManager", "%s took %.0fms (connect %.0fms, "
+            "tls %.0fms%s).", request->getURL().c_str(), total * 1000.0,
+            connect * 1000.0, tls * 1000.0,
+            new_connections == 0 ? ", reused connection" : "");
+
+        curl_multi_remove_handle(m_curl_multi, curl);
+        request->finishTransfer(code);
+        // Same as in startRequest, aborted requests are not executed
+        if (!getAbort())
+            addResult(request);
+    }   // finishTransfer
+
     // ------------------------------------------------------------------------
     /** Inserts a request into the queue of results.
      *  \param request The pointer to the request to insert.
@@ -36,12 +36,15 @@
 #include <atomic>
 #include <condition_variable>
 #include <curl/curl.h>
+#include <map>
 #include <memory>
 #include <queue>
 #include <thread>
 
 namespace Online
 {
+    class HTTPRequest;
+
     /** A class to execute requests in a separate thread. Typically the
      *  requests involve a http(s) requests to be sent to the stk server, and
      *  receive an answer (e.g. to sign in; or to download an addon). The
@@ -74,6 +77,10 @@ namespace Online
      *  on first start of stk (which will trigger downloading of all addon
      *  icons) is it possible that actually a download request is running,
      *  which might take a bit before it can be deleted.
+     *  HTTP requests are run concurrently (up to the max_concurrent_requests
+     *  user config value) by a curl multi handle, which keeps connections
+     *  to the same host open, and TLS sessions are shared between them.
+     *  Other requests are executed directly in the RequestManager thread.
      * \ingroup online
      */
     class RequestManager : public CanBeDeleted
@@ -96,8 +103,24 @@ namespace Online
             /** Time passed since the last poll request. */
             float                     m_time_since_poll;
 
-            /** The current requested being worked on. */
-            std::shared_ptr<Online::Request> m_current_request;
+            /** Curl multi handle which runs all concurrent transfers. */
+            CURLM*                    m_curl_multi;
+
+            /** Shares TLS sessions between transfers, so connecting again
+             *  to the same host does not need a full handshake. */
+            CURLSH*                   m_curl_share;
+
+            /** The transfers currently run by \ref m_curl_multi, only
+             *  accessed by the RequestManager thread. */
+            std::map<CURL*, std::shared_ptr<HTTPRequest> > m_transfers;
+
+            /** Statistics about the finished transfers, only accessed by the
+             *  RequestManager thread. */
+            unsigned                  m_num_transfers;
+            unsigned                  m_num_new_connections;
+            unsigned                  m_max_concurrent_transfers;
+            double                    m_total_transfer_time;
+            double                    m_max_transfer_time;
 
             /** A conditional variable to wake up the main loop. */
             std::condition_variable   m_condition_variable;
@@ -133,6 +156,9 @@ namespace Online
 
             void addResult(std::shared_ptr<Online::Request> request);
             void handleResultQueue();
+            void startRequest(std::shared_ptr<Online::Request> request);
+            void performTransfers();
+            void finishTransfer(CURL *curl, CURLcode code);
 
             static void mainLoop(void *obj);
 
@@ -171,6 +171,16 @@ PhysicalObject::PhysicalObject(bool is_dynamic,
     m_reset_height       = settings.m_reset_height;
     m_on_kart_collision  = settings.m_on_kart_collision;
     m_on_item_collision  = settings.m_on_item_collision;
+    if (!m_on_kart_collision.empty())
+    {
+        m_on_kart_collision_script.setDeclaration("void " +
+            m_on_kart_collision + "(int, const string, const string)");
+    }
+    if (!m_on_item_collision.empty())
+    {
+        m_on_item_collision_script.setDeclaration("void " +
+            m_on_item_collision + "(int, int, const string)");
+    }
     m_current_transform.setOrigin(Vec3());
     m_current_transform.setRotation(
         btQuaternion(0.0f, 0.0f, 0.0f, 1.0f));
@@ -698,6 +708,16 @@ bool PhysicalObject::castRay(const btVector3 &from, const btVector3 &to,
         Log::warn("PhysicalObject", "Can only raycast against 'exact' meshes.");
         return false;
     }
+    // Most driveable objects are far away from the ray, so first test the
+    // (cheap) bounding box before raycasting against the mesh.
+    if (m_body)
+    {
+        btVector3 aabb_min, aabb_max, aabb_normal;
+        btScalar param = 1.0f;
+        m_body->getAabb(aabb_min, aabb_max);
+        if (!btRayAabb(from, to, aabb_min, aabb_max, param, aabb_normal))
+            return false;
+    }
     bool result = m_triangle_mesh->castRay(from, to, hit_point, 
                                            material, normal, 
                                            interpolate_normal);
@@ -26,6 +26,7 @@
 #include "network/rewinder.hpp"
 #include "network/smooth_network_body.hpp"
 #include "physics/user_pointer.hpp"
+#include "scriptengine/script_function.hpp"
 #include "utils/vec3.hpp"
 
 class Material;
@@ -178,6 +179,10 @@ private:
     * when a (flyable) item collides with this object
     */
     std::string           m_on_item_collision;
+    /** The script functions called on collisions, declared once here so
+     *  that a collision doesn't need to build the declaration. */
+    Scripting::ScriptFunction m_on_kart_collision_script;
+    Scripting::ScriptFunction m_on_item_collision_script;
     /** If this body is a bullet dynamic body, i.e. affected by physics
      *  or not (static (not moving) or kinematic (animated outside
      *  of physics). */
@@ -251,7 +256,17 @@ public:
     // ------------------------------------------------------------------------
     const std::string& getOnItemCollisionFunction() const { return m_on_item_collision; }
     // ------------------------------------------------------------------------
-    TrackObject* getTrackObject() { return m_object; }
+    /** Returns the script function to call when a kart collides with this
+     *  object, which is empty if there is none. */
+    Scripting::ScriptFunction& getOnKartCollisionScript()
+                                         { return m_on_kart_collision_script; }
+    // ------------------------------------------------------------------------
+    /** Returns the script function to call when an item collides with this
+     *  object, which is empty if there is none. */
+    Scripting::ScriptFunction& getOnItemCollisionScript()
+                                         { return m_on_item_collision_script; }
+    // ------------------------------------------------------------------------
+    TrackObject* getTrackObject() const { return m_object; }
 
     // Methods usable by scripts
 
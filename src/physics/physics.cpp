@@ -89,6 +89,10 @@ Physics::Physics() : btSequentialImpulseConstraintSolver()
 void Physics::init(const Vec3 &world_min, const Vec3 &world_max)
 {
     m_physics_loop_active = false;
+    m_collisions_collected  = false;
+    m_num_solve_group_calls = 0;
+    m_num_manifolds         = 0;
+    m_num_contact_manifolds = 0;
     m_axis_sweep          = new btAxisSweep3(world_min, world_max);
     m_dynamics_world      = new STKDynamicsWorld(m_dispatcher,
                                                  m_axis_sweep,
@@ -188,6 +192,10 @@ void Physics::update(int ticks)
     // are stored in a vector, but only one entry per collision pair
     // of objects.
     m_all_collisions.clear();
+    m_collisions_collected  = false;
+    m_num_solve_group_calls = 0;
+    m_num_manifolds         = 0;
+    m_num_contact_manifolds = 0;
 
     // Since the world update (which calls physics update) is called at the
     // fixed frequency necessary for the physics update, we need to do exactly
@@ -202,6 +210,20 @@ void Physics::update(int ticks)
         Log::verbose("Physics", "At %d physics duration %12.8f",
                      World::getWorld()->getTicksSinceStart(),
                      StkTime::getRealTime() - start);
+        Log::verbose("Physics", "At %d solve groups %u manifolds %u "
+                     "contacts %u kart-kart %u kart-object %u "
+                     "kart-animation %u flyable-track %u flyable-object %u "
+                     "flyable-kart %u flyable-flyable %u",
+                     World::getWorld()->getTicksSinceStart(),
+                     m_num_solve_group_calls, m_num_manifolds,
+                     m_num_contact_manifolds,
+                     getNumCollisions(CT_KART_KART),
+                     getNumCollisions(CT_KART_PHYSICAL_OBJECT),
+                     getNumCollisions(CT_KART_ANIMATION),
+                     getNumCollisions(CT_FLYABLE_TRACK),
+                     getNumCollisions(CT_FLYABLE_PHYSICAL_OBJECT),
+                     getNumCollisions(CT_FLYABLE_KART),
+                     getNumCollisions(CT_FLYABLE_FLYABLE));
     }
 
     // Now handle the actual collision. Note: flyables can not be removed
@@ -213,51 +235,56 @@ void Physics::update(int ticks)
     bool is_child = STKProcess::getType() == PT_CHILD;
     for(p=m_all_collisions.begin(); p!=m_all_collisions.end(); ++p)
     {
-        // Kart-kart collision
-        // --------------------
-        if(p->getUserPointer(0)->is(UserPointer::UP_KART))
+        switch(p->getType())
+        {
+        case CT_KART_KART:
         {
+            // Kart-kart collision
+            // --------------------
             KartKartCollision(p->getUserPointer(0)->getPointerKart(),
                               p->getContactPointCS(0),
                               p->getUserPointer(1)->getPointerKart(),
                               p->getContactPointCS(1)                );
             if (!is_child)
             {
+                static Scripting::ScriptFunction on_kart_kart_collision(
+                    "void onKartKartCollision(int, int)");
                 Scripting::ScriptEngine* script_engine =
                                                 Scripting::ScriptEngine::getInstance();
                 int kartid1 = p->getUserPointer(0)->getPointerKart()->getWorldKartId();
                 int kartid2 = p->getUserPointer(1)->getPointerKart()->getWorldKartId();
-                script_engine->runFunction(false, "void onKartKartCollision(int, int)",
+                script_engine->runFunction(false, on_kart_kart_collision,
                     [=](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, kartid1);
                         ctx->SetArgDWord(1, kartid2);
                     });
             }
-            continue;
-        }  // if kart-kart collision
+            break;
+        }   // kart-kart collision
 
-        if(p->getUserPointer(0)->is(UserPointer::UP_PHYSICAL_OBJECT))
+        case CT_KART_PHYSICAL_OBJECT:
         {
             // Kart hits physical object
             // -------------------------
             AbstractKart *kart = p->getUserPointer(1)->getPointerKart();
             int kartId = kart->getWorldKartId();
             PhysicalObject* obj = p->getUserPointer(0)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnKartCollisionFunction();
-
-            TrackObject* to = obj->getTrackObject();
-            TrackObject* library = to->getParentLibrary();
-            std::string lib_id;
-            std::string* lib_id_ptr = NULL;
-            if (library != NULL)
-                lib_id = library->getID();
-            lib_id_ptr = &lib_id;
-
-            if (!is_child && scripting_function.size() > 0)
+            Scripting::ScriptFunction& scripting_function =
+                obj->getOnKartCollisionScript();
+
+            if (!is_child && !scripting_function.empty())
             {
+                std::string obj_id = obj->getID();
+                TrackObject* to = obj->getTrackObject();
+                TrackObject* library = to->getParentLibrary();
+                std::string lib_id;
+                std::string* lib_id_ptr = NULL;
+                if (library != NULL)
+                    lib_id = library->getID();
+                lib_id_ptr = &lib_id;
+
                 Scripting::ScriptEngine* script_engine = Scripting::ScriptEngine::getInstance();
-                script_engine->runFunction(true, "void " + scripting_function + "(int, const string, const string)",
+                script_engine->runFunction(true, scripting_function,
                     [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, kartId);
                         ctx->SetArgObject(1, lib_id_ptr);
@@ -293,10 +320,10 @@ void Physics::update(int ticks)
                 SoccerWorld* soccerWorld = (SoccerWorld*)World::getWorld();
                 soccerWorld->setBallHitter(kartId);
             }
-            continue;
-        }
+            break;
+        }   // kart-physical object collision
 
-        if (p->getUserPointer(0)->is(UserPointer::UP_ANIMATION))
+        case CT_KART_ANIMATION:
         {
             // Kart hits animation
             ThreeDAnimation *anim=p->getUserPointer(0)->getPointerAnimation();
@@ -328,29 +355,30 @@ void Physics::update(int ticks)
                 }
 
             }
-            continue;
+            break;
+        }   // kart-animation collision
 
-        }
-        // now the first object must be a projectile
-        // =========================================
-        if(p->getUserPointer(1)->is(UserPointer::UP_TRACK))
-        {
+        // In all remaining collisions the first object is a projectile
+        // =============================================================
+        case CT_FLYABLE_TRACK:
             // Projectile hits track
             // ---------------------
             p->getUserPointer(0)->getPointerFlyable()->hitTrack();
-        }
-        else if(p->getUserPointer(1)->is(UserPointer::UP_PHYSICAL_OBJECT))
+            break;
+
+        case CT_FLYABLE_PHYSICAL_OBJECT:
         {
             // Projectile hits physical object
             // -------------------------------
             Flyable* flyable = p->getUserPointer(0)->getPointerFlyable();
             PhysicalObject* obj = p->getUserPointer(1)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnItemCollisionFunction();
-            if (!is_child && scripting_function.size() > 0)
+            Scripting::ScriptFunction& scripting_function =
+                obj->getOnItemCollisionScript();
+            if (!is_child && !scripting_function.empty())
             {
+                std::string obj_id = obj->getID();
                 Scripting::ScriptEngine* script_engine = Scripting::ScriptEngine::getInstance();
-                script_engine->runFunction(true, "void " + scripting_function + "(int, int, const string)",
+                script_engine->runFunction(true, scripting_function,
                         [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, (int)flyable->getType());
                         ctx->SetArgDWord(1, flyable->getOwnerId());
@@ -362,23 +390,24 @@ void Physics::update(int ticks)
             if (obj->isSoccerBall() && 
                 RaceManager::get()->getMinorMode() == RaceManager::MINOR_MODE_SOCCER)
             {
-                int kartId = p->getUserPointer(0)->getPointerFlyable()->getOwnerId();
+                int kartId = flyable->getOwnerId();
                 SoccerWorld* soccerWorld = (SoccerWorld*)World::getWorld();
                 soccerWorld->setBallHitter(kartId);
             }
+            break;
+        }   // flyable-physical object collision
 
-        }
-        else if(p->getUserPointer(1)->is(UserPointer::UP_KART))
+        case CT_FLYABLE_KART:
         {
             // Projectile hits kart
             // --------------------
             // Only explode a bowling ball if the target is
             // not invulnerable
             AbstractKart* target_kart = p->getUserPointer(1)->getPointerKart();
-            PowerupManager::PowerupType type = p->getUserPointer(0)->getPointerFlyable()->getType();
+            Flyable *f = p->getUserPointer(0)->getPointerFlyable();
+            PowerupManager::PowerupType type = f->getType();
             if(type != PowerupManager::POWERUP_BOWLING || !target_kart->isInvulnerable())
             {
-                Flyable *f = p->getUserPointer(0)->getPointerFlyable();
                 f->hit(target_kart);
 
                 // Check for achievements
@@ -400,15 +429,20 @@ void Physics::update(int ticks)
                     }   // is bowling ball
                 }   // if target_kart != kart && is a player kart and is current player
             }
+            break;
+        }   // flyable-kart collision
 
-        }
-        else
-        {
+        case CT_FLYABLE_FLYABLE:
             // Projectile hits projectile
             // --------------------------
             p->getUserPointer(0)->getPointerFlyable()->hit(NULL);
             p->getUserPointer(1)->getPointerFlyable()->hit(NULL);
-        }
+            break;
+
+        default:
+            assert(false);
+            break;
+        }   // switch getType()
     }  // for all p in m_all_collisions
 
     m_physics_loop_active = false;
@@ -566,7 +600,9 @@ void Physics::KartKartCollision(AbstractKart *kart_a,
  *  actual physics timestep. This list only stores a collision if it's not
  *  already in the list, so a collisions which is reported more than once is
  *  nevertheless only handled once.
- *  The list of collision
+ *  Bullet calls this function once for each batch of simulation islands,
+ *  but the contact manifolds of all islands are already computed before
+ *  the first call, so they are only collected once per time step.
  *  Parameters: see bullet documentation for details.
  */
 btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
@@ -586,7 +622,25 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
                                                         debugDrawer,
                                                         stackAlloc,
                                                         dispatcher);
+    m_num_solve_group_calls++;
+    if(!m_collisions_collected)
+    {
+        collectCollisions();
+        m_collisions_collected = true;
+    }
+    return returnValue;
+}   // solveGroup
+
+//-----------------------------------------------------------------------------
+/** Classifies all contact manifolds of the current time step: collisions
+ *  that need to be handled after the time step are stored with their type
+ *  in m_all_collisions, crashes of karts or physical objects with the track
+ *  are handled immediately.
+ */
+void Physics::collectCollisions()
+{
     int currentNumManifolds = m_dispatcher->getNumManifolds();
+    m_num_manifolds = currentNumManifolds;
     // We can't explode a rocket in a loop, since a rocket might collide with
     // more than one object, and/or more than once with each object (if there
     // is more than one collision point). So keep a list of rockets that will
@@ -603,6 +657,7 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
 
         unsigned int num_contacts = contact_manifold->getNumContacts();
         if(!num_contacts) continue;   // no real collision
+        m_num_contact_manifolds++;
 
         const UserPointer *upA = (UserPointer*)(objA->getUserPointer());
         const UserPointer *upB = (UserPointer*)(objB->getUserPointer());
@@ -614,7 +669,7 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
         if(upA->is(UserPointer::UP_TRACK))
         {
             if(upB->is(UserPointer::UP_FLYABLE))   // 1.1 projectile hits track
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_FLYABLE_TRACK,
                     upB, contact_manifold->getContactPoint(0).m_localPointB,
                     upA, contact_manifold->getContactPoint(0).m_localPointA);
             else if(upB->is(UserPointer::UP_KART))
@@ -668,18 +723,18 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
             }
             else if(upB->is(UserPointer::UP_FLYABLE))
                 // 2.1 projectile hits kart
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_FLYABLE_KART,
                     upB, contact_manifold->getContactPoint(0).m_localPointB,
                     upA, contact_manifold->getContactPoint(0).m_localPointA);
             else if(upB->is(UserPointer::UP_KART))
                 // 2.2 kart hits kart
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_KART_KART,
                     upA, contact_manifold->getContactPoint(0).m_localPointA,
                     upB, contact_manifold->getContactPoint(0).m_localPointB);
             else if(upB->is(UserPointer::UP_PHYSICAL_OBJECT))
             {
                 // 2.3 kart hits physical object
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_KART_PHYSICAL_OBJECT,
                     upB, contact_manifold->getContactPoint(0).m_localPointB,
                     upA, contact_manifold->getContactPoint(0).m_localPointA);
                 // If the object is a statical object (e.g. a door in
@@ -693,7 +748,7 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
                 }   // isStatiObject
             }
             else if(upB->is(UserPointer::UP_ANIMATION))
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_KART_ANIMATION,
                     upB, contact_manifold->getContactPoint(0).m_localPointB,
                     upA, contact_manifold->getContactPoint(0).m_localPointA);
         }
@@ -705,12 +760,20 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
             // 3.2) projectile hits projectile
             // 3.3) projectile hits physical object
             // 3.4) projectile hits kart
-            if(upB->is(UserPointer::UP_TRACK          ) ||
-               upB->is(UserPointer::UP_FLYABLE        ) ||
-               upB->is(UserPointer::UP_PHYSICAL_OBJECT) ||
-               upB->is(UserPointer::UP_KART           )   )
+            CollisionType type;
+            if(upB->is(UserPointer::UP_TRACK))
+                type = CT_FLYABLE_TRACK;
+            else if(upB->is(UserPointer::UP_FLYABLE))
+                type = CT_FLYABLE_FLYABLE;
+            else if(upB->is(UserPointer::UP_PHYSICAL_OBJECT))
+                type = CT_FLYABLE_PHYSICAL_OBJECT;
+            else if(upB->is(UserPointer::UP_KART))
+                type = CT_FLYABLE_KART;
+            else
+                type = CT_COUNT;
+            if(type!=CT_COUNT)
             {
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(type,
                     upA, contact_manifold->getContactPoint(0).m_localPointA,
                     upB, contact_manifold->getContactPoint(0).m_localPointB);
             }
@@ -720,11 +783,11 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
         else if(upA->is(UserPointer::UP_PHYSICAL_OBJECT))
         {
             if(upB->is(UserPointer::UP_FLYABLE))
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_FLYABLE_PHYSICAL_OBJECT,
                     upB, contact_manifold->getContactPoint(0).m_localPointB,
                     upA, contact_manifold->getContactPoint(0).m_localPointA);
             else if(upB->is(UserPointer::UP_KART))
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_KART_PHYSICAL_OBJECT,
                     upA, contact_manifold->getContactPoint(0).m_localPointA,
                     upB, contact_manifold->getContactPoint(0).m_localPointB);
             else if(upB->is(UserPointer::UP_TRACK))
@@ -750,16 +813,14 @@ btScalar Physics::solveGroup(btCollisionObject** bodies, int numBodies,
         else if (upA->is(UserPointer::UP_ANIMATION))
         {
             if(upB->is(UserPointer::UP_KART))
-                m_all_collisions.push_back(
+                m_all_collisions.push_back(CT_KART_ANIMATION,
                     upA, contact_manifold->getContactPoint(0).m_localPointA,
                     upB, contact_manifold->getContactPoint(0).m_localPointB);
         }
         else
             assert("Unknown user pointer");           // 4) Should never happen
     }   // for i<numManifolds
-
-    return returnValue;
-}   // solveGroup
+}   // collectCollisions
 
 // ----------------------------------------------------------------------------
 /** A debug draw function to show the track and all karts.
@@ -42,6 +42,22 @@ class Vec3;
   */
 class Physics : public btSequentialImpulseConstraintSolver
 {
+public:
+    /** The types of collisions that are handled after a physics step. The
+     *  type is determined when the collision is reported by bullet, so the
+     *  collisions don't need to be classified again when they are handled. */
+    enum CollisionType
+    {
+        CT_KART_KART,                 // kart, kart
+        CT_KART_PHYSICAL_OBJECT,      // physical object, kart
+        CT_KART_ANIMATION,            // animation, kart
+        CT_FLYABLE_TRACK,             // flyable, track
+        CT_FLYABLE_PHYSICAL_OBJECT,   // flyable, physical object
+        CT_FLYABLE_KART,              // flyable, kart
+        CT_FLYABLE_FLYABLE,           // flyable, flyable
+        CT_COUNT
+    };
+
 private:
     /** Bullet can report the same collision more than once (up to 4
      *  contact points per collision. Additionally, more than one internal
@@ -56,6 +72,10 @@ private:
     class CollisionPair
     {
     private:
+        /** The type of this collision, which also determines the type
+         *  of the user pointers. */
+        CollisionType      m_type;
+
         /** The user pointer of the objects involved in this collision. */
         const UserPointer *m_up[2];
 
@@ -65,11 +85,12 @@ private:
         /** The entries in Collision Pairs are sorted: if a projectile
          * is included, it's always 'a'. If only two karts are reported
          * the first kart pointer is the smaller one. */
-        CollisionPair(const UserPointer *a, const btVector3 &contact_point_a,
+        CollisionPair(CollisionType type,
+                      const UserPointer *a, const btVector3 &contact_point_a,
                       const UserPointer *b, const btVector3 &contact_point_b)
         {
-            if(a->is(UserPointer::UP_KART) &&
-               b->is(UserPointer::UP_KART) && a>b) {
+            m_type = type;
+            if(type==CT_KART_KART && a>b) {
                 m_up[0]=b; m_contact_point[0] = contact_point_b;
                 m_up[1]=a; m_contact_point[1] = contact_point_a;
             } else {
@@ -86,6 +107,9 @@ private:
             return (p.m_up[0]==m_up[0] && p.m_up[1]==m_up[1]);
         }   // operator==
         // --------------------------------------------------------------------
+        /** Returns the type of this collision. */
+        CollisionType getType() const { return m_type; }
+        // --------------------------------------------------------------------
         const UserPointer *getUserPointer(unsigned int n) const
         {
             assert(n<=1);
@@ -103,24 +127,44 @@ private:
 
     // ========================================================================
     // This class is the list of collision objects, where each collision
-    // pair is stored as most once.
+    // pair is stored as most once. The collisions are kept in the order in
+    // which they were reported, but to find duplicates only the collisions
+    // of the same type are compared.
     class CollisionList : public std::vector<CollisionPair>
     {
     private:
-        void push_back(CollisionPair p) {
-            // only add a pair if it's not already in there
-            for(iterator i=begin(); i!=end(); i++) {
-                if((*i)==p) return;
-            }
-            std::vector<CollisionPair>::push_back(p);
-        };  // push_back
+        /** For each collision type the indices of its collisions. */
+        std::vector<unsigned int> m_index_by_type[CT_COUNT];
     public:
         /** Adds information about a collision to this vector. */
-        void push_back(const UserPointer *a, const btVector3 &contact_point_a,
+        void push_back(CollisionType type,
+                       const UserPointer *a, const btVector3 &contact_point_a,
                        const UserPointer *b, const btVector3 &contact_point_b)
         {
-            push_back(CollisionPair(a, contact_point_a, b, contact_point_b));
-        }
+            CollisionPair p(type, a, contact_point_a, b, contact_point_b);
+            std::vector<unsigned int> &same_type = m_index_by_type[type];
+            // only add a pair if it's not already in there
+            for(unsigned int i=0; i<same_type.size(); i++)
+            {
+                if((*this)[same_type[i]]==p) return;
+            }
+            same_type.push_back((unsigned int)size());
+            std::vector<CollisionPair>::push_back(p);
+        }   // push_back
+        // --------------------------------------------------------------------
+        /** Removes all collisions. */
+        void clear()
+        {
+            std::vector<CollisionPair>::clear();
+            for(unsigned int i=0; i<CT_COUNT; i++)
+                m_index_by_type[i].clear();
+        }   // clear
+        // --------------------------------------------------------------------
+        /** Returns the number of collisions of the specified type. */
+        unsigned int getNumCollisions(CollisionType type) const
+        {
+            return (unsigned int)m_index_by_type[type].size();
+        }   // getNumCollisions
     };  // CollisionList
     // ========================================================================
 
@@ -147,6 +191,24 @@ private:
     btDefaultCollisionConfiguration *m_collision_conf;
     CollisionList                    m_all_collisions;
 
+    /** True once the contact manifolds of the current physics step were
+     *  collected. Bullet calls solveGroup once per batch of islands, but
+     *  the manifolds of all islands are available in the first call. */
+    bool                             m_collisions_collected;
+
+    /** Number of times solveGroup was called in the last physics step. */
+    unsigned int                     m_num_solve_group_calls;
+
+    /** Number of contact manifolds (i.e. pairs of objects with overlapping
+     *  bounding boxes) in the last physics step. */
+    unsigned int                     m_num_manifolds;
+
+    /** Number of contact manifolds with actual contact points in the last
+     *  physics step. */
+    unsigned int                     m_num_contact_manifolds;
+
+    void  collectCollisions();
+
              Physics();
     virtual ~Physics();
 
@@ -176,6 +238,16 @@ public:
     /** Returns true if the debug drawer is enabled. */
     bool  isDebug() const     {return m_debug_drawer->debugEnabled(); }
     IrrDebugDrawer* getDebugDrawer() { return m_debug_drawer; }
+    /** Returns the number of contact manifolds in the last physics step. */
+    unsigned int getNumManifolds() const { return m_num_manifolds; }
+    /** Returns the number of contact manifolds with contact points in the
+     *  last physics step. */
+    unsigned int getNumContactManifolds() const
+                                            { return m_num_contact_manifolds; }
+    /** Returns the number of collisions of the specified type that were
+     *  handled in the last physics step. */
+    unsigned int getNumCollisions(CollisionType type) const
+                               { return m_all_collisions.getNumCollisions(type); }
     virtual btScalar solveGroup(btCollisionObject** bodies, int numBodies,
                                 btPersistentManifold** manifold,int numManifolds,
                                 btTypedConstraint** constraints,int numConstraints,
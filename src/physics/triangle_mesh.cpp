@@ -19,6 +19,7 @@
 #include "physics/triangle_mesh.hpp"
 
 #include "config/stk_config.hpp"
+#include "io/asset_cache.hpp"
 #include "main_loop.hpp"
 #include "physics/physics.hpp"
 #include "utils/constants.hpp"
@@ -27,7 +28,9 @@
 
 #include "btBulletDynamicsCommon.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
 
 // -----------------------------------------------------------------------------
 /** Constructor: Initialises all data structures with zero.
@@ -45,6 +48,11 @@ TriangleMesh::TriangleMesh(bool can_be_transformed) : m_mesh()
     // (and m_mesh->m_weldingThreshold at m_normals
     m_collision_shape  = NULL;
     m_collision_object = NULL;
+    m_bvh_buffer       = NULL;
+    m_cell_size        = 1.0f;
+    m_grid_min_x       = m_grid_min_z  = 0.0f;
+    m_grid_size_x      = m_grid_size_z = 0;
+    m_lowest_height    = 0.0f;
     m_user_pointer.set(this);
 }   // TriangleMesh
 
@@ -137,22 +145,7 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
     }
     else
     {
-        bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
-
-        /*
-         // code to serialize triangle mesh
-        btOptimizedBvh* bvh = bhv_triangle_mesh->getOptimizedBvh();
-        unsigned int ssize = bvh->calculateSerializeBufferSize();
-        char* buffer = (char*)btAlignedAlloc(ssize, 16);
-        bool success = bvh->serialize(buffer, ssize, !IS_LITTLE_ENDIAN);
-        printf("serialization success = %i\n", success);
-
-        std::ofstream fileout("/tmp/btOptimizedBvh");
-        fileout.write(buffer, ssize);
-        fileout.close();
-
-        btAlignedFree(buffer);
-         */
+        bhv_triangle_mesh = createBvhShape();
     }
 
     m_collision_shape = bhv_triangle_mesh;
@@ -165,9 +158,192 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
         m_collision_object->setWorldTransform(bt);
     }
 
-
+    // The grid is in world coordinates, so it can't be used for meshes
+    // that might be moved.
+    if (!m_can_be_transformed)
+        createMinHeightGrid();
 }   // createCollisionShape
 
+// -----------------------------------------------------------------------------
+/** Creates the grid with the lowest height of all triangles per cell, see
+ *  m_min_height. A triangle is added to all cells overlapped by its
+ *  bounding box, which keeps the stored heights a lower bound.
+ */
+void TriangleMesh::createMinHeightGrid()
+{
+    const unsigned int triangles = (unsigned int)m_triangleIndex2Material.size();
+    btVector3 aabb_min(FLT_MAX, FLT_MAX, FLT_MAX);
+    btVector3 aabb_max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (unsigned int i = 0; i < triangles; i++)
+    {
+        btVector3 p[3];
+        getTriangle(i, &p[0], &p[1], &p[2]);
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            aabb_min.setMin(p[j]);
+            aabb_max.setMax(p[j]);
+        }
+    }
+    m_lowest_height = aabb_min.getY();
+
+    // Use cells of at least 4m, but limit the grid to 256x256 cells
+    const int MAX_CELLS = 256;
+    m_grid_min_x = aabb_min.getX();
+    m_grid_min_z = aabb_min.getZ();
+    m_cell_size  = std::max(4.0f,
+        std::max(aabb_max.getX() - aabb_min.getX(),
+                 aabb_max.getZ() - aabb_min.getZ()) / MAX_CELLS);
+    m_grid_size_x = std::min(MAX_CELLS,
+        int((aabb_max.getX() - m_grid_min_x) / m_cell_size) + 1);
+    m_grid_size_z = std::min(MAX_CELLS,
+        int((aabb_max.getZ() - m_grid_min_z) / m_cell_size) + 1);
+    m_min_height.clear();
+    m_min_height.resize(m_grid_size_x * m_grid_size_z, FLT_MAX);
+
+    for (unsigned int i = 0; i < triangles; i++)
+    {
+        btVector3 p[3];
+        getTriangle(i, &p[0], &p[1], &p[2]);
+        btVector3 t_min = p[0], t_max = p[0];
+        t_min.setMin(p[1]); t_min.setMin(p[2]);
+        t_max.setMax(p[1]); t_max.setMax(p[2]);
+        // If the number of cells is limited, triangles on the max edge of
+        // the bounding box would be one past the last cell
+        const int x0 = std::min(m_grid_size_x - 1,
+                           int((t_min.getX() - m_grid_min_x) / m_cell_size));
+        const int z0 = std::min(m_grid_size_z - 1,
+                           int((t_min.getZ() - m_grid_min_z) / m_cell_size));
+        const int x1 = std::min(m_grid_size_x - 1,
+                           int((t_max.getX() - m_grid_min_x) / m_cell_size));
+        const int z1 = std::min(m_grid_size_z - 1,
+                           int((t_max.getZ() - m_grid_min_z) / m_cell_size));
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                float &h = m_min_height[z * m_grid_size_x + x];
+                h = std::min(h, t_min.getY());
+            }
+        }
+    }
+}   // createMinHeightGrid
+
+// -----------------------------------------------------------------------------
+/** Shortens a downward ray so that it ends just below the lowest triangle it
+ *  could possibly hit, which makes the raycast cheaper but gives the same
+ *  result. The ray can only hit triangles above the lowest point of the
+ *  mesh, so only the cells overlapped by the x/z footprint of the ray down
+ *  to that height need to be considered.
+ *  \param from Start of the ray.
+ *  \param to End of the ray, will be modified.
+ */
+void TriangleMesh::clampRay(const btVector3 &from, btVector3 *to) const
+{
+    // Keep a small distance to the bound, so that a hit exactly on the
+    // lowest triangle is not lost due to rounding.
+    const float MARGIN = 0.5f;
+    const float dy = from.getY() - to->getY();
+    float bound = m_lowest_height - MARGIN;
+    if (dy <= 0.0f || to->getY() >= bound || from.getY() <= bound)
+        return;
+
+    const btVector3 end = from + (*to - from) * ((from.getY() - bound) / dy);
+    const int x0 = std::max(0, int(floorf((std::min(from.getX(), end.getX())
+                                  - m_grid_min_x) / m_cell_size)));
+    const int z0 = std::max(0, int(floorf((std::min(from.getZ(), end.getZ())
+                                  - m_grid_min_z) / m_cell_size)));
+    const int x1 = std::min(m_grid_size_x - 1,
+                            int(floorf((std::max(from.getX(), end.getX())
+                                 - m_grid_min_x) / m_cell_size)));
+    const int z1 = std::min(m_grid_size_z - 1,
+                            int(floorf((std::max(from.getZ(), end.getZ())
+                                 - m_grid_min_z) / m_cell_size)));
+    // For a long footprint (i.e. a strongly tilted ray) checking the cells
+    // costs more than it saves, just use the lowest point of the mesh then.
+    if (x0 <= x1 && z0 <= z1 && (x1 - x0 + 1) * (z1 - z0 + 1) <= 64)
+    {
+        float h = FLT_MAX;
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+                h = std::min(h, m_min_height[z * m_grid_size_x + x]);
+        }
+        // If no triangle is in the footprint at all, there can't be a hit
+        // anyway, so just keep the bound. Also keep the ray from getting
+        // a zero length.
+        if (h != FLT_MAX && h - MARGIN > bound)
+            bound = std::max(bound, std::min(h - MARGIN,
+                                             from.getY() - MARGIN));
+    }
+    *to = from + (*to - from) * ((from.getY() - bound) / dy);
+}   // clampRay
+
+// -----------------------------------------------------------------------------
+/** Returns a hash of the number and positions of all triangles of this mesh,
+ *  which is used as key for data derived from it in the AssetCache.
+ */
+uint64_t TriangleMesh::getContentHash() const
+{
+    const unsigned int triangles = getNumberOfTriangles();
+    uint64_t content_hash = AssetCache::hash(&triangles, sizeof(triangles));
+    for (unsigned int i = 0; i < triangles; i++)
+    {
+        btVector3 p[3];
+        getTriangle(i, &p[0], &p[1], &p[2]);
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            const float xyz[3] = { p[j].getX(), p[j].getY(), p[j].getZ() };
+            content_hash = AssetCache::hash(xyz, sizeof(xyz), content_hash);
+        }
+    }
+    return content_hash;
+}   // getContentHash
+
+// -----------------------------------------------------------------------------
+/** Creates the bvh triangle mesh shape of this mesh. Building the bvh of a
+ *  large mesh (mostly the main track) is expensive, so it is loaded from the
+ *  AssetCache if this mesh was seen before, or saved to it otherwise.
+ */
+btBvhTriangleMeshShape* TriangleMesh::createBvhShape()
+{
+    const unsigned int triangles = (unsigned int)m_triangleIndex2Material.size();
+    if (triangles < 8192)
+        return new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
+
+    const uint64_t content_hash = getContentHash();
+    std::string data;
+    if (AssetCache::load("bvh", content_hash, &data))
+    {
+        m_bvh_buffer = btAlignedAlloc((int)data.size(), 16);
+        memcpy(m_bvh_buffer, data.data(), data.size());
+        btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(m_bvh_buffer,
+            (unsigned int)data.size(), !IS_LITTLE_ENDIAN);
+        if (bvh)
+        {
+            btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(&m_mesh,
+                false /* useQuantizedAabbCompression */, false /* buildBvh */);
+            shape->setOptimizedBvh(bvh);
+            return shape;
+        }
+        Log::warn("TriangleMesh", "Failed to load cached BVH");
+        btAlignedFree(m_bvh_buffer);
+        m_bvh_buffer = NULL;
+    }
+
+    btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(&m_mesh,
+        false /* useQuantizedAabbCompression */);
+    btOptimizedBvh* bvh = shape->getOptimizedBvh();
+    const unsigned int size = bvh->calculateSerializeBufferSize();
+    void* buffer = btAlignedAlloc(size, 16);
+    if (bvh->serializeInPlace(buffer, size, !IS_LITTLE_ENDIAN))
+    {
+        AssetCache::save("bvh", content_hash,
+            std::string((const char*)buffer, size));
+    }
+    btAlignedFree(buffer);
+    return shape;
+}   // createBvhShape
+
 // -----------------------------------------------------------------------------
 /** Creates the physics body for this triangle mesh. If the body already
  *  exists (because it was created by a previous call to createBody)
@@ -233,6 +409,14 @@ void TriangleMesh::removeAll()
     }
     delete m_collision_shape;
     m_collision_shape = NULL;
+    m_min_height.clear();
+    // The bvh deserialized from AssetCache lives in this buffer, so it can
+    // only be freed after the shape
+    if (m_bvh_buffer)
+    {
+        btAlignedFree(m_bvh_buffer);
+        m_bvh_buffer = NULL;
+    }
 }   // removeAll
 
 // -----------------------------------------------------------------------------
@@ -328,13 +512,19 @@ bool TriangleMesh::castRay(const btVector3 &from, const btVector3 &to,
         return false;
     }
 
+    // Shorten long downward rays for static meshes, which reduces the
+    // number of bvh nodes and triangles tested
+    btVector3 ray_to = to;
+    if (!m_min_height.empty())
+        clampRay(from, &ray_to);
+
     btTransform trans_from;
     trans_from.setIdentity();
     trans_from.setOrigin(from);
 
     btTransform trans_to;
     trans_to.setIdentity();
-    trans_to.setOrigin(to);
+    trans_to.setOrigin(ray_to);
 
     btTransform world_trans;
     // If there is a body, take the current transform from the body.
@@ -343,8 +533,6 @@ bool TriangleMesh::castRay(const btVector3 &from, const btVector3 &to,
     else
         world_trans.setIdentity();
 
-    btCollisionWorld::ClosestRayResultCallback result(from, to);
-
     /** A special ray result class that stores the index of the triangle
      *  that was hit. */
     class MaterialRayResult : public btCollisionWorld::ClosestRayResultCallback
@@ -370,7 +558,7 @@ bool TriangleMesh::castRay(const btVector3 &from, const btVector3 &to,
         // --------------------------------------------------------------------
     };   // myCollision
 
-    MaterialRayResult ray_callback(from, to, this);
+    MaterialRayResult ray_callback(from, ray_to, this);
 
     // If this is a rigid body, m_collision_object is NULL, and the
     // rigid body is the actual collision object.
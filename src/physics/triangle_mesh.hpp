@@ -19,6 +19,7 @@
 #ifndef HEADER_TRIANGLE_MESH_HPP
 #define HEADER_TRIANGLE_MESH_HPP
 
+#include <cstdint>
 #include <vector>
 #include "btBulletDynamicsCommon.h"
 
@@ -46,6 +47,9 @@ private:
     btDefaultMotionState        *m_motion_state;
     btCollisionShape            *m_collision_shape;
 
+    /** Memory of a bvh loaded from AssetCache, used by m_collision_shape. */
+    void                        *m_bvh_buffer;
+
     /** The three normals for each triangle. */
     AlignedArray<btVector3>      m_normals;
 
@@ -57,6 +61,28 @@ private:
      *  to the current transform of the body. */
     bool m_can_be_transformed;
 
+    /** A coarse grid over the x/z plane of a static mesh, which stores the
+     *  lowest height of all triangles overlapping each cell (or FLT_MAX if
+     *  no triangle overlaps it). It is used to shorten the long downward
+     *  rays used to find the terrain, without changing their result. */
+    std::vector<float>           m_min_height;
+
+    /** Minimum x/z corner of the min height grid. */
+    float                        m_grid_min_x, m_grid_min_z;
+
+    /** Size of a cell of the min height grid. */
+    float                        m_cell_size;
+
+    /** Number of cells of the min height grid in x and z direction. */
+    int                          m_grid_size_x, m_grid_size_z;
+
+    /** Lowest height of all triangles of this mesh. */
+    float                        m_lowest_height;
+
+    btBvhTriangleMeshShape* createBvhShape();
+    void createMinHeightGrid();
+    void clampRay(const btVector3 &from, btVector3 *to) const;
+
 public:
     class RigidBodyTriangleMesh : public btRigidBody
     {
@@ -85,6 +111,7 @@ public:
     void removeCollisionObject();
     btVector3 getInterpolatedNormal(unsigned int index,
                                     const btVector3 &position) const;
+    uint64_t  getContentHash() const;
     // ------------------------------------------------------------------------
     /** In case of physical objects of shape 'exact', the physical body is
      *  created outside of the mesh. Since raycasts need the body's world
@@ -101,6 +128,10 @@ public:
     }
     const btRigidBody *getBody() const { return m_body; }
     // ------------------------------------------------------------------------
+    /** Returns the number of triangles of this mesh. */
+    unsigned int getNumberOfTriangles() const
+               { return (unsigned int)m_triangleIndex2Material.size(); }
+    // ------------------------------------------------------------------------
     const Material* getMaterial(int n) const
                                           {return m_triangleIndex2Material[n];}
     // ------------------------------------------------------------------------
@@ -22,6 +22,7 @@ extern "C"
 }
 #include <assert.h>
 #include <angelscript.h>
+#include "io/asset_cache.hpp"
 #include "io/file_manager.hpp"
 #include "karts/kart.hpp"
 #include "modes/world.hpp"
@@ -52,6 +53,12 @@ namespace Scripting
 {
     const char* MODULE_ID_MAIN_SCRIPT_FILE = "main";
 
+    /** The next script function generation. It is shared by all script
+     *  engines, so that a ScriptFunction which outlives its engine (e.g. a
+     *  static one, while a new engine is created for each race) never
+     *  matches the generation of a later engine. */
+    static unsigned int g_next_generation = 1;
+
     void AngelScript_ErrorCallback (const asSMessageInfo *msg, void *param)
     {
         const char *type = "ERR ";
@@ -64,9 +71,38 @@ namespace Scripting
     }
 
 
+    /** Reads and writes the compiled byte code of the scripts from and to
+     *  a string, which is stored in the asset cache.
+     */
+    class ByteCodeStream : public asIBinaryStream
+    {
+    private:
+        std::string* m_data;
+        size_t m_read_pos;
+
+    public:
+        ByteCodeStream(std::string* data) : m_data(data), m_read_pos(0) {}
+        // --------------------------------------------------------------------
+        virtual int Read(void *ptr, asUINT size)
+        {
+            if (size > m_data->size() - m_read_pos)
+                return -1;
+            memcpy(ptr, m_data->data() + m_read_pos, size);
+            m_read_pos += size;
+            return 0;
+        }   // Read
+        // --------------------------------------------------------------------
+        virtual int Write(const void *ptr, asUINT size)
+        {
+            m_data->append((const char*)ptr, size);
+            return 0;
+        }   // Write
+    };   // ByteCodeStream
+
     //Constructor, creates a new Scripting Engine using AngelScript
     ScriptEngine::ScriptEngine()
     {
+        m_generation = g_next_generation++;
         // Create the script engine
         m_engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
         if (m_engine == NULL)
@@ -77,6 +113,9 @@ namespace Scripting
         // The script compiler will write any compiler messages to the callback.
         m_engine->SetMessageCallback(asFUNCTION(AngelScript_ErrorCallback), 0, asCALL_CDECL);
 
+        // Reuse contexts instead of creating one for each call
+        m_engine->SetContextCallbacks(requestContext, returnContext, this);
+
         // Configure the script engine with all the functions, 
         // and variables that the script should be able to use.
         configureEngine(m_engine);
@@ -86,7 +125,12 @@ namespace Scripting
     {
         // Release the engine
         m_pending_timeouts.clearAndDeleteAll();
+        clearFunctionsCache();
         m_engine->DiscardModule(MODULE_ID_MAIN_SCRIPT_FILE);
+        for (asIScriptContext* ctx : m_context_pool)
+            ctx->Release();
+        m_context_pool.clear();
+        m_engine->SetContextCallbacks(NULL, NULL);
         m_engine->Release();
     }
 
@@ -188,42 +232,12 @@ namespace Scripting
             return;
         }
 
-        asIScriptContext *ctx = m_engine->CreateContext();
-        if (ctx == NULL)
-        {
-            Log::error("Scripting", "evalScript: Failed to create the context.");
-            //m_engine->Release();
-            return;
-        }
-
-        r = ctx->Prepare(func);
-        if (r < 0)
+        asIScriptContext *ctx = prepareContext(func);
+        if (ctx != NULL)
         {
-            Log::error("Scripting", "evalScript: Failed to prepare the context.");
-            ctx->Release();
-            return;
+            executeContext(ctx);
+            m_engine->ReturnContext(ctx);
         }
-
-        // Execute the function
-        r = ctx->Execute();
-        if (r != asEXECUTION_FINISHED)
-        {
-            // The execution didn't finish as we had planned. Determine why.
-            if (r == asEXECUTION_ABORTED)
-            {
-                Log::error("Scripting", "The script was aborted before it could finish. Probably it timed out.");
-            }
-            else if (r == asEXECUTION_EXCEPTION)
-            {
-                Log::error("Scripting", "The script ended with an exception.");
-            }
-            else
-            {
-                Log::error("Scripting", "The script ended for some unforeseen reason (%i)", r);
-            }
-        }
-
-        ctx->Release();
         func->Release();
     }
 
@@ -231,44 +245,11 @@ namespace Scripting
 
     void ScriptEngine::runDelegate(asIScriptFunction* delegate)
     {
-        asIScriptContext *ctx = m_engine->CreateContext();
+        asIScriptContext *ctx = prepareContext(delegate);
         if (ctx == NULL)
-        {
-            Log::error("Scripting", "runMethod: Failed to create the context.");
-            //m_engine->Release();
             return;
-        }
-
-        int r = ctx->Prepare(delegate);
-        if (r < 0)
-        {
-            Log::error("Scripting", "runMethod: Failed to prepare the context.");
-            ctx->Release();
-            return;
-        }
-
-        // Execute the function
-        r = ctx->Execute();
-        if (r != asEXECUTION_FINISHED)
-        {
-            // The execution didn't finish as we had planned. Determine why.
-            if (r == asEXECUTION_ABORTED)
-            {
-                Log::error("Scripting", "The script was aborted before it could finish. Probably it timed out.");
-            }
-            else if (r == asEXECUTION_EXCEPTION)
-            {
-                Log::error("Scripting", "The script ended with an exception : (line %i) %s",
-                    ctx->GetExceptionLineNumber(), 
-                    ctx->GetExceptionString());
-            }
-            else
-            {
-                Log::error("Scripting", "The script ended for some unforeseen reason (%i)", r);
-            }
-        }
-
-        ctx->Release();
+        executeContext(ctx);
+        m_engine->ReturnContext(ctx);
     }
 
     //-----------------------------------------------------------------------------
@@ -325,7 +306,8 @@ namespace Scripting
     /** runs the specified script
     *  \param string scriptName = name of script to run
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name)
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+                                   const std::string& function_name)
     {
         std::function<void(asIScriptContext*)> callback;
         std::function<void(asIScriptContext*)> get_return_value;
@@ -334,8 +316,9 @@ namespace Scripting
 
     //-----------------------------------------------------------------------------
 
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback)
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+        const std::string& function_name,
+        const std::function<void(asIScriptContext*)>& callback)
     {
         std::function<void(asIScriptContext*)> get_return_value;
         runFunction(warn_if_not_found, function_name, callback, get_return_value);
@@ -346,16 +329,46 @@ namespace Scripting
     /** runs the specified script
     *  \param string scriptName = name of script to run
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback,
-        std::function<void(asIScriptContext*)> get_return_value)
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+        const std::string& function_name,
+        const std::function<void(asIScriptContext*)>& callback,
+        const std::function<void(asIScriptContext*)>& get_return_value)
     {
-        int r; //int for error checking
+        asIScriptFunction *func = getFunction(warn_if_not_found, function_name);
+        if (func == NULL)
+            return;
+
+        asIScriptContext *ctx = prepareContext(func);
+        if (ctx == NULL)
+            return;
+
+        // Here, we can pass parameters to the script functions. 
+        //ctx->setArgType(index, value);
+        //for example : ctx->SetArgFloat(0, 3.14159265359f);
+
+        if (callback)
+            callback(ctx);
+
+        // Retrieve the return value from the context here (for scripts that
+        // return values), e.g. float returnValue = ctx->GetReturnFloat();
+        if (executeContext(ctx) && get_return_value)
+            get_return_value(ctx);
+
+        // The context is put back into the pool
+        m_engine->ReturnContext(ctx);
+    }
 
+    //-----------------------------------------------------------------------------
+    /** Returns the function with the given declaration, or NULL if the
+     *  function doesn't exist. The result is cached, so the relatively slow
+     *  GetFunctionByDecl() is only called once per function.
+     */
+    asIScriptFunction* ScriptEngine::getFunction(bool warn_if_not_found,
+                                                 const std::string& function_name)
+    {
         asIScriptFunction *func;
 
         // TODO: allow splitting in multiple files
-        std::string script_filename = "scripting.as";
         auto cached_function = m_functions_cache.find(function_name);
         if (cached_function == m_functions_cache.end())
         {
@@ -373,7 +386,7 @@ namespace Scripting
                     Log::debug("Scripting", "Scripting function was not found : %s (module not found)", function_name.c_str());
 #endif
                 m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
+                return NULL;
             }
 
             func = module->GetFunctionByDecl(function_name.c_str());
@@ -387,7 +400,7 @@ namespace Scripting
                     Log::debug("Scripting", "Scripting function was not found : %s", function_name.c_str());
 #endif
                 m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
+                return NULL;
             }
 
             m_functions_cache[function_name] = func;
@@ -397,88 +410,115 @@ namespace Scripting
         {
             // Script present in cache
             func = cached_function->second;
+            if (func == NULL && warn_if_not_found)
+                Log::warn("Scripting", "Scripting function was not found : %s", function_name.c_str());
         }
+        return func;
+    }   // getFunction
 
-        if (func == NULL)
+    //-----------------------------------------------------------------------------
+    /** Returns the function of a script function handle, resolving it if the
+     *  scripts were compiled again since it was last resolved.
+     */
+    asIScriptFunction* ScriptEngine::getFunction(bool warn_if_not_found,
+                                                 ScriptFunction& function)
+    {
+        if (function.m_generation != m_generation)
         {
-            if (warn_if_not_found)
-                Log::warn("Scripting", "Scripting function was not found : %s", function_name.c_str());
-            return; // function unavailable
+            function.m_function = getFunction(warn_if_not_found,
+                                              function.m_declaration);
+            function.m_generation = m_generation;
+        }
+        else if (function.m_function == NULL && warn_if_not_found)
+        {
+            Log::warn("Scripting", "Scripting function was not found : %s",
+                      function.m_declaration.c_str());
         }
+        return function.m_function;
+    }   // getFunction
 
-        // Create a context that will execute the script.
-        asIScriptContext *ctx = m_engine->CreateContext();
+    //-----------------------------------------------------------------------------
+    /** Takes a context from the pool and prepares it for the given function.
+     *  \return The context, which must be given back with ReturnContext,
+     *          or NULL in case of an error.
+     */
+    asIScriptContext* ScriptEngine::prepareContext(asIScriptFunction* func)
+    {
+        asIScriptContext *ctx = m_engine->RequestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "Failed to create the context.");
-            //m_engine->Release();
-            return;
+            return NULL;
         }
 
-        // Prepare the script context with the function we wish to execute. Prepare()
-        // must be called on the context before each new script function that will be
-        // executed. Note, that if because we intend to execute the same function 
-        // several times, we will store the function returned by 
-        // GetFunctionByDecl(), so that this relatively slow call can be skipped.
-        r = ctx->Prepare(func);
+        // Prepare the script context with the function we wish to execute.
+        // Prepare() must be called on the context before each new script
+        // function that will be executed.
+        int r = ctx->Prepare(func);
         if (r < 0)
         {
             Log::error("Scripting", "Failed to prepare the context.");
-            ctx->Release();
-            //m_engine->Release();
-            return;
+            m_engine->ReturnContext(ctx);
+            return NULL;
         }
+        return ctx;
+    }   // prepareContext
 
-        // Here, we can pass parameters to the script functions. 
-        //ctx->setArgType(index, value);
-        //for example : ctx->SetArgFloat(0, 3.14159265359f);
-
-        if (callback)
-            callback(ctx);
+    //-----------------------------------------------------------------------------
+    /** Executes a prepared context and logs errors.
+     *  \return True if the function finished successfully.
+     */
+    bool ScriptEngine::executeContext(asIScriptContext* ctx)
+    {
+        int r = ctx->Execute();
+        if (r == asEXECUTION_FINISHED)
+            return true;
 
-        // Execute the function
-        r = ctx->Execute();
-        if (r != asEXECUTION_FINISHED)
+        // The execution didn't finish as we had planned. Determine why.
+        if (r == asEXECUTION_ABORTED)
         {
-            // The execution didn't finish as we had planned. Determine why.
-            if (r == asEXECUTION_ABORTED)
-            {
-                Log::error("Scripting", "The script was aborted before it could finish. Probably it timed out.");
-            }
-            else if (r == asEXECUTION_EXCEPTION)
-            {
-                Log::error("Scripting", "The script ended with an exception.");
-
-                // Write some information about the script exception
-                //asIScriptFunction *func = ctx->GetExceptionFunction();
-                //std::cout << "func: " << func->GetDeclaration() << std::endl;
-                //std::cout << "modl: " << func->GetModuleName() << std::endl;
-                //std::cout << "sect: " << func->GetScriptSectionName() << std::endl;
-                //std::cout << "line: " << ctx->GetExceptionLineNumber() << std::endl;
-                //std::cout << "desc: " << ctx->GetExceptionString() << std::endl;
-            }
-            else
-            {
-                Log::error("Scripting", "The script ended for some unforeseen reason (%i)", r);
-            }
+            Log::error("Scripting", "The script was aborted before it could finish. Probably it timed out.");
+        }
+        else if (r == asEXECUTION_EXCEPTION)
+        {
+            Log::error("Scripting", "The script ended with an exception : (line %i) %s",
+                ctx->GetExceptionLineNumber(),
+                ctx->GetExceptionString());
         }
         else
         {
-            // Retrieve the return value from the context here (for scripts that return values)
-            // <type> returnValue = ctx->getReturnType(); for example
-            //float returnValue = ctx->GetReturnFloat();
-
-            if (get_return_value)
-                get_return_value(ctx);
+            Log::error("Scripting", "The script ended for some unforeseen reason (%i)", r);
         }
+        return false;
+    }   // executeContext
 
-        // We must release the contexts when no longer using them
-        ctx->Release();
-    }
+    //-----------------------------------------------------------------------------
+    /** Called by the engine when a context is needed. */
+    asIScriptContext* ScriptEngine::requestContext(asIScriptEngine* engine,
+                                                   void* param)
+    {
+        ScriptEngine* self = (ScriptEngine*)param;
+        if (self->m_context_pool.empty())
+            return engine->CreateContext();
+        asIScriptContext* ctx = self->m_context_pool.back();
+        self->m_context_pool.pop_back();
+        return ctx;
+    }   // requestContext
 
     //-----------------------------------------------------------------------------
+    /** Called by the engine when a context is not needed anymore. */
+    void ScriptEngine::returnContext(asIScriptEngine* engine,
+                                     asIScriptContext* ctx, void* param)
+    {
+        ScriptEngine* self = (ScriptEngine*)param;
+        // Release the references to objects and arguments of the last call
+        ctx->Unprepare();
+        self->m_context_pool.push_back(ctx);
+    }   // returnContext
 
-    void ScriptEngine::cleanupCache()
+    //-----------------------------------------------------------------------------
+
+    void ScriptEngine::clearFunctionsCache()
     {
         for (auto curr : m_functions_cache)
         {
@@ -486,6 +526,15 @@ namespace Scripting
                 curr.second->Release();
         }
         m_functions_cache.clear();
+        // Invalidate all functions resolved in ScriptFunction handles
+        m_generation = g_next_generation++;
+    }   // clearFunctionsCache
+
+    //-----------------------------------------------------------------------------
+
+    void ScriptEngine::cleanupCache()
+    {
+        clearFunctionsCache();
         m_engine->DiscardModule(MODULE_ID_MAIN_SCRIPT_FILE);
     }
 
@@ -522,7 +571,8 @@ namespace Scripting
 
     bool ScriptEngine::loadScript(std::string script_path, bool clear_previous)
     {
-        int r;
+        if (clear_previous)
+            m_script_sections.clear();
 
         std::string script = getScript(script_path);
         if (script.size() == 0)
@@ -531,29 +581,85 @@ namespace Scripting
             return false;
         }
 
-        // Add the script sections that will be compiled into executable code.
-        // If we want to combine more than one file into the same script, then 
-        // we can call AddScriptSection() several times for the same module and
-        // the script engine will treat them all as if they were one. The script
-        // section name, will allow us to localize any errors in the script code.
-        asIScriptModule *mod = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE,
-            clear_previous ? asGM_ALWAYS_CREATE : asGM_CREATE_IF_NOT_EXISTS);
-        r = mod->AddScriptSection("script", &script[0], script.size());
-        if (r < 0)
-        {
-            Log::error("Scripting", "AddScriptSection() failed");
-            return false;
-        }
-    
+        // Keep the script sections that will be compiled into executable
+        // code. If we want to combine more than one file into the same
+        // script, then we can call this several times and all sections are
+        // added to the same module, as if they were one. The script section
+        // name, will allow us to localize any errors in the script code.
+        m_script_sections.emplace_back("script", std::move(script));
         return true;
     }
 
     //-----------------------------------------------------------------------------
+    /** Returns a hash of all loaded script sections, which also includes the
+     *  versions of STK and AngelScript, since the byte code depends on the
+     *  registered application interface.
+     */
+    uint64_t ScriptEngine::getScriptsHash() const
+    {
+        std::string versions = StringUtils::insertValues("%s %d %s",
+            STK_VERSION, ANGELSCRIPT_VERSION, asGetLibraryOptions());
+#ifdef SERVER_ONLY
+        versions += " server-only";
+#endif
+        uint64_t h = AssetCache::hash(versions.data(), versions.size());
+        for (auto& section : m_script_sections)
+        {
+            uint64_t size = section.second.size();
+            h = AssetCache::hash(&size, sizeof(size), h);
+            h = AssetCache::hash(section.first.data(), section.first.size(), h);
+            h = AssetCache::hash(section.second.data(), section.second.size(), h);
+        }
+        return h;
+    }   // getScriptsHash
 
+    //-----------------------------------------------------------------------------
+    /** Compiles all loaded script sections into the main module. The byte
+     *  code is cached using the hash of the preprocessed scripts, so a track
+     *  which is loaded again doesn't need to compile its scripts again.
+     */
     bool ScriptEngine::compileLoadedScripts()
     {
         int r;
-        asIScriptModule *mod = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE, asGM_CREATE_IF_NOT_EXISTS);
+        // Functions of the previous module must not be used anymore
+        clearFunctionsCache();
+        asIScriptModule *mod = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE, asGM_ALWAYS_CREATE);
+
+        uint64_t hash = 0;
+        std::string byte_code;
+        if (!m_script_sections.empty())
+        {
+            hash = getScriptsHash();
+            if (AssetCache::load("script", hash, &byte_code))
+            {
+                ByteCodeStream stream(&byte_code);
+                r = mod->LoadByteCode(&stream);
+                if (r >= 0)
+                {
+                    m_script_sections.clear();
+                    return true;
+                }
+                Log::warn("Scripting", "Failed to load cached byte code (%d), "
+                          "compiling the scripts.", r);
+                mod = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE, asGM_ALWAYS_CREATE);
+            }
+        }
+
+        for (auto& section : m_script_sections)
+        {
+            r = mod->AddScriptSection(section.first.c_str(),
+                section.second.c_str(), section.second.size());
+            if (r < 0)
+            {
+                Log::error("Scripting", "AddScriptSection() failed");
+                m_script_sections.clear();
+                return false;
+            }
+        }
+        bool save_byte_code = !m_script_sections.empty();
+        // The engine doesn't keep a copy of the script sections after Build() has
+        // returned, and neither do we.
+        m_script_sections.clear();
 
         // Compile the script. If there are any compiler messages they will
         // be written to the message stream that we set right after creating the 
@@ -566,9 +672,13 @@ namespace Scripting
             return false;
         }
 
-        // The engine doesn't keep a copy of the script sections after Build() has
-        // returned. So if the script needs to be recompiled, then all the script
-        // sections must be added again.
+        if (save_byte_code)
+        {
+            byte_code.clear();
+            ByteCodeStream stream(&byte_code);
+            if (mod->SaveByteCode(&stream) >= 0)
+                AssetCache::save("script", hash, byte_code);
+        }
 
         // If we want to have several scripts executing at different times but 
         // that have no direct relation with each other, then we can compile them
@@ -19,15 +19,19 @@
 #ifndef HEADER_SCRIPT_ENGINE_HPP
 #define HEADER_SCRIPT_ENGINE_HPP
 
+#include "scriptengine/script_function.hpp"
 #include "scriptengine/script_utils.hpp"
 #include "utils/no_copy.hpp"
 #include "utils/ptr_vector.hpp"
 #include "utils/singleton.hpp"
 
 #include <angelscript.h>
+#include <cstdint>
 #include <functional>
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class TrackObjectPresentation;
 
@@ -67,12 +71,12 @@ namespace Scripting
     public:
 
 
-        void runFunction(bool warn_if_not_found, std::string function_name);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback,
-            std::function<void(asIScriptContext*)> get_return_value);
+        void runFunction(bool warn_if_not_found, const std::string& function_name);
+        void runFunction(bool warn_if_not_found, const std::string& function_name,
+            const std::function<void(asIScriptContext*)>& callback);
+        void runFunction(bool warn_if_not_found, const std::string& function_name,
+            const std::function<void(asIScriptContext*)>& callback,
+            const std::function<void(asIScriptContext*)>& get_return_value);
         void runDelegate(asIScriptFunction* delegate_fn);
         void evalScript(std::string script_fragment);
         void cleanupCache();
@@ -86,12 +90,75 @@ namespace Scripting
 
         asIScriptEngine* getEngine() { return m_engine; }
 
+        // --------------------------------------------------------------------
+        /** Runs a script function. The arguments are set by set_args, and
+         *  get_return_value is called if the function finished successfully.
+         *  Both are called directly (not through a std::function), so a
+         *  lambda capturing the arguments doesn't need any allocation. */
+        template<typename SetArgs, typename GetReturnValue>
+        void runFunction(bool warn_if_not_found, ScriptFunction& function,
+                         const SetArgs& set_args,
+                         const GetReturnValue& get_return_value)
+        {
+            asIScriptFunction* func = getFunction(warn_if_not_found, function);
+            if (func == NULL)
+                return;
+            asIScriptContext* ctx = prepareContext(func);
+            if (ctx == NULL)
+                return;
+            set_args(ctx);
+            if (executeContext(ctx))
+                get_return_value(ctx);
+            m_engine->ReturnContext(ctx);
+        }   // runFunction
+        // --------------------------------------------------------------------
+        template<typename SetArgs>
+        void runFunction(bool warn_if_not_found, ScriptFunction& function,
+                         const SetArgs& set_args)
+        {
+            runFunction(warn_if_not_found, function, set_args,
+                        [](asIScriptContext*) {});
+        }   // runFunction
+        // --------------------------------------------------------------------
+        void runFunction(bool warn_if_not_found, ScriptFunction& function)
+        {
+            runFunction(warn_if_not_found, function,
+                        [](asIScriptContext*) {});
+        }   // runFunction
+
     private:
         asIScriptEngine *m_engine;
-        std::map<std::string, asIScriptFunction*> m_functions_cache;
+        std::unordered_map<std::string, asIScriptFunction*> m_functions_cache;
         PtrVector<PendingTimeout> m_pending_timeouts;
 
+        /** Contexts which are not in use. Creating a context is expensive,
+         *  so they are reused through the engine's Request/ReturnContext. A
+         *  nested script call simply takes (or creates) another context. */
+        std::vector<asIScriptContext*> m_context_pool;
+
+        /** The preprocessed script sections (name and code) that will be
+         *  compiled by compileLoadedScripts. */
+        std::vector<std::pair<std::string, std::string> > m_script_sections;
+
+        /** Changed each time the functions cache is cleared, which
+         *  invalidates the functions resolved in all ScriptFunctions.
+         *  Generations are unique across all script engines. */
+        unsigned int m_generation;
+
         void configureEngine(asIScriptEngine *engine);
+        void clearFunctionsCache();
+        asIScriptFunction* getFunction(bool warn_if_not_found,
+                                       const std::string& function_name);
+        asIScriptFunction* getFunction(bool warn_if_not_found,
+                                       ScriptFunction& function);
+        asIScriptContext* prepareContext(asIScriptFunction* func);
+        bool executeContext(asIScriptContext* ctx);
+        uint64_t getScriptsHash() const;
+
+        static asIScriptContext* requestContext(asIScriptEngine* engine,
+                                                void* param);
+        static void returnContext(asIScriptEngine* engine,
+                                  asIScriptContext* ctx, void* param);
     };   // class ScriptEngine
 
 }
@@ -0,0 +1,77 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_SCRIPT_FUNCTION_HPP
+#define HEADER_SCRIPT_FUNCTION_HPP
+
+#include <string>
+
+class asIScriptFunction;
+
+namespace Scripting
+{
+    /** A handle to a script function, identified by its declaration (e.g.
+     *  "void onStart()"). Objects which call a script function repeatedly
+     *  (e.g. on collisions or triggers) build the declaration once when
+     *  they are loaded. The script engine resolves the function the first
+     *  time it is called after the scripts were (re)compiled, and stores the
+     *  result in this handle, so later calls need no string operations at
+     *  all. This file does not need angelscript.h, so it can be included
+     *  in headers without pulling in the whole script engine.
+     */
+    class ScriptFunction
+    {
+    private:
+        friend class ScriptEngine;
+
+        /** The declaration of the function. */
+        std::string m_declaration;
+
+        /** The resolved function, NULL if it doesn't exist. Only valid if
+         *  m_generation is the current generation of the script engine.
+         *  The script engine keeps the reference to the function. */
+        asIScriptFunction* m_function;
+
+        /** The script engine generation for which m_function was resolved,
+         *  0 if it was never resolved. */
+        unsigned int m_generation;
+
+    public:
+        ScriptFunction() : m_function(NULL), m_generation(0) {}
+        // --------------------------------------------------------------------
+        explicit ScriptFunction(const std::string& declaration)
+            : m_declaration(declaration), m_function(NULL), m_generation(0)
+        {
+        }
+        // --------------------------------------------------------------------
+        /** Sets a new declaration, the function will be resolved again. */
+        void setDeclaration(const std::string& declaration)
+        {
+            m_declaration = declaration;
+            m_function = NULL;
+            m_generation = 0;
+        }   // setDeclaration
+        // --------------------------------------------------------------------
+        const std::string& getDeclaration() const { return m_declaration; }
+        // --------------------------------------------------------------------
+        /** Returns true if no declaration is set. */
+        bool empty() const { return m_declaration.empty(); }
+    };   // class ScriptFunction
+
+}   // namespace Scripting
+#endif
@@ -350,12 +350,7 @@ void AddonsLoading::onUpdate(float delta)
 void AddonsLoading::startDownload()
 {
 #ifndef SERVER_ONLY
-    std::string save   = "tmp/"
-                       + StringUtils::getBasename(m_addon.getZipFileName());
-    m_download_request = std::make_shared<Online::HTTPRequest>(
-        save, /*priority*/5);
-    m_download_request->setURL(m_addon.getZipFileName());
-    m_download_request->queue();
+    m_download_request = addons_manager->downloadAddon(m_addon);
 #endif
 }   // startDownload
 
@@ -412,8 +407,8 @@ void AddonsLoading::doInstall()
         dismiss();
     }
 
-    track_manager->loadTrackList();
-    // Update the replay file list to use latest track pointer
+    // The addon manager only loaded the new addon, but the replay file list
+    // needs to use the latest track pointer
     ReplayPlay::get()->loadAllReplayFile();
     delete grand_prix_manager;
     grand_prix_manager = new GrandPrixManager();
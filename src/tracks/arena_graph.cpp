@@ -19,6 +19,7 @@
 #include "tracks/arena_graph.hpp"
 
 #include "config/user_config.hpp"
+#include "io/asset_cache.hpp"
 #include "io/file_manager.hpp"
 #include "io/xml_node.hpp"
 #include "race/race_manager.hpp"
@@ -28,6 +29,7 @@
 #include "utils/log.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <queue>
 
 // -----------------------------------------------------------------------------
@@ -35,10 +37,15 @@ ArenaGraph::ArenaGraph(const std::string &navmesh, const XMLNode *node)
           : Graph()
 {
     loadNavmesh(navmesh);
-    buildGraph();
-    // Compute shortest distance from all nodes
-    for (unsigned int i = 0; i < getNumNodes(); i++)
-        computeDijkstra(i);
+    const uint64_t content_hash = getContentHash();
+    if (!loadCachedPaths(content_hash))
+    {
+        buildGraph();
+        // Compute shortest distance from all nodes
+        for (unsigned int i = 0; i < getNumNodes(); i++)
+            computeDijkstra(i);
+        saveCachedPaths(content_hash);
+    }
 
     setNearbyNodesOfAllNodes();
     if (node && RaceManager::get()->getMinorMode() == RaceManager::MINOR_MODE_SOCCER)
@@ -264,6 +271,90 @@ void ArenaGraph::computeDijkstra(int source)
     }
 }   // computeDijkstra
 
+// ----------------------------------------------------------------------------
+/** Returns a hash of everything the shortest paths are computed from (node
+ *  centers and adjacency), used as key in the AssetCache.
+ */
+uint64_t ArenaGraph::getContentHash() const
+{
+    uint64_t h = AssetCache::hash(NULL, 0);
+    for (unsigned int i = 0; i < getNumNodes(); i++)
+    {
+        ArenaNode* node = getNode(i);
+        const float center[3] =
+        {
+            node->getCenter().getX(), node->getCenter().getY(),
+            node->getCenter().getZ()
+        };
+        h = AssetCache::hash(center, sizeof(center), h);
+        const std::vector<int>& adjacent = node->getAdjacentNodes();
+        const uint32_t count = (uint32_t)adjacent.size();
+        h = AssetCache::hash(&count, sizeof(count), h);
+        if (count > 0)
+        {
+            h = AssetCache::hash(adjacent.data(), count * sizeof(int), h);
+        }
+    }
+    return h;
+}   // getContentHash
+
+// ----------------------------------------------------------------------------
+/** Loads the distance and parent node matrices computed by a previous run.
+ *  \return True if found in the cache.
+ */
+bool ArenaGraph::loadCachedPaths(uint64_t content_hash)
+{
+    std::string data;
+    if (!AssetCache::load("arena", content_hash, &data))
+        return false;
+
+    const unsigned int n = getNumNodes();
+    if (data.size() != sizeof(uint32_t) +
+        (size_t)n * n * (sizeof(float) + sizeof(int16_t)))
+        return false;
+    uint32_t cached_n = 0;
+    memcpy(&cached_n, data.data(), sizeof(uint32_t));
+    if (cached_n != n)
+        return false;
+
+    const char* p = data.data() + sizeof(uint32_t);
+    m_distance_matrix.assign(n, std::vector<float>(n));
+    m_parent_node.assign(n, std::vector<int16_t>(n));
+    for (unsigned int i = 0; i < n; i++)
+    {
+        memcpy(m_distance_matrix[i].data(), p, n * sizeof(float));
+        p += n * sizeof(float);
+    }
+    for (unsigned int i = 0; i < n; i++)
+    {
+        memcpy(m_parent_node[i].data(), p, n * sizeof(int16_t));
+        p += n * sizeof(int16_t);
+    }
+    return true;
+}   // loadCachedPaths
+
+// ----------------------------------------------------------------------------
+void ArenaGraph::saveCachedPaths(uint64_t content_hash) const
+{
+    const unsigned int n = getNumNodes();
+    std::string data;
+    data.reserve(sizeof(uint32_t) +
+        (size_t)n * n * (sizeof(float) + sizeof(int16_t)));
+    const uint32_t count = n;
+    data.append((const char*)&count, sizeof(uint32_t));
+    for (unsigned int i = 0; i < n; i++)
+    {
+        data.append((const char*)m_distance_matrix[i].data(),
+            n * sizeof(float));
+    }
+    for (unsigned int i = 0; i < n; i++)
+    {
+        data.append((const char*)m_parent_node[i].data(),
+            n * sizeof(int16_t));
+    }
+    AssetCache::save("arena", content_hash, data);
+}   // saveCachedPaths
+
 // ----------------------------------------------------------------------------
 /** THIS FUNCTION IS ONLY USED FOR UNIT-TESTING, to verify that the new
  *  Dijkstra algorithm gives the same results.
@@ -58,6 +58,12 @@ private:
     // ------------------------------------------------------------------------
     void computeFloydWarshall();
     // ------------------------------------------------------------------------
+    uint64_t getContentHash() const;
+    // ------------------------------------------------------------------------
+    bool loadCachedPaths(uint64_t content_hash);
+    // ------------------------------------------------------------------------
+    void saveCachedPaths(uint64_t content_hash) const;
+    // ------------------------------------------------------------------------
     static std::vector<int16_t> getPathFromTo(int from, int to,
                      const std::vector< std::vector< int16_t > >& parent_node);
     // ------------------------------------------------------------------------
@@ -75,6 +75,10 @@ public:
     // ------------------------------------------------------------------------
     virtual bool triggeringCheckline() const OVERRIDE         { return false; }
     // ------------------------------------------------------------------------
+    /** Cannons test karts and flyables in their own update() function. */
+    virtual bool getTriggerArea(Vec3 *min, Vec3 *max) const OVERRIDE
+                                                              { return false; }
+    // ------------------------------------------------------------------------
     /** Adds a flyable to be tested for crossing a cannon checkline.
     *  \param flyable The flyable to be tested.
     */
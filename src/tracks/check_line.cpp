@@ -44,9 +44,6 @@ CheckLine::CheckLine(const XMLNode &node,  unsigned int index)
          : CheckStructure(node, index)
 {
     m_ignore_height = false;
-    // Note that when this is called the karts have not been allocated
-    // in world, so we can't call world->getNumKarts()
-    m_previous_sign.resize(RaceManager::get()->getNumberOfKarts());
     std::string p1_string("p1");
     std::string p2_string("p2");
 
@@ -153,18 +150,6 @@ CheckLine::~CheckLine()
     }
 
 }   // CheckLine
-// ----------------------------------------------------------------------------
-void CheckLine::reset(const Track &track)
-{
-    CheckStructure::reset(track);
-
-    for (unsigned int i = 0; i<m_previous_sign.size(); i++)
-    {
-        m_previous_sign[i] = m_previous_position[i].sideofPlane(
-            m_check_plane[0].pointA,
-            m_check_plane[0].pointB, m_check_plane[0].pointC) >= 0;
-    }
-}   // reset
 
 // ----------------------------------------------------------------------------
 void CheckLine::resetAfterKartMove(unsigned int kart_index)
@@ -201,10 +186,6 @@ bool CheckLine::isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
                             int kart_index)
 {
     World* w = World::getWorld();
-    // Sign here is for old client (<= 1.2) in networking, it's not used
-    // anymore now
-    bool sign = new_pos.sideofPlane(m_check_plane[0].pointA,
-        m_check_plane[0].pointB, m_check_plane[0].pointC) >= 0;
     bool result = false;
 
     bool ignore_height = m_ignore_height;
@@ -240,37 +221,61 @@ start:
         goto start;
     }
 
-    if (kart_index >= 0)
+    if (kart_index >= 0 && result)
     {
-        m_previous_sign[kart_index] = sign;
-        if (result)
-        {
-            LinearWorld* lw = dynamic_cast<LinearWorld*>(w);
-            if (triggeringCheckline() && lw != NULL)
-                lw->setLastTriggeredCheckline(kart_index, m_index);
-        }
+        LinearWorld* lw = dynamic_cast<LinearWorld*>(w);
+        if (triggeringCheckline() && lw != NULL)
+            lw->setLastTriggeredCheckline(kart_index, m_index);
     }
     return result;
 }   // isTriggered
 
+// ----------------------------------------------------------------------------
+/** Returns the bounding box of the planes tested for a kart crossing this
+ *  line, slightly enlarged so that a crossing exactly at the border of the
+ *  box is not missed.
+ */
+bool CheckLine::getTriggerArea(Vec3 *min, Vec3 *max) const
+{
+    *min = *max = Vec3(m_check_plane[0].pointA);
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        const core::vector3df *p[3] = { &m_check_plane[i].pointA,
+                                        &m_check_plane[i].pointB,
+                                        &m_check_plane[i].pointC };
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            min->setMin(Vec3(*p[j]));
+            max->setMax(Vec3(*p[j]));
+        }
+    }
+    *min -= Vec3(0.1f, 0.1f, 0.1f);
+    *max += Vec3(0.1f, 0.1f, 0.1f);
+    return true;
+}   // getTriggerArea
+
 // ----------------------------------------------------------------------------
 void CheckLine::saveCompleteState(BareNetworkString* bns)
 {
     CheckStructure::saveCompleteState(bns);
+    // The side of the line of the previous position is only used by old
+    // clients (<= 1.2) in networking, so it is not stored anymore
     World* world = World::getWorld();
     for (unsigned int i = 0; i < world->getNumKarts(); i++)
-        bns->addUInt8(m_previous_sign[i] ? 1 : 0);
+    {
+        bool sign = m_previous_position[i].sideofPlane(
+            m_check_plane[0].pointA, m_check_plane[0].pointB,
+            m_check_plane[0].pointC) >= 0;
+        bns->addUInt8(sign ? 1 : 0);
+    }
 }   // saveCompleteState
 
 // ----------------------------------------------------------------------------
 void CheckLine::restoreCompleteState(const BareNetworkString& b)
 {
     CheckStructure::restoreCompleteState(b);
-    m_previous_sign.clear();
+    // Skip the side of the line of the previous position (old clients only)
     World* world = World::getWorld();
     for (unsigned int i = 0; i < world->getNumKarts(); i++)
-    {
-        bool previous_sign = b.getUInt8() == 1;
-        m_previous_sign.push_back(previous_sign);
-    }
+        b.getUInt8();
 }   // restoreCompleteState
@@ -59,11 +59,6 @@ private:
      *  points are set from the 2d points and the min height. */
     Vec3            m_left_point, m_right_point;
 
-    /** Stores the sign (i.e. side) of the previous line to save some
-     *  computations. True if the value is >=0, i.e. the point is on
-     *  or to the right of the line. */
-    std::vector<bool> m_previous_sign;
-
     /** Used to display debug information about checklines. */
     std::shared_ptr<SP::SPDynamicDrawCall> m_debug_dy_dc;
 
@@ -74,12 +69,12 @@ public:
     virtual     ~CheckLine();
     virtual bool isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
                              int indx) OVERRIDE;
-    virtual void reset(const Track &track) OVERRIDE;
     virtual void resetAfterKartMove(unsigned int kart_index) OVERRIDE;
     virtual void resetAfterRewind(unsigned int kart_index) OVERRIDE
                                             { resetAfterKartMove(kart_index); }
     virtual void changeDebugColor(bool is_active) OVERRIDE;
     virtual bool triggeringCheckline() const OVERRIDE { return true; }
+    virtual bool getTriggerArea(Vec3 *min, Vec3 *max) const OVERRIDE;
     // ------------------------------------------------------------------------
     /** Sets if this check line should not do a height test for testing
      *  if a line is crossed. Used for basket calls in cannon (the ball can
@@ -23,7 +23,7 @@
 
 #include "io/xml_node.hpp"
 #include "karts/abstract_kart.hpp"
-#include "modes/world.hpp"
+#include "modes/world_with_rank.hpp"
 #include "tracks/check_cannon.hpp"
 #include "tracks/check_goal.hpp"
 #include "tracks/check_lap.hpp"
@@ -31,8 +31,19 @@
 #include "tracks/check_sphere.hpp"
 #include "tracks/check_structure.hpp"
 #include "tracks/drive_graph.hpp"
+#include "tracks/quad.hpp"
+#include "tracks/track_sector.hpp"
 #include "utils/log.hpp"
 
+const float CheckManager::SECTOR_MARGIN = 5.0f;
+
+// ----------------------------------------------------------------------------
+CheckManager::CheckManager()
+{
+    m_check_lap_index = -1;
+}   // CheckManager
+
+// ----------------------------------------------------------------------------
 /** Loads all check structure informaiton from the specified xml file.
  */
 void CheckManager::load(const XMLNode &node)
@@ -44,24 +55,24 @@ void CheckManager::load(const XMLNode &node)
         if(type=="check-line")
         {
             CheckLine *cl = new CheckLine(*check_node, i);
-            m_all_checks.push_back(cl);
+            add(cl);
         }   // checkline
         else if(type=="check-lap")
         {
-            m_all_checks.push_back(new CheckLap(*check_node, i));
+            add(new CheckLap(*check_node, i));
         }
         else if(type=="cannon")
         {
-            m_all_checks.push_back(new CheckCannon(*check_node, i));
+            add(new CheckCannon(*check_node, i));
         }
         else if(type=="goal")
         {
-            m_all_checks.push_back(new CheckGoal(*check_node, i));
+            add(new CheckGoal(*check_node, i));
         }
         else if(type=="check-sphere")
         {
             CheckSphere *cs = new CheckSphere(*check_node, i);
-            m_all_checks.push_back(cs);
+            add(cs);
         }   // checksphere
         else
             Log::warn("CheckManager", "Unknown check structure '%s' - ignored.", type.c_str());
@@ -107,15 +118,100 @@ CheckManager::~CheckManager()
 }   // ~CheckManager
 
 // ----------------------------------------------------------------------------
+/** Adds a check structure. Cannons and lap structures are remembered here,
+ *  and the new structure is updated every frame until it is indexed by
+ *  sectors in the next reset.
+ *  \param strct The check structure to add.
+ */
+void CheckManager::add(CheckStructure* strct)
+{
+    if (strct->getType() == CheckStructure::CT_CANNON)
+        m_all_cannons.push_back(static_cast<CheckCannon*>(strct));
+    if (m_check_lap_index == -1 && dynamic_cast<CheckLap*>(strct) != NULL)
+        m_check_lap_index = (int)m_all_checks.size();
+    m_global_checks.push_back((int)m_all_checks.size());
+    m_all_checks.push_back(strct);
+}   // add
 
+// ----------------------------------------------------------------------------
 /** Resets all checks. */
 void CheckManager::reset(const Track &track)
 {
     std::vector<CheckStructure*>::iterator i;
     for(i=m_all_checks.begin(); i!=m_all_checks.end(); i++)
         (*i)->reset(track);
+
+    m_previous_position.clear();
+    World *world = World::getWorld();
+    for (unsigned int n = 0; n < world->getNumKarts(); n++)
+        m_previous_position.push_back(world->getKart(n)->getXYZ());
+
+    indexBySectors();
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Sorts all check structures into the ones that are updated every frame,
+ *  and the ones that are only tested for karts in a sector close to them.
+ *  Sectors are only used if the world keeps track of the sector of each kart
+ *  in a drive graph.
+ */
+void CheckManager::indexBySectors()
+{
+    m_global_checks.clear();
+    m_indexed_checks.clear();
+    m_sector_checks.clear();
+    m_sector_min.clear();
+    m_sector_max.clear();
+
+    const DriveGraph *dg = DriveGraph::get();
+    bool use_sectors = dg && dg->getNumNodes() > 0 &&
+                       dynamic_cast<WorldWithRank*>(World::getWorld());
+
+    AlignedArray<Vec3> check_min, check_max;
+    for (unsigned int i = 0; i < m_all_checks.size(); i++)
+    {
+        Vec3 min, max;
+        if (use_sectors && m_all_checks[i]->getTriggerArea(&min, &max))
+        {
+            m_indexed_checks.push_back(i);
+            check_min.push_back(min);
+            check_max.push_back(max);
+        }
+        else
+            m_global_checks.push_back(i);
+    }
+    if (m_indexed_checks.empty())
+        return;
+
+    const Vec3 margin(SECTOR_MARGIN, SECTOR_MARGIN, SECTOR_MARGIN);
+    m_sector_checks.resize(dg->getNumNodes());
+    for (unsigned int n = 0; n < dg->getNumNodes(); n++)
+    {
+        const Quad *quad = dg->getQuad(n);
+        Vec3 min = (*quad)[0], max = (*quad)[0];
+        for (unsigned int j = 1; j < 4; j++)
+        {
+            min.setMin((*quad)[j]);
+            max.setMax((*quad)[j]);
+        }
+        min -= margin;
+        max += margin;
+        m_sector_min.push_back(min);
+        m_sector_max.push_back(max);
+
+        for (unsigned int i = 0; i < m_indexed_checks.size(); i++)
+        {
+            if (check_min[i].getX() <= max.getX() &&
+                check_max[i].getX() >= min.getX() &&
+                check_min[i].getY() <= max.getY() &&
+                check_max[i].getY() >= min.getY() &&
+                check_min[i].getZ() <= max.getZ() &&
+                check_max[i].getZ() >= min.getZ()    )
+                m_sector_checks[n].push_back(m_indexed_checks[i]);
+        }
+    }   // for n < getNumNodes
+}   // indexBySectors
+
 // ----------------------------------------------------------------------------
 /** Called after a kart is moved (e.g. after a rescue) to reset any cached
  *  check information. Without this an incorrect crossing of a checkline
@@ -124,6 +220,8 @@ void CheckManager::reset(const Track &track)
  */
 void CheckManager::resetAfterKartMove(AbstractKart *kart)
 {
+    if (!m_previous_position.empty())
+        m_previous_position[kart->getWorldKartId()] = kart->getXYZ();
     std::vector<CheckStructure*>::iterator i;
     for (i = m_all_checks.begin(); i != m_all_checks.end(); i++)
         (*i)->resetAfterKartMove(kart->getWorldKartId());
@@ -138,11 +236,42 @@ void CheckManager::resetAfterRewind()
     World* w = World::getWorld();
     for (unsigned i = 0; i < w->getNumKarts(); i++)
     {
+        if (i < m_previous_position.size())
+            m_previous_position[i] = w->getKart(i)->getXYZ();
         for (unsigned j = 0; j < m_all_checks.size(); j++)
             m_all_checks[j]->resetAfterRewind(w->getKart(i)->getWorldKartId());
     }
 }   // resetAfterRewind
 
+// ----------------------------------------------------------------------------
+/** Copies the previous kart positions to all check structures indexed by
+ *  sectors (which don't update them themselves). Called before the state of
+ *  the check structures is saved, so the state is the same as if all
+ *  structures were updated every frame.
+ */
+void CheckManager::storePreviousPositions()
+{
+    for (unsigned int i = 0; i < m_indexed_checks.size(); i++)
+    {
+        CheckStructure *cs = m_all_checks[m_indexed_checks[i]];
+        for (unsigned int k = 0; k < m_previous_position.size(); k++)
+            cs->setPreviousPosition(k, m_previous_position[k]);
+    }
+}   // storePreviousPositions
+
+// ----------------------------------------------------------------------------
+/** Takes the previous kart positions from the check structures after their
+ *  state was restored.
+ */
+void CheckManager::loadPreviousPositions()
+{
+    if (m_indexed_checks.empty())
+        return;
+    const CheckStructure *cs = m_all_checks[m_indexed_checks[0]];
+    for (unsigned int k = 0; k < m_previous_position.size(); k++)
+        m_previous_position[k] = cs->getPreviousPosition(k);
+}   // loadPreviousPositions
+
 // ----------------------------------------------------------------------------
 /** Adds a flyable object to be tested against cannons. This will allow
  *  bowling- and rubber-balls to fly in a cannon.
@@ -150,12 +279,8 @@ void CheckManager::resetAfterRewind()
  */
 void CheckManager::addFlyableToCannons(Flyable *flyable)
 {
-    for (unsigned int i = 0; i < m_all_checks.size(); i++)
-    {
-        CheckCannon *cc = dynamic_cast<CheckCannon*>(m_all_checks[i]);
-        if (cc)
-            cc->addFlyable(flyable);
-    }
+    for (unsigned int i = 0; i < m_all_cannons.size(); i++)
+        m_all_cannons[i]->addFlyable(flyable);
 }   // addFlyable
 
 // ----------------------------------------------------------------------------
@@ -165,13 +290,8 @@ void CheckManager::addFlyableToCannons(Flyable *flyable)
  */
 void CheckManager::removeFlyableFromCannons(Flyable *flyable)
 {
-    for (unsigned int i = 0; i < m_all_checks.size(); i++)
-    {
-        CheckCannon *cc = dynamic_cast<CheckCannon*>(m_all_checks[i]);
-        if (cc)
-            cc->removeFlyable(flyable);
-    }
-
+    for (unsigned int i = 0; i < m_all_cannons.size(); i++)
+        m_all_cannons[i]->removeFlyable(flyable);
 }   // addFlyable
 
 // ----------------------------------------------------------------------------
@@ -180,24 +300,90 @@ void CheckManager::removeFlyableFromCannons(Flyable *flyable)
  */
 void CheckManager::update(float dt)
 {
-    std::vector<CheckStructure*>::iterator i;
-    for(i=m_all_checks.begin(); i!=m_all_checks.end(); i++)
-        (*i)->update(dt);
+    if (m_indexed_checks.empty())
+    {
+        for (unsigned int i = 0; i < m_global_checks.size(); i++)
+            m_all_checks[m_global_checks[i]]->update(dt);
+    }
+    else
+        updateIndexedChecks(dt);
 }   // update
 
 // ----------------------------------------------------------------------------
-/** Returns the index of the first check structures that triggers a new
- *  lap to be counted. It aborts if no lap structure is defined.
+/** Updates all structures if some are indexed by sectors. Only the indexed
+ *  structures of the current sector of a kart are tested, so the list to
+ *  test only changes when a kart crosses into a new sector. If the kart
+ *  has moved outside of the box of its sector (e.g. when it is off-road or
+ *  flying), all indexed structures are tested for this kart.
+ *  All structures are still updated in the order of their index, as if
+ *  each was updated for all karts, so e.g. a kart crossing a check line and
+ *  a lap line in the same time step triggers them in the same order.
+ *  \param dt Time since last call.
  */
-unsigned int CheckManager::getLapLineIndex() const
+void CheckManager::updateIndexedChecks(float dt)
 {
-    // If possible find a proper check-lap structure:
-    for (unsigned int i=0; i<getCheckStructureCount(); i++)
+    WorldWithRank *wwr = static_cast<WorldWithRank*>(World::getWorld());
+    const unsigned int num_karts = wwr->getNumKarts();
+    m_current_position.resize(num_karts);
+    m_kart_checks.resize(num_karts);
+    m_kart_next_check.assign(num_karts, 0);
+    for (unsigned int k = 0; k < num_karts; k++)
     {
-        CheckStructure* c = getCheckStructure(i);
+        AbstractKart *kart = wwr->getKart(k);
+        m_kart_checks[k] = NULL;
+        if (kart->getKartAnimation()) continue;
+
+        const Vec3 &xyz = kart->getFrontXYZ();
+        m_current_position[k] = xyz;
+        m_kart_checks[k] = &m_indexed_checks;
+        int sector = wwr->getTrackSector(k)->getCurrentGraphNode();
+        if (sector >= 0 && sector < (int)m_sector_checks.size() &&
+            isInSectorBox(sector, m_previous_position[k])       &&
+            isInSectorBox(sector, xyz)                             )
+            m_kart_checks[k] = &m_sector_checks[sector];
+    }   // for k < num_karts
+
+    // All lists of indices are sorted, so they can be merged
+    unsigned int next_global = 0;
+    for (unsigned int i = 0; i < m_all_checks.size(); i++)
+    {
+        if (next_global < m_global_checks.size() &&
+            m_global_checks[next_global] == (int)i)
+        {
+            m_all_checks[i]->update(dt);
+            next_global++;
+            continue;
+        }
+        for (unsigned int k = 0; k < num_karts; k++)
+        {
+            const std::vector<int> *checks = m_kart_checks[k];
+            if (!checks || m_kart_next_check[k] >= checks->size() ||
+                (*checks)[m_kart_next_check[k]] != (int)i)
+                continue;
+            m_kart_next_check[k]++;
+            // A previous structure (e.g. a cannon) can start an animation
+            if (wwr->getKart(k)->getKartAnimation()) continue;
+            m_all_checks[i]->updateKart(k, m_previous_position[k],
+                                        m_current_position[k]);
+        }
+    }   // for i < m_all_checks.size()
 
-        if (dynamic_cast<CheckLap*>(c) != NULL) return i;
+    for (unsigned int k = 0; k < num_karts; k++)
+    {
+        if (m_kart_checks[k])
+            m_previous_position[k] = m_current_position[k];
     }
+}   // updateIndexedChecks
+
+// ----------------------------------------------------------------------------
+/** Returns the index of the first check structures that triggers a new
+ *  lap to be counted. It aborts if no lap structure is defined.
+ */
+unsigned int CheckManager::getLapLineIndex() const
+{
+    // If possible use a proper check-lap structure:
+    if (m_check_lap_index != -1)
+        return m_check_lap_index;
     Log::warn("CheckManager", "No check-lap structure found! This can cause incorrect kart");
     Log::warn("CheckManager", "ranking when crossing the line, but can otherwise be ignored.");
     for (unsigned int i=0; i<getCheckStructureCount(); i++)
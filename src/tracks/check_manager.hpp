@@ -19,30 +19,86 @@
 #ifndef HEADER_CHECK_MANAGER_HPP
 #define HEADER_CHECK_MANAGER_HPP
 
+#include "utils/aligned_array.hpp"
 #include "utils/no_copy.hpp"
+#include "utils/vec3.hpp"
 
 #include <assert.h>
 #include <string>
 #include <vector>
 
 class AbstractKart;
+class CheckCannon;
 class CheckStructure;
 class Flyable;
 class Track;
 class XMLNode;
-class Vec3;
 
 /**
   * \brief Controls all checks structures of a track.
+  *  Check structures which can only be triggered in a certain area (check
+  *  lines) are indexed by the drive graph sectors close to them, so for each
+  *  kart only the structures near its current sector are tested. These
+  *  structures share the previous position of each kart, which is stored
+  *  here. All other structures are updated for all karts every frame.
   * \ingroup tracks
   */
 class CheckManager : public NoCopy
 {
 private:
     std::vector<CheckStructure*> m_all_checks;
+
+    /** All cannons, which also test flyables. */
+    std::vector<CheckCannon*> m_all_cannons;
+
+    /** Index of the first check-lap structure, or -1 if there is none. */
+    int m_check_lap_index;
+
+    /** Indices of the structures that are updated every frame. */
+    std::vector<int> m_global_checks;
+
+    /** Indices of all structures that are indexed by sectors. */
+    std::vector<int> m_indexed_checks;
+
+    /** For each drive graph sector the indices of all indexed structures
+     *  that can be triggered by a kart moving inside the sector's box. */
+    std::vector<std::vector<int> > m_sector_checks;
+
+    /** Bounding box of each sector, enlarged by SECTOR_MARGIN. */
+    AlignedArray<Vec3> m_sector_min, m_sector_max;
+
+    /** The previous front position of each kart, used for all indexed
+     *  structures. */
+    AlignedArray<Vec3> m_previous_position;
+
+    /** Used in update: the current front position of each kart, the
+     *  indexed structures to test for each kart (NULL if the kart is not
+     *  tested), and the next of these structures to test. */
+    AlignedArray<Vec3> m_current_position;
+    std::vector<const std::vector<int>*> m_kart_checks;
+    std::vector<unsigned int> m_kart_next_check;
+
+    /** How much the bounding box of a sector is enlarged, which must include
+     *  the height a kart can be over a quad. */
+    static const float SECTOR_MARGIN;
+
+    void   indexBySectors();
+    void   updateIndexedChecks(float dt);
+    // ------------------------------------------------------------------------
+    /** True if the point is inside the (enlarged) box of the sector. */
+    bool   isInSectorBox(int sector, const Vec3 &xyz) const
+    {
+        const Vec3 &min = m_sector_min[sector];
+        const Vec3 &max = m_sector_max[sector];
+        return xyz.getX() >= min.getX() && xyz.getX() <= max.getX() &&
+               xyz.getY() >= min.getY() && xyz.getY() <= max.getY() &&
+               xyz.getZ() >= min.getZ() && xyz.getZ() <= max.getZ();
+    }   // isInSectorBox
+
 public:
-    ~CheckManager();
-    void   add(CheckStructure* strct) { m_all_checks.push_back(strct); }
+           CheckManager();
+          ~CheckManager();
+    void   add(CheckStructure* strct);
     void   addFlyableToCannons(Flyable *flyable);
     void   removeFlyableFromCannons(Flyable *flyable);
     void   load(const XMLNode &node);
@@ -50,6 +106,8 @@ public:
     void   reset(const Track &track);
     void   resetAfterKartMove(AbstractKart *kart);
     void   resetAfterRewind();
+    void   storePreviousPositions();
+    void   loadPreviousPositions();
     unsigned int getLapLineIndex() const;
     int    getChecklineTriggering(const Vec3 &from, const Vec3 &to) const;
     // ------------------------------------------------------------------------
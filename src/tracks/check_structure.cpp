@@ -111,27 +111,44 @@ void CheckStructure::reset(const Track &track)
 void CheckStructure::update(float dt)
 {
     World *world = World::getWorld();
-    LinearWorld* lw = dynamic_cast<LinearWorld*>(World::getWorld());
     for(unsigned int i=0; i<world->getNumKarts(); i++)
     {
         const Vec3 &xyz = world->getKart(i)->getFrontXYZ();
         if(world->getKart(i)->getKartAnimation()) continue;
-        // Only check active checklines.
-        if(m_is_active[i] && isTriggered(m_previous_position[i], xyz, i))
-        {
-            if(UserConfigParams::m_check_debug)
-                Log::info("CheckStructure",
-                          "Check structure %d triggered for kart %s at %f.",
-                          m_index, world->getKart(i)->getIdent().c_str(),
-                          World::getWorld()->getTime());
-            trigger(i);
-            if (triggeringCheckline() && lw)
-                lw->updateCheckLinesServer(getIndex(), i);
-        }
+        updateKart(i, m_previous_position[i], xyz);
         m_previous_position[i] = xyz;
     }   // for i<getNumKarts
 }   // update
 
+// ----------------------------------------------------------------------------
+/** Tests if a kart triggers this check structure when moving from old_pos
+ *  to new_pos, and if so triggers it. This is used by update(), and by the
+ *  CheckManager for structures that are only tested for karts close to them
+ *  (in which case the CheckManager stores the previous positions).
+ *  \param kart_index World index of the kart.
+ *  \param old_pos Position of the kart in the previous frame.
+ *  \param new_pos Position of the kart in the current frame.
+ */
+void CheckStructure::updateKart(unsigned int kart_index, const Vec3 &old_pos,
+                                const Vec3 &new_pos)
+{
+    // Only check active checklines.
+    if(!m_is_active[kart_index] ||
+       !isTriggered(old_pos, new_pos, kart_index))
+        return;
+
+    World *world = World::getWorld();
+    if(UserConfigParams::m_check_debug)
+        Log::info("CheckStructure",
+                  "Check structure %d triggered for kart %s at %f.",
+                  m_index, world->getKart(kart_index)->getIdent().c_str(),
+                  world->getTime());
+    trigger(kart_index);
+    LinearWorld* lw = dynamic_cast<LinearWorld*>(world);
+    if (triggeringCheckline() && lw)
+        lw->updateCheckLinesServer(getIndex(), kart_index);
+}   // updateKart
+
 // ----------------------------------------------------------------------------
 /** Changes the status (active/inactive) of all check structures contained
  *  in the index list indices.
@@ -109,6 +109,8 @@ public:
                 CheckStructure(const XMLNode &node, unsigned int index);
     virtual    ~CheckStructure() {};
     virtual void update(float dt);
+    void         updateKart(unsigned int kart_index, const Vec3 &old_pos,
+                            const Vec3 &new_pos);
     virtual void resetAfterKartMove(unsigned int kart_index) {}
     virtual void resetAfterRewind(unsigned int kart_index) {}
     virtual void changeDebugColor(bool is_active) {}
@@ -147,6 +149,24 @@ public:
     // ------------------------------------------------------------------------
     int getIndex() const { return m_index; }
     // ------------------------------------------------------------------------
+    /** Returns the box in which a kart must be (at the start or end of a
+     *  frame) to trigger this check structure. Returns false if this
+     *  structure can be triggered anywhere or has to be updated every
+     *  frame, in which case the CheckManager calls update() for it. */
+    virtual bool getTriggerArea(Vec3 *min, Vec3 *max) const { return false; }
+    // ------------------------------------------------------------------------
+    /** Returns the previous position of the specified kart. */
+    const Vec3& getPreviousPosition(unsigned int kart_index) const
+    {
+        return m_previous_position[kart_index];
+    }   // getPreviousPosition
+    // ------------------------------------------------------------------------
+    /** Sets the previous position of the specified kart. */
+    void setPreviousPosition(unsigned int kart_index, const Vec3 &xyz)
+    {
+        m_previous_position[kart_index] = xyz;
+    }   // setPreviousPosition
+    // ------------------------------------------------------------------------
     /** Clone to child process for server usage (atm no sound or scripting). */
     virtual CheckStructure* clone() = 0;
 };   // CheckStructure
@@ -0,0 +1,719 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "tracks/terrain_grid.hpp"
+
+#include "graphics/material.hpp"
+#include "io/asset_cache.hpp"
+#include "physics/triangle_mesh.hpp"
+#include "utils/log.hpp"
+#include "utils/time.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <random>
+
+namespace
+{
+    /** Number of bits in a cell used for the number of layers. */
+    const uint32_t LAYER_BITS      = 3;
+    const uint32_t LAYER_MASK      = (1 << LAYER_BITS) - 1;
+    /** Marks a cell which can not be answered from the grid. */
+    const uint32_t NON_UNIFORM     = LAYER_MASK;
+    /** Maximum number of surfaces above each other in a cell. */
+    const int      MAX_LAYERS      = 4;
+    /** Marks a layer for which no triangle was found (yet). */
+    const uint32_t NO_TRIANGLE     = 0xffffffff;
+
+    /** Cells are at least that big, but the grid is limited to
+     *  MAX_CELLS x MAX_CELLS cells. */
+    const float    MIN_CELL_SIZE   = 2.0f;
+    const int      MAX_CELLS       = 256;
+
+    /** Distance below a surface at which the next surface is searched. */
+    const float    LAYER_DISTANCE  = 0.02f;
+    /** Maximum height difference of triangles and samples to the plane of
+     *  a layer. */
+    const float    HEIGHT_TOLERANCE = 0.02f;
+    /** Minimum dot product of normals in the same layer. */
+    const float    NORMAL_TOLERANCE = 0.9999f;
+    /** Steeper surfaces (like walls) are not stored in the grid. */
+    const float    MIN_NORMAL_Y    = 0.1f;
+    /** Rays starting closer to a surface than this use a raycast, since the
+     *  result depends on rounding errors. */
+    const float    SURFACE_MARGIN  = 0.05f;
+    /** Only rays pointing mostly downwards can be answered from the grid. */
+    const float    MIN_DIRECTION_Y = 0.5f;
+
+    /** A surface found by a vertical sample ray during baking. */
+    struct Sample
+    {
+        float           m_y;
+        float           m_normal[3];
+        const Material *m_material;
+    };   // Sample
+
+    /** Data at the start of the cached grid. */
+    struct GridHeader
+    {
+        int32_t  m_size_x, m_size_z;
+        float    m_min_x, m_min_z, m_min_y, m_max_y, m_cell_size;
+        uint32_t m_num_layers;
+    };   // GridHeader
+
+    // ------------------------------------------------------------------------
+    /** Collects all surfaces below the given x/z position, from top to
+     *  bottom. If there are more than MAX_LAYERS surfaces MAX_LAYERS+1 is
+     *  returned.
+     */
+    int sampleColumn(const TriangleMesh &mesh, float x, float z, float min_y,
+                     float max_y, Sample *samples)
+    {
+        btVector3 from(x, max_y + 1.0f, z);
+        const btVector3 to(x, min_y - 1.0f, z);
+        int count = 0;
+        while (count <= MAX_LAYERS)
+        {
+            btVector3 hit, normal;
+            const Material *material;
+            if (!mesh.castRay(from, to, &hit, &material, &normal))
+                break;
+            Sample &s = samples[count++];
+            s.m_y = hit.getY();
+            s.m_normal[0] = normal.getX();
+            s.m_normal[1] = normal.getY();
+            s.m_normal[2] = normal.getZ();
+            s.m_material = material;
+            from.setY(hit.getY() - LAYER_DISTANCE);
+        }
+        return count;
+    }   // sampleColumn
+
+    // ------------------------------------------------------------------------
+    /** Returns the height of the plane normal.xyz = d at the given x/z. */
+    float getHeight(const float *normal, float d, float x, float z)
+    {
+        return (d - normal[0] * x - normal[2] * z) / normal[1];
+    }   // getHeight
+}   // namespace
+
+// ----------------------------------------------------------------------------
+/** Creates the grid for the given static mesh, which must have its collision
+ *  shape created. The grid is loaded from the AssetCache if possible.
+ *  \param mesh The mesh, it must not be changed while this grid exists.
+ *  \param use_cache If the AssetCache should be used.
+ */
+TerrainGrid::TerrainGrid(const TriangleMesh &mesh, bool use_cache)
+           : m_mesh(mesh)
+{
+    m_min_x = m_min_z = 0.0f;
+    m_min_y = m_max_y = 0.0f;
+    m_cell_size = MIN_CELL_SIZE;
+    m_size_x = m_size_z = 0;
+    if (mesh.getNumberOfTriangles() == 0)
+        return;
+
+    const uint64_t hash = use_cache ? getHash() : 0;
+    if (use_cache && load(hash))
+        return;
+
+    const double start = StkTime::getRealTime();
+    bake();
+    Log::info("TerrainGrid", "Sampled %dx%d cells (%.1f%% uniform) in %f "
+              "seconds.", m_size_x, m_size_z, getUniformPercent(),
+              StkTime::getRealTime() - start);
+    if (use_cache)
+        AssetCache::save("terrain-grid", hash, serialize());
+}   // TerrainGrid
+
+// ----------------------------------------------------------------------------
+/** Samples the mesh with vertical rays at all corners and centers of the
+ *  cells to find the layers of each cell, then checks that all triangles
+ *  overlapping a cell are part of one of its layers.
+ */
+void TerrainGrid::bake()
+{
+    const unsigned int triangles = m_mesh.getNumberOfTriangles();
+    btVector3 aabb_min( FLT_MAX,  FLT_MAX,  FLT_MAX);
+    btVector3 aabb_max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (unsigned int i = 0; i < triangles; i++)
+    {
+        btVector3 p[3];
+        m_mesh.getTriangle(i, &p[0], &p[1], &p[2]);
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            aabb_min.setMin(p[j]);
+            aabb_max.setMax(p[j]);
+        }
+    }
+    m_min_x = aabb_min.getX();
+    m_min_z = aabb_min.getZ();
+    m_min_y = aabb_min.getY();
+    m_max_y = aabb_max.getY();
+    m_cell_size = std::max(MIN_CELL_SIZE,
+        std::max(aabb_max.getX() - m_min_x,
+                 aabb_max.getZ() - m_min_z) / MAX_CELLS);
+    m_size_x = std::min(MAX_CELLS,
+                        int((aabb_max.getX() - m_min_x) / m_cell_size) + 1);
+    m_size_z = std::min(MAX_CELLS,
+                        int((aabb_max.getZ() - m_min_z) / m_cell_size) + 1);
+
+    // The corners of all cells are sampled first, followed by the centers
+    const int num_corners = (m_size_x + 1) * (m_size_z + 1);
+    const int num_columns = num_corners + m_size_x * m_size_z;
+    std::vector<Sample> samples(num_columns * (MAX_LAYERS + 1));
+    std::vector<int> sample_count(num_columns);
+    for (int z = 0; z <= m_size_z; z++)
+    {
+        for (int x = 0; x <= m_size_x; x++)
+        {
+            const int n = z * (m_size_x + 1) + x;
+            sample_count[n] = sampleColumn(m_mesh,
+                m_min_x + x * m_cell_size, m_min_z + z * m_cell_size,
+                m_min_y, m_max_y, &samples[n * (MAX_LAYERS + 1)]);
+        }
+    }
+    for (int z = 0; z < m_size_z; z++)
+    {
+        for (int x = 0; x < m_size_x; x++)
+        {
+            const int n = num_corners + z * m_size_x + x;
+            sample_count[n] = sampleColumn(m_mesh,
+                m_min_x + (x + 0.5f) * m_cell_size,
+                m_min_z + (z + 0.5f) * m_cell_size,
+                m_min_y, m_max_y, &samples[n * (MAX_LAYERS + 1)]);
+        }
+    }
+
+    // A layer is the plane through the sample in the center of the cell,
+    // all corners must have a sample on this plane with the same material.
+    std::vector<const Material*> layer_materials;
+    m_cells.resize(m_size_x * m_size_z);
+    m_layers.clear();
+    for (int z = 0; z < m_size_z; z++)
+    {
+        for (int x = 0; x < m_size_x; x++)
+        {
+            const int center = num_corners + z * m_size_x + x;
+            const int corners[4] = { z * (m_size_x + 1) + x,
+                                     z * (m_size_x + 1) + x + 1,
+                                     (z + 1) * (m_size_x + 1) + x,
+                                     (z + 1) * (m_size_x + 1) + x + 1 };
+            uint32_t &cell = m_cells[z * m_size_x + x];
+            const int count = sample_count[center];
+            bool uniform = count <= MAX_LAYERS;
+            for (int j = 0; j < 4; j++)
+                uniform &= sample_count[corners[j]] == count;
+
+            const uint32_t first = (uint32_t)m_layers.size();
+            for (int k = 0; uniform && k < count; k++)
+            {
+                const Sample &s = samples[center * (MAX_LAYERS + 1) + k];
+                if (s.m_normal[1] < MIN_NORMAL_Y)
+                {
+                    uniform = false;
+                    break;
+                }
+                Layer layer;
+                memcpy(layer.m_normal, s.m_normal, sizeof(layer.m_normal));
+                layer.m_d = s.m_normal[0] * (m_min_x + (x+0.5f)*m_cell_size)
+                          + s.m_normal[1] * s.m_y
+                          + s.m_normal[2] * (m_min_z + (z+0.5f)*m_cell_size);
+                layer.m_triangle = NO_TRIANGLE;
+                for (int j = 0; j < 4; j++)
+                {
+                    const Sample &c = samples[corners[j]*(MAX_LAYERS+1) + k];
+                    const float cx = m_min_x + (x + j % 2) * m_cell_size;
+                    const float cz = m_min_z + (z + j / 2) * m_cell_size;
+                    const float dot = c.m_normal[0] * s.m_normal[0]
+                                    + c.m_normal[1] * s.m_normal[1]
+                                    + c.m_normal[2] * s.m_normal[2];
+                    if (c.m_material != s.m_material ||
+                        dot < NORMAL_TOLERANCE ||
+                        fabsf(getHeight(layer.m_normal, layer.m_d, cx, cz)
+                              - c.m_y) > HEIGHT_TOLERANCE)
+                    {
+                        uniform = false;
+                        break;
+                    }
+                }
+                m_layers.push_back(layer);
+                layer_materials.push_back(s.m_material);
+            }
+            if (uniform)
+                cell = (first << LAYER_BITS) | count;
+            else
+            {
+                cell = NON_UNIFORM;
+                m_layers.resize(first);
+                layer_materials.resize(first);
+            }
+        }   // for x
+    }   // for z
+
+    // Small details between the samples (e.g. a small patch of a different
+    // material, a bump or a wall) would be missed, so each triangle must be
+    // part of a layer in all cells it overlaps.
+    for (unsigned int i = 0; i < triangles; i++)
+    {
+        btVector3 p[3];
+        m_mesh.getTriangle(i, &p[0], &p[1], &p[2]);
+        btVector3 normal = (p[1] - p[0]).cross(p[2] - p[0]);
+        if (normal.length2() < 1e-12f)
+            continue;
+        normal.normalize();
+        if (normal.getY() < 0)
+            normal = -normal;
+        const float n[3] = { normal.getX(), normal.getY(), normal.getZ() };
+        const float d = normal.dot(p[0]);
+        const Material *material = m_mesh.getMaterial(i);
+
+        btVector3 t_min = p[0], t_max = p[0];
+        t_min.setMin(p[1]); t_min.setMin(p[2]);
+        t_max.setMax(p[1]); t_max.setMax(p[2]);
+        const int x0 = std::max(0,
+            int(floorf((t_min.getX() - m_min_x) / m_cell_size)));
+        const int z0 = std::max(0,
+            int(floorf((t_min.getZ() - m_min_z) / m_cell_size)));
+        const int x1 = std::min(m_size_x - 1,
+            int(floorf((t_max.getX() - m_min_x) / m_cell_size)));
+        const int z1 = std::min(m_size_z - 1,
+            int(floorf((t_max.getZ() - m_min_z) / m_cell_size)));
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                uint32_t &cell = m_cells[z * m_size_x + x];
+                if (cell == NON_UNIFORM)
+                    continue;
+                if (n[1] < MIN_NORMAL_Y)
+                {
+                    cell = NON_UNIFORM;
+                    continue;
+                }
+                const uint32_t first = cell >> LAYER_BITS;
+                const uint32_t count = cell & LAYER_MASK;
+                bool found = false;
+                for (uint32_t k = first; !found && k < first + count; k++)
+                {
+                    Layer &layer = m_layers[k];
+                    if (layer_materials[k] != material ||
+                        n[0] * layer.m_normal[0] + n[1] * layer.m_normal[1] +
+                        n[2] * layer.m_normal[2] < NORMAL_TOLERANCE)
+                        continue;
+                    found = true;
+                    for (int j = 0; j < 4; j++)
+                    {
+                        const float cx = m_min_x + (x + j % 2) * m_cell_size;
+                        const float cz = m_min_z + (z + j / 2) * m_cell_size;
+                        if (fabsf(getHeight(n, d, cx, cz) -
+                                  getHeight(layer.m_normal, layer.m_d, cx, cz))
+                            > HEIGHT_TOLERANCE)
+                        {
+                            found = false;
+                            break;
+                        }
+                    }
+                    if (found && layer.m_triangle == NO_TRIANGLE)
+                        layer.m_triangle = i;
+                }
+                if (!found)
+                    cell = NON_UNIFORM;
+            }   // for x
+        }   // for z
+    }   // for i
+
+    // Remove the layers of cells which turned out not to be uniform
+    std::vector<Layer> layers;
+    for (uint32_t &cell : m_cells)
+    {
+        if (cell == NON_UNIFORM)
+            continue;
+        const uint32_t first = cell >> LAYER_BITS;
+        const uint32_t count = cell & LAYER_MASK;
+        bool has_triangles = true;
+        for (uint32_t k = first; k < first + count; k++)
+            has_triangles &= m_layers[k].m_triangle != NO_TRIANGLE;
+        if (!has_triangles)
+        {
+            cell = NON_UNIFORM;
+            continue;
+        }
+        cell = ((uint32_t)layers.size() << LAYER_BITS) | count;
+        layers.insert(layers.end(), m_layers.begin() + first,
+                      m_layers.begin() + first + count);
+    }
+    m_layers.swap(layers);
+}   // bake
+
+// ----------------------------------------------------------------------------
+/** Returns the key of this grid in the AssetCache, which depends on the
+ *  triangles, which triangles share a material, and the grid parameters.
+ */
+uint64_t TerrainGrid::getHash() const
+{
+    uint64_t h = m_mesh.getContentHash();
+    std::map<const Material*, uint32_t> material_ids;
+    for (unsigned int i = 0; i < m_mesh.getNumberOfTriangles(); i++)
+    {
+        auto it = material_ids.insert(std::make_pair(m_mesh.getMaterial(i),
+                                      (uint32_t)material_ids.size())).first;
+        h = AssetCache::hash(&it->second, sizeof(uint32_t), h);
+    }
+    const float parameters[] = { MIN_CELL_SIZE, (float)MAX_CELLS,
+        (float)MAX_LAYERS, LAYER_DISTANCE, HEIGHT_TOLERANCE,
+        NORMAL_TOLERANCE, MIN_NORMAL_Y };
+    return AssetCache::hash(parameters, sizeof(parameters), h);
+}   // getHash
+
+// ----------------------------------------------------------------------------
+/** Returns the data of this grid to be saved in the AssetCache. */
+std::string TerrainGrid::serialize() const
+{
+    GridHeader header;
+    header.m_size_x     = m_size_x;
+    header.m_size_z     = m_size_z;
+    header.m_min_x      = m_min_x;
+    header.m_min_z      = m_min_z;
+    header.m_min_y      = m_min_y;
+    header.m_max_y      = m_max_y;
+    header.m_cell_size  = m_cell_size;
+    header.m_num_layers = (uint32_t)m_layers.size();
+    std::string data((const char*)&header, sizeof(header));
+    data.append((const char*)m_cells.data(),
+                m_cells.size() * sizeof(uint32_t));
+    data.append((const char*)m_layers.data(),
+                m_layers.size() * sizeof(Layer));
+    return data;
+}   // serialize
+
+// ----------------------------------------------------------------------------
+/** Loads the grid from the AssetCache.
+ *  \return True if a valid grid was found.
+ */
+bool TerrainGrid::load(uint64_t hash)
+{
+    std::string data;
+    if (!AssetCache::load("terrain-grid", hash, &data))
+        return false;
+
+    GridHeader header;
+    if (data.size() < sizeof(header))
+        return false;
+    memcpy(&header, data.data(), sizeof(header));
+    const size_t num_cells = (size_t)header.m_size_x * header.m_size_z;
+    if (header.m_size_x <= 0 || header.m_size_x > MAX_CELLS ||
+        header.m_size_z <= 0 || header.m_size_z > MAX_CELLS ||
+        data.size() != sizeof(header) + num_cells * sizeof(uint32_t) +
+                       header.m_num_layers * sizeof(Layer))
+        return false;
+
+    m_cells.resize(num_cells);
+    memcpy(m_cells.data(), data.data() + sizeof(header),
+           num_cells * sizeof(uint32_t));
+    m_layers.resize(header.m_num_layers);
+    if (header.m_num_layers > 0)
+    {
+        memcpy(m_layers.data(), data.data() + sizeof(header) +
+               num_cells * sizeof(uint32_t), m_layers.size() * sizeof(Layer));
+    }
+    bool valid = true;
+    for (uint32_t cell : m_cells)
+    {
+        if (cell != NON_UNIFORM && (cell >> LAYER_BITS) +
+            (cell & LAYER_MASK) > header.m_num_layers)
+            valid = false;
+    }
+    for (const Layer &layer : m_layers)
+    {
+        if (layer.m_triangle >= m_mesh.getNumberOfTriangles())
+            valid = false;
+    }
+    if (!valid)
+    {
+        Log::warn("TerrainGrid", "Ignoring invalid cached grid.");
+        m_cells.clear();
+        m_layers.clear();
+        return false;
+    }
+
+    m_size_x    = header.m_size_x;
+    m_size_z    = header.m_size_z;
+    m_min_x     = header.m_min_x;
+    m_min_z     = header.m_min_z;
+    m_min_y     = header.m_min_y;
+    m_max_y     = header.m_max_y;
+    m_cell_size = header.m_cell_size;
+    return true;
+}   // load
+
+// ----------------------------------------------------------------------------
+/** Tries to answer a raycast from the grid. The ray must stay in one cell
+ *  until it hits a layer (or gets below the mesh).
+ *  \return QR_HIT or QR_MISS if the grid determined the result (and the
+ *          output parameters are set), or QR_UNKNOWN if a raycast is needed.
+ */
+TerrainGrid::QueryResult TerrainGrid::query(const btVector3 &from,
+                                            const btVector3 &to,
+                                            btVector3 *xyz,
+                                            const Material **material,
+                                            btVector3 *normal) const
+{
+    const btVector3 dir = to - from;
+    if (dir.getY() > -MIN_DIRECTION_Y * dir.length())
+        return QR_UNKNOWN;
+
+    // Negated test to catch NAN as well
+    const float fx = (from.getX() - m_min_x) / m_cell_size;
+    const float fz = (from.getZ() - m_min_z) / m_cell_size;
+    if (!(fx >= 0 && fx < m_size_x && fz >= 0 && fz < m_size_z))
+        return QR_UNKNOWN;
+    const int x = int(fx), z = int(fz);
+    const uint32_t cell = m_cells[z * m_size_x + x];
+    if (cell == NON_UNIFORM)
+        return QR_UNKNOWN;
+
+    const uint32_t first = cell >> LAYER_BITS;
+    const uint32_t count = cell & LAYER_MASK;
+    const Layer *hit_layer = NULL;
+    float hit_t = 1.0f;
+    float hit_distance = 0.0f;
+    for (uint32_t k = first; k < first + count; k++)
+    {
+        const Layer &layer = m_layers[k];
+        const float distance = layer.m_normal[0] * from.getX() +
+                               layer.m_normal[1] * from.getY() +
+                               layer.m_normal[2] * from.getZ() - layer.m_d;
+        if (fabsf(distance) < SURFACE_MARGIN)
+            return QR_UNKNOWN;
+        const float speed = layer.m_normal[0] * dir.getX() +
+                            layer.m_normal[1] * dir.getY() +
+                            layer.m_normal[2] * dir.getZ();
+        if (speed == 0.0f)
+            continue;
+        const float t = -distance / speed;
+        if (t >= 0 && t <= hit_t)
+        {
+            hit_t = t;
+            hit_layer = &layer;
+            hit_distance = distance;
+        }
+    }
+
+    // If nothing was hit, the ray must stay in this cell until it is below
+    // the lowest point of the mesh
+    float end_t = hit_t;
+    if (!hit_layer && from.getY() > m_min_y)
+        end_t = std::min(1.0f, (m_min_y - 1.0f - from.getY()) / dir.getY());
+    else if (!hit_layer)
+        end_t = 0.0f;
+    const btVector3 end = from + dir * end_t;
+    if (int(floorf((end.getX() - m_min_x) / m_cell_size)) != x ||
+        int(floorf((end.getZ() - m_min_z) / m_cell_size)) != z)
+        return QR_UNKNOWN;
+
+    if (!hit_layer)
+    {
+        *material = NULL;
+        if (normal)
+            normal->setValue(0, 1, 0);
+        return QR_MISS;
+    }
+
+    *xyz = end;
+    xyz->setW(0.0f);
+    *material = m_mesh.getMaterial(hit_layer->m_triangle);
+    if (normal)
+    {
+        // Like bullet, return the normal facing the start of the ray
+        normal->setValue(hit_layer->m_normal[0], hit_layer->m_normal[1],
+                         hit_layer->m_normal[2]);
+        if (hit_distance < 0)
+            *normal = -*normal;
+        normal->normalize();
+    }
+    return QR_HIT;
+}   // query
+
+// ----------------------------------------------------------------------------
+/** Replacement for TriangleMesh::castRay (without normal interpolation) for
+ *  the mesh of this grid. Rays pointing downwards are answered from the
+ *  grid if possible, all others use a raycast.
+ */
+bool TerrainGrid::castRay(const btVector3 &from, const btVector3 &to,
+                          btVector3 *xyz, const Material **material,
+                          btVector3 *normal) const
+{
+    switch (query(from, to, xyz, material, normal))
+    {
+    case QR_HIT:  return true;
+    case QR_MISS: return false;
+    default:      break;
+    }
+    return m_mesh.castRay(from, to, xyz, material, normal);
+}   // castRay
+
+// ----------------------------------------------------------------------------
+/** Returns the percentage of cells which can be answered without a
+ *  raycast. */
+float TerrainGrid::getUniformPercent() const
+{
+    if (m_cells.empty())
+        return 0.0f;
+    const size_t uniform = m_cells.size() -
+        std::count(m_cells.begin(), m_cells.end(), NON_UNIFORM);
+    return 100.0f * uniform / m_cells.size();
+}   // getUniformPercent
+
+// ----------------------------------------------------------------------------
+/** Compares the grid with raycasts against the mesh for random vertical and
+ *  slightly tilted rays, and prints the result.
+ *  \param count Number of rays to test.
+ *  \return Number of rays for which the grid gives a different result.
+ */
+unsigned int TerrainGrid::validate(unsigned int count) const
+{
+    std::mt19937 random(count);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    unsigned int answered = 0, errors = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const btVector3 from(m_min_x + unit(random) * m_size_x * m_cell_size,
+                             m_min_y - 1.0f +
+                             unit(random) * (m_max_y - m_min_y + 6.0f),
+                             m_min_z + unit(random) * m_size_z * m_cell_size);
+        btVector3 dir(0, -1, 0);
+        if (i % 2 == 1)
+            dir = btVector3(unit(random) - 0.5f, -2.0f, unit(random) - 0.5f);
+        const btVector3 to = from + dir.normalized() * 10000.0f;
+
+        btVector3 grid_xyz, grid_normal;
+        const Material *grid_material;
+        QueryResult result = query(from, to, &grid_xyz, &grid_material,
+                                   &grid_normal);
+        if (result == QR_UNKNOWN)
+            continue;
+        answered++;
+
+        btVector3 xyz, normal;
+        const Material *material;
+        bool hit = m_mesh.castRay(from, to, &xyz, &material, &normal);
+        bool same = hit == (result == QR_HIT);
+        if (same && hit)
+        {
+            same = material == grid_material &&
+                   xyz.distance(grid_xyz) < 0.05f &&
+                   normal.dot(grid_normal) > 0.999f;
+        }
+        if (!same && ++errors <= 10)
+        {
+            Log::warn("TerrainGrid", "Ray from (%f %f %f) hits (%f %f %f), "
+                      "grid (%f %f %f).", from.getX(), from.getY(),
+                      from.getZ(), hit ? xyz.getX() : 0, hit ? xyz.getY() : 0,
+                      hit ? xyz.getZ() : 0, grid_xyz.getX(), grid_xyz.getY(),
+                      grid_xyz.getZ());
+        }
+    }
+    Log::info("TerrainGrid", "%d cells, %.1f%% uniform, %u of %u rays "
+              "answered, %u different from raycast.", m_size_x * m_size_z,
+              getUniformPercent(), answered, count, errors);
+    return errors;
+}   // validate
+
+// ----------------------------------------------------------------------------
+/** Tests the grid on a small track with a bridge, a ramp, a wall and a small
+ *  patch of a different material.
+ */
+void TerrainGrid::unitTesting()
+{
+    Material road("unicolor_white", /*is_full_path*/false,
+                  /*complain_if_not_found*/false, /*load_texture*/false);
+    Material zipper("unicolor_white", /*is_full_path*/false,
+                    /*complain_if_not_found*/false, /*load_texture*/false);
+
+    TriangleMesh mesh(/*can_be_transformed*/false);
+    auto add_quad = [&mesh](const btVector3 &a, const btVector3 &b,
+                            const btVector3 &c, const btVector3 &d,
+                            const Material *m)
+    {
+        const btVector3 n = (b - a).cross(c - a).normalized();
+        mesh.addTriangle(a, b, c, n, n, n, m);
+        mesh.addTriangle(a, c, d, n, n, n, m);
+    };
+    // Ground
+    for (int x = -40; x < 40; x += 4)
+    {
+        for (int z = -40; z < 40; z += 4)
+        {
+            add_quad(btVector3(x, 0, z), btVector3(x, 0, z + 4),
+                     btVector3(x + 4, 0, z + 4), btVector3(x + 4, 0, z),
+                     &road);
+        }
+    }
+    // A patch smaller than a cell, not hit by any sample ray
+    add_quad(btVector3(10.2f, 0.01f, 10.2f), btVector3(10.2f, 0.01f, 10.8f),
+             btVector3(10.8f, 0.01f, 10.8f), btVector3(10.8f, 0.01f, 10.2f),
+             &zipper);
+    // A ramp above the ground
+    add_quad(btVector3(20, 0, -10), btVector3(20, 0, 10),
+             btVector3(30, 5, 10), btVector3(30, 5, -10), &road);
+    // A bridge with top and bottom
+    add_quad(btVector3(-30, 5, -5), btVector3(-30, 5, 5),
+             btVector3(-10, 5, 5), btVector3(-10, 5, -5), &road);
+    add_quad(btVector3(-30, 4.5f, -5), btVector3(-10, 4.5f, -5),
+             btVector3(-10, 4.5f, 5), btVector3(-30, 4.5f, 5), &road);
+    // A wall
+    add_quad(btVector3(-20, 0, 30), btVector3(-20, 3, 30),
+             btVector3(20, 3, 30), btVector3(20, 0, 30), &road);
+    mesh.createCollisionShape();
+
+    TerrainGrid grid(mesh, /*use_cache*/false);
+    assert(grid.getUniformPercent() > 50.0f);
+    assert(grid.validate(20000) == 0);
+
+    btVector3 xyz, normal;
+    const Material *material;
+    // On, in and below the bridge
+    assert(grid.query(btVector3(-20, 10, 1), btVector3(-20, -10, 1), &xyz,
+                      &material, &normal) == QR_HIT);
+    assert(fabsf(xyz.getY() - 5.0f) < 0.01f && material == &road);
+    assert(grid.query(btVector3(-20, 4.8f, 1), btVector3(-20, -10, 1), &xyz,
+                      &material, &normal) == QR_HIT);
+    assert(fabsf(xyz.getY() - 4.5f) < 0.01f);
+    assert(grid.query(btVector3(-20, 2, 1), btVector3(-20, -10, 1), &xyz,
+                      &material, &normal) == QR_HIT);
+    assert(fabsf(xyz.getY()) < 0.01f && normal.getY() > 0.999f);
+    // Below the ground nothing is hit
+    assert(grid.query(btVector3(-20, -2, 1), btVector3(-20, -10, 1), &xyz,
+                      &material, &normal) == QR_MISS);
+    // The cell with the patch must use a raycast
+    assert(grid.query(btVector3(11, 2, 11), btVector3(11, -10, 11), &xyz,
+                      &material, &normal) == QR_UNKNOWN);
+    assert(grid.castRay(btVector3(10.5f, 2, 10.5f),
+                        btVector3(10.5f, -10, 10.5f), &xyz, &material));
+    assert(material == &zipper);
+    // Horizontal rays are not answered by the grid
+    assert(grid.query(btVector3(0, 1, 0), btVector3(0, 1, 100), &xyz,
+                      &material, &normal) == QR_UNKNOWN);
+    // Only used in asserts
+    (void)material;
+}   // unitTesting
@@ -0,0 +1,102 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2026 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_TERRAIN_GRID_HPP
+#define HEADER_TERRAIN_GRID_HPP
+
+#include "utils/no_copy.hpp"
+
+#include "LinearMath/btVector3.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Material;
+class TriangleMesh;
+
+/**
+ *  \brief A 2.5D grid over the x/z plane of the static track mesh, which
+ *  answers 'what is below this point' queries without a raycast.
+ *  Each cell stores the surfaces (layers, more than one for overpasses or
+ *  bridges) a vertical ray through the cell can hit, as a plane and the
+ *  triangle providing its material. Only cells in which every triangle is
+ *  part of one of these planes with the same material are used, all other
+ *  cells (e.g. at the edge of the road, walls, bumpy terrain) and rays which
+ *  start too close to a surface fall back to a raycast against the mesh.
+ *  The grid is sampled when the track is loaded (or loaded from the
+ *  AssetCache), so answers are only approximate for holes in a surface
+ *  smaller than a cell.
+ * \ingroup tracks
+ */
+class TerrainGrid : public NoCopy
+{
+private:
+    /** A surface in a cell: the plane normal.xyz = d, with the normal
+     *  pointing up, and the triangle which determines the material. */
+    struct Layer
+    {
+        float    m_normal[3];
+        float    m_d;
+        uint32_t m_triangle;
+    };   // Layer
+
+    /** The result of a query of the grid. */
+    enum QueryResult { QR_HIT, QR_MISS, QR_UNKNOWN };
+
+    /** The mesh this grid was created from, used for fallback raycasts. */
+    const TriangleMesh &m_mesh;
+
+    /** For each cell the index of its first layer (shifted by LAYER_BITS),
+     *  and the number of layers, or NON_UNIFORM if a raycast is needed. */
+    std::vector<uint32_t> m_cells;
+
+    /** The layers of all cells, sorted from top to bottom in each cell. */
+    std::vector<Layer>    m_layers;
+
+    /** Minimum corner of the grid. */
+    float m_min_x, m_min_z;
+
+    /** Lowest and highest point of the mesh. */
+    float m_min_y, m_max_y;
+
+    /** Size of a cell. */
+    float m_cell_size;
+
+    /** Number of cells in x and z direction. */
+    int   m_size_x, m_size_z;
+
+    void         bake();
+    bool         load(uint64_t hash);
+    std::string  serialize() const;
+    uint64_t     getHash() const;
+    QueryResult  query(const btVector3 &from, const btVector3 &to,
+                       btVector3 *xyz, const Material **material,
+                       btVector3 *normal) const;
+
+public:
+                 TerrainGrid(const TriangleMesh &mesh, bool use_cache = true);
+    bool         castRay(const btVector3 &from, const btVector3 &to,
+                         btVector3 *xyz, const Material **material,
+                         btVector3 *normal = NULL) const;
+    unsigned int validate(unsigned int count) const;
+    float        getUniformPercent() const;
+    static void  unitTesting();
+};   // TerrainGrid
+
+#endif
@@ -54,12 +54,11 @@ TerrainInfo::TerrainInfo(const Vec3 &pos)
 void TerrainInfo::update(const Vec3 &from)
 {
     m_last_material = m_material;
-    btVector3 to(from);
+    Vec3 to(from);
     to.setY(-10000.0f);
 
-    const TriangleMesh &tm = Track::getCurrentTrack()->getTriangleMesh();
-    tm.castRay(from, to, &m_hit_point, &m_material, &m_normal,
-               /*interpolate*/false);
+    Track::getCurrentTrack()->castRayToTerrain(from, to, &m_hit_point,
+                                               &m_material, &m_normal);
     // Now also raycast against all track objects (that are driveable).
     Track::getCurrentTrack()->getTrackObjectManager()
                      ->castRay(from, to, &m_hit_point, &m_material,
@@ -100,10 +99,10 @@ void TerrainInfo::update(const Vec3 &from, const Vec3 &towards)
 {
     m_last_material = m_material;
     Vec3 direction = towards.normalized();
-    btVector3 to = from + 10000.0f*direction;
+    Vec3 to = from + 10000.0f*direction;
 
-    const TriangleMesh &tm = Track::getCurrentTrack()->getTriangleMesh();
-    tm.castRay(from, to, &m_hit_point, &m_material, &m_normal);
+    Track::getCurrentTrack()->castRayToTerrain(from, to, &m_hit_point,
+                                               &m_material, &m_normal);
 }   // update
 
 // -----------------------------------------------------------------------------
@@ -75,6 +75,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "tracks/model_definition_loader.hpp"
+#include "tracks/terrain_grid.hpp"
 #include "tracks/track_manager.hpp"
 #include "tracks/track_object_manager.hpp"
 #include "utils/constants.hpp"
@@ -144,6 +145,7 @@ Track::Track(const std::string &filename)
     m_track_mesh            = NULL;
     m_height_map_mesh       = NULL;
     m_gfx_effect_mesh       = NULL;
+    m_terrain_grid          = NULL;
     m_internal              = false;
     m_enable_auto_rescue    = true;  // Below set to false in arenas
     m_enable_push_back      = true;
@@ -375,6 +377,9 @@ void Track::cleanup()
     if (CVS->isGLSL())
         m_sun->drop();
 #endif
+    delete m_terrain_grid;
+    m_terrain_grid = NULL;
+
     delete m_track_mesh;
     m_track_mesh = NULL;
 
@@ -925,7 +930,12 @@ void Track::createPhysicsModel(unsigned int main_track_count,
     if (for_height_map)
         m_track_mesh->createCollisionShape();
     else
+    {
         m_track_mesh->createPhysicalBody(m_friction);
+        createTerrainGrid();
+        if (m_terrain_grid && UserConfigParams::m_check_terrain_grid)
+            m_terrain_grid->validate(100000);
+    }
     main_loop->renderGUI(5585);
     if (m_gfx_effect_mesh)
         m_gfx_effect_mesh->createCollisionShape();
@@ -933,6 +943,31 @@ void Track::createPhysicsModel(unsigned int main_track_count,
 
 }   // createPhysicsModel
 
+// ----------------------------------------------------------------------------
+/** Creates the terrain grid for the (completely loaded) track mesh, unless
+ *  it is disabled.
+ */
+void Track::createTerrainGrid()
+{
+    delete m_terrain_grid;
+    m_terrain_grid = NULL;
+    if (UserConfigParams::m_terrain_grid)
+        m_terrain_grid = new TerrainGrid(*m_track_mesh);
+}   // createTerrainGrid
+
+//-----------------------------------------------------------------------------
+/** Does a raycast against the track mesh. Downward rays are answered by the
+ *  terrain grid if possible, see TriangleMesh::castRay for the parameters.
+ */
+bool Track::castRayToTerrain(const Vec3 &from, const Vec3 &to,
+                             Vec3 *hit_point, const Material **material,
+                             Vec3 *normal) const
+{
+    if (m_terrain_grid)
+        return m_terrain_grid->castRay(from, to, hit_point, material, normal);
+    return m_track_mesh->castRay(from, to, hit_point, material, normal);
+}   // castRayToTerrain
+
 // -----------------------------------------------------------------------------
 
 
@@ -2647,10 +2682,10 @@ Vec3 Track::flagCommand(const XMLNode *node)
     loc += quad_normal * 0.1f;
 
 #ifndef DEBUG
-    m_track_mesh->castRay(loc, loc + (-10000 * quad_normal), &hit_point,
+    castRayToTerrain(loc, loc + (-10000 * quad_normal), &hit_point,
         &m, &normal);
 #else
-    bool drop_success = m_track_mesh->castRay(loc, loc +
+    bool drop_success = castRayToTerrain(loc, loc +
         (-10000 * quad_normal), &hit_point, &m, &normal);
     if (!drop_success)
     {
@@ -2750,13 +2785,13 @@ void Track::itemCommand(const XMLNode *node)
         loc += quad_normal * 0.1f;
 
 #ifndef DEBUG
-        m_track_mesh->castRay(loc, loc + (-10000 * quad_normal), &hit_point,
+        castRayToTerrain(loc, loc + (-10000 * quad_normal), &hit_point,
             &m, &normal);
         m_track_object_manager->castRay(loc,
             loc + (-10000 * quad_normal), &hit_point, &m, &normal,
             /*interpolate*/false);
 #else
-        bool drop_success = m_track_mesh->castRay(loc, loc +
+        bool drop_success = castRayToTerrain(loc, loc +
             (-10000 * quad_normal), &hit_point, &m, &normal);
         bool over_driveable = m_track_object_manager->castRay(loc,
             loc + (-10000 * quad_normal), &hit_point, &m, &normal,
@@ -2836,8 +2871,7 @@ bool Track::isOnGround(const Vec3& xyz, const Vec3& down, Vec3* hit_point,
 {
     // Material and hit point are not needed;
     const Material *m;
-    bool over_ground = m_track_mesh->castRay(xyz, down, hit_point,
-                                             &m, normal);
+    bool over_ground = castRayToTerrain(xyz, down, hit_point, &m, normal);
 
     // Now also raycast against all track objects (that are driveable). If
     // there should be a closer result (than the one against the main track
@@ -2995,6 +3029,7 @@ void Track::copyFromMainProcess()
     m_gfx_effect_mesh = new TriangleMesh(/*can_be_transformed*/false);
     m_track_mesh->copyFrom(*main_track->m_track_mesh);
     m_gfx_effect_mesh->copyFrom(*main_track->m_gfx_effect_mesh);
+    m_terrain_grid = NULL;
 
     // At the moment we only use network for child track
     auto nim = std::make_shared<NetworkItemManager>();
@@ -3022,6 +3057,8 @@ void Track::initChildTrack()
     Physics::get()->init(m_aabb_min, m_aabb_max);
     m_track_mesh->createPhysicalBody(m_friction);
     m_gfx_effect_mesh->createCollisionShape();
+    // The grid of the main track was saved in the AssetCache
+    createTerrainGrid();
 
     // All child track objects are only cloned if they have physical objects
     for (auto* to : m_track_object_manager->getObjects().m_contents_vector)
@@ -3043,6 +3080,7 @@ void Track::cleanChildTrack()
     child_track->m_item_manager = nullptr;
     delete child_track->m_check_manager;
     delete child_track->m_track_object_manager;
+    delete child_track->m_terrain_grid;
     delete child_track->m_track_mesh;
     delete child_track->m_gfx_effect_mesh;
     delete child_track;
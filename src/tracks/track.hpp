@@ -62,6 +62,7 @@ class AnimationManager;
 class BezierCurve;
 class CheckManager;
 class ItemManager;
+class Material;
 class ModelDefinitionLoader;
 class MovingTexture;
 class MusicInformation;
@@ -69,6 +70,7 @@ class ParticleEmitter;
 class ParticleKind;
 class PhysicalObject;
 class RenderTarget;
+class TerrainGrid;
 class TrackObject;
 class TrackObjectManager;
 class TriangleMesh;
@@ -217,6 +219,9 @@ private:
      *  allowing the kart to drive in/partly under water), but the
      *  actual surface position is needed for the water splash effect. */
     TriangleMesh*            m_gfx_effect_mesh;
+    /** Answers most downward raycasts against m_track_mesh without an
+     *  actual raycast, NULL if disabled. */
+    TerrainGrid*             m_terrain_grid;
     /** Minimum coordinates of this track. */
     Vec3                     m_aabb_min;
     /** Maximum coordinates of this track. */
@@ -422,6 +427,7 @@ private:
     void loadCurves(const XMLNode &node);
     void handleSky(const XMLNode &root, const std::string &filename);
     void freeCachedMeshVertexBuffer();
+    void createTerrainGrid();
     void copyFromMainProcess();
     video::IImage* getSkyTexture(std::string path) const;
 public:
@@ -611,6 +617,13 @@ public:
     const TriangleMesh *getPtrTriangleMesh() const { return m_track_mesh; }
     const TriangleMesh& getTriangleMesh() const {return *m_track_mesh; }
     // ------------------------------------------------------------------------
+    /** Returns the terrain grid of the track mesh, or NULL if disabled. */
+    const TerrainGrid* getTerrainGrid() const { return m_terrain_grid; }
+    // ------------------------------------------------------------------------
+    bool castRayToTerrain(const Vec3 &from, const Vec3 &to, Vec3 *hit_point,
+                          const Material **material,
+                          Vec3 *normal = NULL) const;
+    // ------------------------------------------------------------------------
     /** Returns the graphical effect mesh for this track. */
     const TriangleMesh& getGFXEffectMesh() const {return *m_gfx_effect_mesh;}
     // ------------------------------------------------------------------------
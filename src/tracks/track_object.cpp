@@ -544,6 +544,26 @@ void TrackObject::update(float dt)
     if (m_animator) m_animator->updateWithWorldTicks(true/*has_physics*/);
 }   // update
 
+// ----------------------------------------------------------------------------
+/** True if update() has any effect for this object, i.e. if it is animated,
+ *  a dynamic physical object, or its presentation needs updates.
+ */
+bool TrackObject::needsUpdate() const
+{
+    return m_animator != NULL ||
+           (m_presentation && m_presentation->needsUpdate()) ||
+           (m_physical_object && m_physical_object->isDynamic());
+}   // needsUpdate
+
+// ----------------------------------------------------------------------------
+/** True if updateGraphics() has any effect for this object.
+ */
+bool TrackObject::needsUpdateGraphics() const
+{
+    return m_animator != NULL ||
+           (m_presentation && m_presentation->needsUpdateGraphics()) ||
+           (m_physical_object && m_physical_object->isDynamic());
+}   // needsUpdateGraphics
 
 // ----------------------------------------------------------------------------
 /** This reset all physical object moved by 3d animation back to current ticks
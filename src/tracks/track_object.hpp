@@ -129,6 +129,8 @@ public:
     virtual void update(float dt);
     virtual void updateGraphics(float dt);
     virtual void resetAfterRewind();
+    bool         needsUpdate() const;
+    bool         needsUpdateGraphics() const;
     void move(const core::vector3df& xyz, const core::vector3df& hpr,
               const core::vector3df& scale, bool updateRigidBody,
               bool isAbsoluteCoord);
@@ -32,8 +32,26 @@
 #include <IMeshSceneNode.h>
 #include <ISceneManager.h>
 
+#include <algorithm>
+
+namespace
+{
+    /** Minimum size of a cell of the object grid. */
+    const float CELL_SIZE        = 20.0f;
+    /** Maximum number of cells in each direction of the grid. */
+    const int   MAX_GRID_SIZE    = 256;
+    /** Objects overlapping more cells are tested for each explosion. */
+    const int   MAX_OBJECT_CELLS = 64;
+    /** Physical objects further away from an explosion are not affected. */
+    const float EXPLOSION_RADIUS = 10.0f;
+}
+
 TrackObjectManager::TrackObjectManager()
 {
+    m_min_x = m_min_z = 0.0f;
+    m_cell_size   = CELL_SIZE;
+    m_size_x      = m_size_z = 0;
+    m_lists_dirty = true;
 }   // TrackObjectManager
 
 // ----------------------------------------------------------------------------
@@ -53,6 +71,7 @@ void TrackObjectManager::add(const XMLNode &xml_node, scene::ISceneNode* parent,
     {
         TrackObject *obj = new TrackObject(xml_node, parent, model_def_loader, parent_library);
         m_all_objects.push_back(obj);
+        m_lists_dirty = true;
         if(obj->isDriveable())
             m_driveable_objects.push_back(obj);
     }
@@ -100,6 +119,8 @@ void TrackObjectManager::init()
             moveable_objects++;
         }
     }
+    // onWorldReady can e.g. load scripts or remove objects
+    m_lists_dirty = true;
 }   // init
 
 // ----------------------------------------------------------------------------
@@ -149,50 +170,185 @@ TrackObject* TrackObjectManager::getTrackObject(const std::string& libraryInstan
     Log::warn("TrackObjectManager", "Object not found : %s::%s", libraryInstance.c_str(), name.c_str());
     return NULL;
 }
+// ----------------------------------------------------------------------------
+/** Creates the lists of objects that need to be updated, and sorts all
+ *  objects with a physical body into the grid (or the list of moving
+ *  objects). The position of objects that are not moving is taken when this
+ *  is called, i.e. objects moved by a script are found where they were.
+ */
+void TrackObjectManager::updateLists()
+{
+    m_lists_dirty = false;
+    m_update_objects.clear();
+    m_update_graphics_objects.clear();
+    m_moving_objects.clear();
+    m_cells.clear();
+
+    std::vector<TrackObject*> static_objects;
+    Vec3 min( 999999.9f);
+    Vec3 max(-999999.9f);
+    for (TrackObject* curr : m_all_objects)
+    {
+        if (curr->needsUpdate())
+            m_update_objects.push_back(curr);
+        if (curr->needsUpdateGraphics())
+            m_update_graphics_objects.push_back(curr);
+
+        const PhysicalObject *po = curr->getPhysicalObject();
+        if (!po || !po->getBody())
+            continue;
+        if (po->isDynamic() || curr->hasAnimatorRecursively())
+        {
+            m_moving_objects.push_back(curr);
+            continue;
+        }
+        btVector3 aabb_min, aabb_max;
+        po->getBody()->getAabb(aabb_min, aabb_max);
+        min.setMin(aabb_min);
+        max.setMax(aabb_max);
+        static_objects.push_back(curr);
+    }
+
+    if (static_objects.empty())
+    {
+        m_size_x = m_size_z = 0;
+        return;
+    }
+
+    m_min_x     = min.getX();
+    m_min_z     = min.getZ();
+    m_cell_size = std::max(CELL_SIZE,
+                           std::max(max.getX() - min.getX(),
+                                    max.getZ() - min.getZ()) / MAX_GRID_SIZE);
+    m_size_x = std::min(MAX_GRID_SIZE,
+                        int((max.getX() - m_min_x) / m_cell_size) + 1);
+    m_size_z = std::min(MAX_GRID_SIZE,
+                        int((max.getZ() - m_min_z) / m_cell_size) + 1);
+    m_cells.resize(m_size_x * m_size_z);
+
+    for (TrackObject* curr : static_objects)
+    {
+        btVector3 aabb_min, aabb_max;
+        curr->getPhysicalObject()->getBody()->getAabb(aabb_min, aabb_max);
+        int x0 = std::max(0, int((aabb_min.getX() - m_min_x) / m_cell_size));
+        int z0 = std::max(0, int((aabb_min.getZ() - m_min_z) / m_cell_size));
+        int x1 = std::min(m_size_x - 1,
+                          int((aabb_max.getX() - m_min_x) / m_cell_size));
+        int z1 = std::min(m_size_z - 1,
+                          int((aabb_max.getZ() - m_min_z) / m_cell_size));
+        if ((x1 - x0 + 1) * (z1 - z0 + 1) > MAX_OBJECT_CELLS)
+        {
+            m_moving_objects.push_back(curr);
+            continue;
+        }
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+                m_cells[z * m_size_x + x].push_back(curr);
+        }
+    }   // for curr in static_objects
+}   // updateLists
+
+// ----------------------------------------------------------------------------
+/** Collects all objects with a physical body whose bounding box is at most
+ *  radius away from the specified position.
+ *  \param pos The position to test.
+ *  \param radius Maximum distance.
+ *  \param objects Vector to which the objects are added (without
+ *         duplicates).
+ */
+void TrackObjectManager::getObjectsNear(const Vec3 &pos, float radius,
+                                        std::vector<TrackObject*> *objects)
+{
+    if (m_lists_dirty)
+        updateLists();
+
+    std::vector<TrackObject*> candidates(m_moving_objects);
+    if (m_size_x > 0)
+    {
+        int x0 = std::max(0, int((pos.getX() - radius - m_min_x) / m_cell_size));
+        int z0 = std::max(0, int((pos.getZ() - radius - m_min_z) / m_cell_size));
+        int x1 = std::min(m_size_x - 1,
+                          int((pos.getX() + radius - m_min_x) / m_cell_size));
+        int z1 = std::min(m_size_z - 1,
+                          int((pos.getZ() + radius - m_min_z) / m_cell_size));
+        for (int z = z0; z <= z1; z++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                const std::vector<TrackObject*> &cell =
+                                                   m_cells[z * m_size_x + x];
+                candidates.insert(candidates.end(), cell.begin(), cell.end());
+            }
+        }
+        // Objects overlapping several cells are found more than once
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+    }
+
+    for (TrackObject* curr : candidates)
+    {
+        btVector3 aabb_min, aabb_max;
+        curr->getPhysicalObject()->getBody()->getAabb(aabb_min, aabb_max);
+        Vec3 closest = pos;
+        closest.setMax(aabb_min);
+        closest.setMin(aabb_max);
+        if ((closest - pos).length2() <= radius * radius)
+            objects->push_back(curr);
+    }
+}   // getObjectsNear
+
+// ----------------------------------------------------------------------------
 /** Handles an explosion, i.e. it makes sure that all physical objects are
- *  affected accordingly.
+ *  affected accordingly. Only objects with a physical body close to the
+ *  explosion are considered.
  *  \param pos  Position of the explosion.
  *  \param obj  If the hit was a physical object, this object will be affected
  *              more. Otherwise this is NULL.
  *  \param secondary_hits True if items that are not directly hit should
  *         also be affected.
  */
-
 void TrackObjectManager::handleExplosion(const Vec3 &pos, const PhysicalObject *mp,
                                          bool secondary_hits)
 {
-    TrackObject* curr;
-    for_in (curr, m_all_objects)
+    if (mp && mp->getTrackObject())
+        mp->getTrackObject()->handleExplosion(pos, /*direct_hit*/true);
+    if (!secondary_hits)
+        return;
+
+    std::vector<TrackObject*> objects;
+    getObjectsNear(pos, EXPLOSION_RADIUS, &objects);
+    for (TrackObject* curr : objects)
     {
-        if(secondary_hits || mp == curr->getPhysicalObject())
-            curr->handleExplosion(pos, mp == curr->getPhysicalObject());
+        if (mp != curr->getPhysicalObject())
+            curr->handleExplosion(pos, /*direct_hit*/false);
     }
 }   // handleExplosion
 
 // ----------------------------------------------------------------------------
-/** Updates all track objects.
+/** Updates the graphics of all track objects that need it.
  *  \param dt Time step size.
  */
 void TrackObjectManager::updateGraphics(float dt)
 {
-    TrackObject* curr;
-    for_in(curr, m_all_objects)
-    {
+    if (m_lists_dirty)
+        updateLists();
+    for (TrackObject* curr : m_update_graphics_objects)
         curr->updateGraphics(dt);
-    }
 }   // updateGraphics
 
 // ----------------------------------------------------------------------------
-/** Updates all track objects.
+/** Updates all track objects that need it, i.e. static objects without
+ *  animation cost nothing here.
  *  \param dt Time step size.
  */
 void TrackObjectManager::update(float dt)
 {
-    TrackObject* curr;
-    for_in (curr, m_all_objects)
-    {
+    if (m_lists_dirty)
+        updateLists();
+    for (TrackObject* curr : m_update_objects)
         curr->update(dt);
-    }
 }   // update
 
 // ----------------------------------------------------------------------------
@@ -233,10 +389,14 @@ bool TrackObjectManager::castRay(const btVector3 &from,
 {
     bool result = false;
     float distance = 9999.9f;
-    // If there was a hit already, compute the current distance
+    // If there was a hit already, compute the current distance. Only closer
+    // hits are of interest, so the ray can end at the current hit, which
+    // makes it more likely that objects are rejected by their bounding box.
+    btVector3 ray_to = to;
     if(*material)
     {
         distance = hit_point->distance(from);
+        ray_to   = *hit_point;
     }
     for (const TrackObject* curr : m_driveable_objects)
     {
@@ -248,8 +408,8 @@ bool TrackObjectManager::castRay(const btVector3 &from,
         btVector3 new_hit_point;
         const Material *new_material;
         btVector3 new_normal;
-        if(curr->castRay(from, to, &new_hit_point, &new_material, &new_normal,
-                      interpolate_normal))
+        if(curr->castRay(from, ray_to, &new_hit_point, &new_material,
+                         &new_normal, interpolate_normal))
         {
             float new_distance = new_hit_point.distance(from);
             // If the new hit is closer than the current hit, save
@@ -260,6 +420,7 @@ bool TrackObjectManager::castRay(const btVector3 &from,
                 *hit_point = new_hit_point;
                 *normal    = new_normal;
                 distance   = new_distance;
+                ray_to     = new_hit_point;
                 result = true;
             }   // if new_distance < distance
         }   // if hit
@@ -271,6 +432,7 @@ bool TrackObjectManager::castRay(const btVector3 &from,
 void TrackObjectManager::insertObject(TrackObject* object)
 {
     m_all_objects.push_back(object);
+    m_lists_dirty = true;
 }
 
 // ----------------------------------------------------------------------------
@@ -288,5 +450,6 @@ void TrackObjectManager::insertDriveableObject(TrackObject* object)
 void TrackObjectManager::removeObject(TrackObject* obj)
 {
     m_all_objects.remove(obj);
+    m_lists_dirty = true;
     delete obj;
 }   // removeObject
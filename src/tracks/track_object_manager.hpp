@@ -51,6 +51,35 @@ protected:
     /** A second list which holds all objects that karts can drive on. */
     PtrVector<TrackObject, REF> m_driveable_objects;
 
+    /** All objects for which update() needs to be called. */
+    std::vector<TrackObject*> m_update_objects;
+
+    /** All objects for which updateGraphics() needs to be called. */
+    std::vector<TrackObject*> m_update_graphics_objects;
+
+    /** The objects with a physical body that don't move, bucketed into a
+     *  grid on the x/z plane by their bounding box (i.e. an object can be
+     *  in several cells). */
+    std::vector<std::vector<TrackObject*> > m_cells;
+
+    /** Objects with a physical body that move (dynamic or animated ones),
+     *  or that are too large to be stored in the grid. */
+    std::vector<TrackObject*> m_moving_objects;
+
+    /** Minimum corner and cell size of the grid. */
+    float m_min_x, m_min_z, m_cell_size;
+
+    /** Number of cells in x and z direction. */
+    int   m_size_x, m_size_z;
+
+    /** True if objects were added or removed since the update lists and
+     *  the grid were created. */
+    bool  m_lists_dirty;
+
+    void updateLists();
+    void getObjectsNear(const Vec3 &pos, float radius,
+                        std::vector<TrackObject*> *objects);
+
 public:
          TrackObjectManager();
         ~TrackObjectManager();
@@ -708,8 +708,7 @@ TrackObjectPresentationSound::TrackObjectPresentationSound(
                                       rolloff,
                                       max_dist,
                                       volume);
-    buffer->load();
-
+    // The buffer is loaded by the sfx thread when the sound source is created
     m_sound = SFXManager::get()->createSoundSource(buffer, true, true);
     if (m_sound != NULL)
     {
@@ -1110,6 +1109,7 @@ TrackObjectPresentationActionTrigger::TrackObjectPresentationActionTrigger(
             abs_trans.transformVect(m_init_xyz);
         }
     }
+    setActionFunction();
 
     if (m_type == TRIGGER_TYPE_POINT)
     {
@@ -1145,12 +1145,30 @@ TrackObjectPresentationActionTrigger::TrackObjectPresentationActionTrigger(
     m_xml_reenable_timeout = 999999.9f;
     setReenableTimeout(0.0f);
     m_type                 = TRIGGER_TYPE_POINT;
+    setActionFunction();
     Track::getCurrentTrack()->getCheckManager()->add(
         new CheckTrigger(m_init_xyz, trigger_distance, std::bind(
         &TrackObjectPresentationActionTrigger::onTriggerItemApproached,
         this, std::placeholders::_1)));
 }   // TrackObjectPresentationActionTrigger
 
+// ----------------------------------------------------------------------------
+/** Builds the declaration of the script function to call once, so that it
+ *  is only resolved once when the trigger is approached. */
+void TrackObjectPresentationActionTrigger::setActionFunction()
+{
+    if (!m_library_id.empty() && !m_triggered_object.empty() &&
+        !m_library_name.empty())
+    {
+        m_action_function.setDeclaration("void " + m_library_name + "::" +
+            m_action + "(int, const string, const string)");
+    }
+    else
+    {
+        m_action_function.setDeclaration("void " + m_action + "(int)");
+    }
+}   // setActionFunction
+
 // ----------------------------------------------------------------------------
 void TrackObjectPresentationActionTrigger::onTriggerItemApproached(int kart_id)
 {
@@ -1164,9 +1182,8 @@ void TrackObjectPresentationActionTrigger::onTriggerItemApproached(int kart_id)
     if (!m_library_id.empty() && !m_triggered_object.empty() &&
         !m_library_name.empty())
     {
-        Scripting::ScriptEngine::getInstance()->runFunction(true, "void "
-            + m_library_name + "::" + m_action +
-            "(int, const string, const string)", [=](asIScriptContext* ctx)
+        Scripting::ScriptEngine::getInstance()->runFunction(true,
+            m_action_function, [=](asIScriptContext* ctx)
             {
                 ctx->SetArgDWord(0, kart_id);
                 ctx->SetArgObject(1, &m_library_id);
@@ -1176,7 +1193,7 @@ void TrackObjectPresentationActionTrigger::onTriggerItemApproached(int kart_id)
     else
     {
         Scripting::ScriptEngine::getInstance()->runFunction(true,
-            "void " + m_action + "(int)", [=](asIScriptContext* ctx)
+            m_action_function, [=](asIScriptContext* ctx)
             {
                 ctx->SetArgDWord(0, kart_id);
             });
@@ -21,6 +21,7 @@
 #define HEADER_TRACK_OBJECT_PRESENTATION_HPP
 
 #include "graphics/lod_node.hpp"
+#include "scriptengine/script_function.hpp"
 #include "utils/cpp2011.hpp"
 #include "utils/no_copy.hpp"
 #include "utils/log.hpp"
@@ -90,6 +91,15 @@ public:
     }
     virtual void updateGraphics(float dt) {}
     virtual void update(float dt) {}
+    // ------------------------------------------------------------------------
+    /** True if update() of this presentation does anything, so the object
+     *  must be updated every time step. */
+    virtual bool needsUpdate() const { return false; }
+    // ------------------------------------------------------------------------
+    /** True if updateGraphics() of this presentation does anything, so the
+     *  object must be updated every frame. */
+    virtual bool needsUpdateGraphics() const { return false; }
+    // ------------------------------------------------------------------------
     virtual void move(const core::vector3df& xyz, const core::vector3df& hpr,
         const core::vector3df& scale, bool isAbsoluteCoord) {}
 
@@ -200,6 +210,7 @@ public:
         ModelDefinitionLoader& model_def_loader);
     virtual ~TrackObjectPresentationLibraryNode();
     virtual void update(float dt) OVERRIDE;
+    virtual bool needsUpdate() const OVERRIDE { return true; }
     virtual void reset() OVERRIDE
     {
         m_reset_executed = false;
@@ -295,6 +306,7 @@ public:
     virtual ~TrackObjectPresentationSound();
     void onTriggerItemApproached(int kart_id);
     virtual void updateGraphics(float dt) OVERRIDE;
+    virtual bool needsUpdateGraphics() const OVERRIDE { return true; }
     virtual void move(const core::vector3df& xyz, const core::vector3df& hpr,
         const core::vector3df& scale, bool isAbsoluteCoord) OVERRIDE;
     void triggerSound(bool loop);
@@ -325,6 +337,7 @@ public:
                                      scene::ISceneNode* parent);
     virtual ~TrackObjectPresentationBillboard();
     virtual void updateGraphics(float dt) OVERRIDE;
+    virtual bool needsUpdateGraphics() const OVERRIDE { return true; }
 };   // TrackObjectPresentationBillboard
 
 
@@ -347,6 +360,7 @@ public:
     virtual ~TrackObjectPresentationParticles();
 
     virtual void updateGraphics(float dt) OVERRIDE;
+    virtual bool needsUpdateGraphics() const OVERRIDE { return true; }
     void triggerParticles();
     void stop();
     void stopIn(double delay);
@@ -392,12 +406,17 @@ private:
     /** For action trigger objects */
     std::string m_action, m_library_id, m_triggered_object, m_library_name;
 
+    /** The script function called when the trigger is approached. */
+    Scripting::ScriptFunction m_action_function;
+
     float m_xml_reenable_timeout;
 
     uint64_t m_reenable_timeout;
 
     ActionTriggerType m_type;
 
+    void setActionFunction();
+
 public:
     TrackObjectPresentationActionTrigger(const XMLNode& xml_node,
                                          TrackObject* parent);
@@ -746,6 +746,19 @@ std::set<unsigned int> Translations::getCurrentAllChar()
     return m_dictionary->get_all_used_chars();
 }   // getCurrentAllChar
 
+// ----------------------------------------------------------------------------
+/** Returns all translated strings of the current language. */
+std::vector<std::string> Translations::getCurrentAllStrings()
+{
+    std::vector<std::string> strings;
+    m_dictionary->foreach([&strings](const std::string& msgid,
+                                     const std::vector<std::string>& msgstrs)
+        {
+            strings.insert(strings.end(), msgstrs.begin(), msgstrs.end());
+        });
+    return strings;
+}   // getCurrentAllStrings
+
 // ----------------------------------------------------------------------------
 std::string Translations::getCurrentLanguageName()
 {
@@ -83,6 +83,8 @@ public:
 
     std::set<unsigned int>   getCurrentAllChar();
 
+    std::vector<std::string> getCurrentAllStrings();
+
     std::string              getCurrentLanguageName();
 
     std::string              getCurrentLanguageNameCode();
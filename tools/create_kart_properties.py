@@ -181,13 +181,27 @@ def createAcGetter(groups):
 }}  // get{1}
 """.format(m.typeC, nameTitle, nameUnderscore.upper(), typeC, result))
 
+""" Returns the type that is returned by the getters of the resolved values:
+    Simple types are returned by value, all others by const reference, so
+    that they don't have to be copied. """
+def resolvedReturnType(member):
+    if member.typeC in ["float", "bool"]:
+        return member.typeC
+    return "const {0}&".format(member.typeC)
+
+""" Maps a type string to the member of the AbstractCharacteristic::Value
+    union that points to a value of this type. """
+def valueUnionMember(member):
+    return {"float": "f", "bool": "b", "floatVector": "fv",
+            "InterpolationArray": "ia"}[member.typeStr]
+
 def createKpDefs(groups):
     for g in groups:
         print()
         for m in g.members:
             nameTitle = joinSubName(g, m, True)
             nameUnderscore = joinSubName(g, m, False)
-            typeC = m.typeC
+            typeC = resolvedReturnType(m)
 
             print("    {0} get{1}() const;".
                 format(typeC, nameTitle, nameUnderscore))
@@ -197,15 +211,35 @@ def createKpGetter(groups):
         for m in g.members:
             nameTitle = joinSubName(g, m, True)
             nameUnderscore = joinSubName(g, m, False)
-            typeC = m.typeC
-            result = "result"
+            typeC = resolvedReturnType(m)
 
             print("""// ----------------------------------------------------------------------------
 {1} KartProperties::get{0}() const
 {{
-    return m_cached_characteristic->get{0}();
+    return m_cached_characteristic->getValues().m_{2};
 }}  // get{0}
-""".format(nameTitle, typeC))
+""".format(nameTitle, typeC, nameUnderscore))
+
+def createCcDefs(groups):
+    for g in groups:
+        print()
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("        {0} m_{1};".format(m.typeC, nameUnderscore))
+
+def createCcUpdate(groups):
+    for g in groups:
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("    fetch({0}, &m_values.m_{1});".
+                format(nameUnderscore.upper(), nameUnderscore))
+
+def createCcProcess(groups):
+    for g in groups:
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("    case {0}:\n        *value.{1} = m_values.m_{2};\n        break;".
+                format(nameUnderscore.upper(), valueUnionMember(m), nameUnderscore))
 
 def createGetType(groups):
     for g in groups:
@@ -246,6 +280,9 @@ functions = {
     "kpdefs":   (createKpDefs,   "Create the header function definitions for the getters", "karts/kart_properties.hpp"),
     "kpgetter": (createKpGetter, "Implement the getters",                                  "karts/kart_properties.cpp"),
     "loadXml":  (createLoadXml,  "Code to load the characteristics from an xml file",      "karts/xml_characteristic.cpp"),
+    "ccdefs":   (createCcDefs,   "Create the members of the resolved values",              "karts/cached_characteristic.hpp"),
+    "ccupdate": (createCcUpdate, "Fetch the resolved values from the source",              "karts/cached_characteristic.cpp"),
+    "ccprocess":(createCcProcess,"Implement the process function of the cached values",    "karts/cached_characteristic.cpp"),
 }
 
 def main():